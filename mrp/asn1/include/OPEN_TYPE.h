@@ -62,6 +62,13 @@ asn_enc_rval_t OPEN_TYPE_encode_uper(
     const asn_per_constraints_t *constraints, const void *struct_ptr,
     asn_per_outp_t *per_output);
 
+#ifndef ASN_DISABLE_OER_SUPPORT
+asn_enc_rval_t OPEN_TYPE_encode_oer(
+    const asn_TYPE_descriptor_t *type_descriptor,
+    const asn_oer_constraints_t *constraints, const void *struct_ptr,
+    asn_app_consume_bytes_f *cb, void *app_key);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
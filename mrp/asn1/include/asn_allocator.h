@@ -0,0 +1,119 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/*
+ * Pluggable memory allocator for the ASN.1 support code.
+ */
+#ifndef	ASN_ALLOCATOR_H
+#define	ASN_ALLOCATOR_H
+
+#include <asn_system.h>		/* Platform-specific types */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Set of memory routines used by CALLOC(), MALLOC(), REALLOC() and FREEMEM().
+ * The (key) is passed back to every routine unchanged.
+ */
+typedef struct asn_allocator_s {
+	void *(*calloc_cb)(void *key, size_t nmemb, size_t size);
+	void *(*malloc_cb)(void *key, size_t size);
+	void *(*realloc_cb)(void *key, void *ptr, size_t size);
+	void  (*free_cb)(void *key, void *ptr);
+	void *key;
+} asn_allocator_t;
+
+/*
+ * The allocator active in the calling thread; NULL selects the C library
+ * routines. uper_decode() installs the allocator given in the codec context
+ * for the duration of the call.
+ */
+extern __thread const asn_allocator_t *asn__allocator;
+
+/*
+ * Install an allocator for the calling thread.
+ * RETURN VALUES:
+ * 	The previously installed allocator (or NULL).
+ */
+const asn_allocator_t *asn_allocator_set(const asn_allocator_t *allocator);
+
+static inline void *
+asn_calloc(size_t nmemb, size_t size) {
+	const asn_allocator_t *a = asn__allocator;
+	return a ? a->calloc_cb(a->key, nmemb, size) : calloc(nmemb, size);
+}
+
+static inline void *
+asn_malloc(size_t size) {
+	const asn_allocator_t *a = asn__allocator;
+	return a ? a->malloc_cb(a->key, size) : malloc(size);
+}
+
+static inline void *
+asn_realloc(void *ptr, size_t size) {
+	const asn_allocator_t *a = asn__allocator;
+	return a ? a->realloc_cb(a->key, ptr, size) : realloc(ptr, size);
+}
+
+static inline void
+asn_free(void *ptr) {
+	const asn_allocator_t *a = asn__allocator;
+	if(a)
+		a->free_cb(a->key, ptr);
+	else
+		free(ptr);
+}
+
+/*
+ * Bump arena allocator.
+ * Allocations are carved sequentially out of a single block; FREEMEM() only
+ * reclaims the most recent allocation, and the whole arena is released at
+ * once by asn_arena_reset(). A structure decoded into an arena must therefore
+ * NOT be freed by ASN_STRUCT_FREE().
+ * When the block is exhausted the arena falls back to overflow chunks taken
+ * from the C library, and the next reset grows the block to the high-water
+ * mark, so that a steady stream of similar messages stops touching the heap.
+ */
+typedef struct asn_arena_chunk_s asn_arena_chunk_t;
+
+typedef struct asn_arena_s {
+	asn_allocator_t allocator;	/* Routines bound to this arena */
+	uint8_t *block;			/* Primary block */
+	size_t capacity;		/* Size of the primary block */
+	uint8_t *cur;			/* Bump pointer of the active block */
+	uint8_t *end;			/* End of the active block */
+	asn_arena_chunk_t *chunks;	/* Overflow chunks, most recent first */
+	size_t in_use;			/* Bytes handed out since last reset */
+	size_t high_water;		/* Maximum of in_use since creation */
+	size_t num_allocs;		/* Allocations served by the arena */
+	size_t num_sys_allocs;		/* Allocations taken from the C library */
+} asn_arena_t;
+
+/*
+ * Initialize the arena with a primary block of the given size.
+ * RETURN VALUES:
+ * 	 0:	Success.
+ * 	-1:	Failed to allocate the primary block.
+ */
+int asn_arena_init(asn_arena_t *arena, size_t capacity);
+
+/*
+ * Release everything allocated from the arena since the last reset.
+ */
+void asn_arena_reset(asn_arena_t *arena);
+
+/*
+ * Free all memory owned by the arena.
+ */
+void asn_arena_destroy(asn_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* ASN_ALLOCATOR_H */
@@ -35,12 +35,61 @@ typedef struct asn_bit_data_s {
  */
 asn_bit_data_t *asn_bit_data_new_contiguous(const void *data, size_t size_bits);
 
+/*
+ * Word-at-a-time access: bits are moved through one unaligned 64-bit
+ * big-endian load or store whenever the stream (or the output space) holds
+ * a whole word from the current byte. The inline functions below handle that
+ * common case and leave the tail of a stream, refills and flushes to the
+ * asn__*() functions.
+ */
+static inline uint64_t
+asn__load_be64(const uint8_t *p) {
+	uint64_t w;
+	memcpy(&w, p, sizeof(w));
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	w = __builtin_bswap64(w);
+#elif !(defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
+	w = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48)
+	  | ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32)
+	  | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16)
+	  | ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+#endif
+	return w;
+}
+
+static inline void
+asn__store_be64(uint8_t *p, uint64_t w) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	w = __builtin_bswap64(w);
+	memcpy(p, &w, sizeof(w));
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	memcpy(p, &w, sizeof(w));
+#else
+	int i;
+	for(i = 7; i >= 0; i--, w >>= 8)
+		p[i] = (uint8_t)w;
+#endif
+}
+
 /*
  * Extract a small number of bits (<= 31) from the specified PER data pointer.
  * This function returns -1 if the specified number of bits could not be
  * extracted due to EOD or other conditions.
  */
-int32_t asn_get_few_bits(asn_bit_data_t *, int get_nbits);
+int32_t asn__get_few_bits(asn_bit_data_t *, int get_nbits);
+static inline int32_t
+asn_get_few_bits(asn_bit_data_t *pd, int nbits) {
+	size_t byte = pd->nboff >> 3;
+	if(nbits > 0 && nbits < 32
+	&& pd->nboff + (size_t)nbits <= pd->nbits
+	&& ((pd->nbits + 7) >> 3) >= byte + 8) {
+		uint64_t w = asn__load_be64(pd->buffer + byte) << (pd->nboff & 0x07);
+		pd->nboff += nbits;
+		pd->moved += nbits;
+		return (int32_t)(w >> (64 - nbits));
+	}
+	return asn__get_few_bits(pd, nbits);
+}
 
 /* Undo the immediately preceeding "get_few_bits" operation */
 void asn_get_undo(asn_bit_data_t *, int get_nbits);
@@ -70,7 +119,21 @@ typedef struct asn_bit_outp_s {
 } asn_bit_outp_t;
 
 /* Output a small number of bits (<= 31) */
-int asn_put_few_bits(asn_bit_outp_t *, uint32_t bits, int obits);
+int asn__put_few_bits(asn_bit_outp_t *, uint32_t bits, int obits);
+static inline int
+asn_put_few_bits(asn_bit_outp_t *po, uint32_t bits, int obits) {
+	if(obits > 0 && obits < 32 && po->buffer
+	&& po->nbits >= (po->nboff & ~(size_t)0x07) + 64) {
+		uint8_t *buf = po->buffer + (po->nboff >> 3);
+		size_t off = (po->nboff & 0x07) + obits;
+		uint64_t w = (uint64_t)(buf[0] & (0xff << (8 - (po->nboff & 0x07)))) << 56;
+		w |= ((uint64_t)bits & (((uint64_t)1 << obits) - 1)) << (64 - off);
+		asn__store_be64(buf, w);
+		po->nboff += obits;
+		return 0;
+	}
+	return asn__put_few_bits(po, bits, obits);
+}
 
 /* Output a large number of bits */
 int asn_put_many_bits(asn_bit_outp_t *, const uint8_t *src, int put_nbits);
@@ -39,6 +39,11 @@ typedef struct asn_codec_ctx_s {
 	 * stack size is rather limited.
 	 */
 	size_t  max_stack_size; /* 0 disables stack bounds checking */
+	/*
+	 * Memory routines used by the decoder to build the structure,
+	 * see asn_allocator.h. NULL selects the C library routines.
+	 */
+	const struct asn_allocator_s *allocator;
 } asn_codec_ctx_t;
 
 /*
@@ -16,6 +16,7 @@
 #define __EXTENSIONS__          /* for Sun */
 
 #include "asn_application.h"	/* Application-visible API */
+#include "asn_allocator.h"	/* Pluggable memory routines */
 
 #ifndef	__NO_ASSERT_H__		/* Include assert.h only for internal use. */
 #include <assert.h>		/* for assert() macro */
@@ -29,10 +30,10 @@ extern "C" {
 #define	ASN1C_ENVIRONMENT_VERSION	923	/* Compile-time version */
 int get_asn1c_environment_version(void);	/* Run-time version */
 
-#define	CALLOC(nmemb, size)	calloc(nmemb, size)
-#define	MALLOC(size)		malloc(size)
-#define	REALLOC(oldptr, size)	realloc(oldptr, size)
-#define	FREEMEM(ptr)		free(ptr)
+#define	CALLOC(nmemb, size)	asn_calloc(nmemb, size)
+#define	MALLOC(size)		asn_malloc(size)
+#define	REALLOC(oldptr, size)	asn_realloc(oldptr, size)
+#define	FREEMEM(ptr)		asn_free(ptr)
 
 #define	asn_debug_indent	0
 #define ASN_DEBUG_INDENT_ADD(i) do{}while(0)
@@ -22,7 +22,12 @@ asn_TYPE_operation_t asn_OP_OPEN_TYPE = {
 	OPEN_TYPE_encode_der,
 	OPEN_TYPE_decode_xer,
 	OPEN_TYPE_encode_xer,
-	0, 0,	/* No OER support, use "-gen-OER" to enable */
+#ifdef ASN_DISABLE_OER_SUPPORT
+	0, 0,
+#else
+	0,	/* Decoded by the parent type with OPEN_TYPE_oer_get */
+	OPEN_TYPE_encode_oer,
+#endif
 #ifdef ASN_DISABLE_PER_SUPPORT
 	0, 0,
 #else
@@ -96,3 +96,45 @@ OPEN_TYPE_oer_get(const asn_codec_ctx_t *opt_codec_ctx,
     }
     return rv;
 }
+
+/*
+ * Encode the value selected in the Open Type as a length (#8.6) followed
+ * by the OER encoding of that value (X.696 (08/2015), #30).
+ */
+asn_enc_rval_t
+OPEN_TYPE_encode_oer(const asn_TYPE_descriptor_t *td,
+                     const asn_oer_constraints_t *constraints,
+                     const void *sptr, asn_app_consume_bytes_f *cb,
+                     void *app_key) {
+    const asn_TYPE_member_t *elm;
+    const void *memb_ptr;
+    unsigned present;
+    ssize_t encoded;
+    asn_enc_rval_t er = {0, 0, 0};
+
+    (void)constraints;
+
+    if(!sptr) ASN__ENCODE_FAILED;
+
+    present = CHOICE_variant_get_presence(td, sptr);
+    if(present == 0 || present > td->elements_count) {
+        ASN__ENCODE_FAILED;
+    }
+
+    elm = &td->elements[present - 1];
+    if(elm->flags & ATF_POINTER) {
+        memb_ptr =
+            *(const void *const *)((const char *)sptr + elm->memb_offset);
+        if(!memb_ptr) ASN__ENCODE_FAILED;
+    } else {
+        memb_ptr = (const char *)sptr + elm->memb_offset;
+    }
+
+    encoded = oer_open_type_put(elm->type,
+                                elm->encoding_constraints.oer_constraints,
+                                memb_ptr, cb, app_key);
+    if(encoded < 0) ASN__ENCODE_FAILED;
+
+    er.encoded = encoded;
+    ASN__ENCODED_OK(er);
+}
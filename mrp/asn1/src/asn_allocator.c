@@ -0,0 +1,186 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#include <asn_internal.h>
+#include <asn_allocator.h>
+
+__thread const asn_allocator_t *asn__allocator;
+
+const asn_allocator_t *
+asn_allocator_set(const asn_allocator_t *allocator) {
+	const asn_allocator_t *previous = asn__allocator;
+	asn__allocator = allocator;
+	return previous;
+}
+
+/*
+ * Every arena allocation is preceded by a header recording its size,
+ * so that REALLOC() knows how much to copy. Both the header and the
+ * payload are kept at the strictest fundamental alignment.
+ */
+#define	ASN_ARENA_ALIGN	16
+#define	ASN_ARENA_ROUND(n)	(((n) + (ASN_ARENA_ALIGN - 1)) & ~(size_t)(ASN_ARENA_ALIGN - 1))
+#define	ASN_ARENA_HDR	ASN_ARENA_ROUND(sizeof(size_t))
+
+struct asn_arena_chunk_s {
+	asn_arena_chunk_t *next;
+	size_t size;
+};
+#define	ASN_ARENA_CHUNK_HDR	ASN_ARENA_ROUND(sizeof(asn_arena_chunk_t))
+
+static size_t
+asn_arena_blk_size(const void *ptr) {
+	return *(const size_t *)((const uint8_t *)ptr - ASN_ARENA_HDR);
+}
+
+static void *
+asn_arena_malloc(void *key, size_t size) {
+	asn_arena_t *arena = (asn_arena_t *)key;
+	size_t need = ASN_ARENA_HDR + ASN_ARENA_ROUND(size);
+	uint8_t *p;
+
+	if(need < size) return NULL;	/* Overflow */
+
+	if((size_t)(arena->end - arena->cur) < need) {
+		/* Open an overflow chunk big enough for this request */
+		size_t chunk_size = arena->capacity;
+		asn_arena_chunk_t *chunk;
+		if(chunk_size < need) chunk_size = need;
+		chunk = (asn_arena_chunk_t *)malloc(ASN_ARENA_CHUNK_HDR + chunk_size);
+		if(!chunk) return NULL;
+		arena->num_sys_allocs++;
+		chunk->next = arena->chunks;
+		chunk->size = chunk_size;
+		arena->chunks = chunk;
+		arena->cur = (uint8_t *)chunk + ASN_ARENA_CHUNK_HDR;
+		arena->end = arena->cur + chunk_size;
+	}
+
+	p = arena->cur;
+	arena->cur += need;
+	arena->in_use += need;
+	if(arena->in_use > arena->high_water)
+		arena->high_water = arena->in_use;
+	arena->num_allocs++;
+
+	*(size_t *)p = size;
+	return p + ASN_ARENA_HDR;
+}
+
+static void *
+asn_arena_calloc(void *key, size_t nmemb, size_t size) {
+	size_t total = nmemb * size;
+	void *p;
+
+	if(size && total / size != nmemb) return NULL;	/* Overflow */
+
+	p = asn_arena_malloc(key, total);
+	if(p) memset(p, 0, total);
+	return p;
+}
+
+static void *
+asn_arena_realloc(void *key, void *ptr, size_t size) {
+	asn_arena_t *arena = (asn_arena_t *)key;
+	size_t old_size;
+	void *p;
+
+	if(!ptr) return asn_arena_malloc(key, size);
+
+	old_size = asn_arena_blk_size(ptr);
+	if((uint8_t *)ptr + ASN_ARENA_ROUND(old_size) == arena->cur) {
+		/* Most recent allocation: grow or shrink in place */
+		size_t new_round = ASN_ARENA_ROUND(size);
+		size_t old_round = ASN_ARENA_ROUND(old_size);
+		if(new_round <= old_round
+		|| (size_t)(arena->end - arena->cur) >= new_round - old_round) {
+			arena->cur = (uint8_t *)ptr + new_round;
+			arena->in_use = arena->in_use - old_round + new_round;
+			if(arena->in_use > arena->high_water)
+				arena->high_water = arena->in_use;
+			*(size_t *)((uint8_t *)ptr - ASN_ARENA_HDR) = size;
+			return ptr;
+		}
+	}
+
+	p = asn_arena_malloc(key, size);
+	if(p) memcpy(p, ptr, old_size < size ? old_size : size);
+	return p;
+}
+
+static void
+asn_arena_free(void *key, void *ptr) {
+	asn_arena_t *arena = (asn_arena_t *)key;
+	size_t round;
+
+	if(!ptr) return;
+
+	/* Only the most recent allocation can be given back */
+	round = ASN_ARENA_ROUND(asn_arena_blk_size(ptr));
+	if((uint8_t *)ptr + round == arena->cur) {
+		arena->cur = (uint8_t *)ptr - ASN_ARENA_HDR;
+		arena->in_use -= ASN_ARENA_HDR + round;
+	}
+}
+
+int
+asn_arena_init(asn_arena_t *arena, size_t capacity) {
+	memset(arena, 0, sizeof(*arena));
+	arena->allocator.calloc_cb = asn_arena_calloc;
+	arena->allocator.malloc_cb = asn_arena_malloc;
+	arena->allocator.realloc_cb = asn_arena_realloc;
+	arena->allocator.free_cb = asn_arena_free;
+	arena->allocator.key = arena;
+
+	capacity = ASN_ARENA_ROUND(capacity);
+	if(capacity) {
+		arena->block = (uint8_t *)malloc(capacity);
+		if(!arena->block) return -1;
+		arena->num_sys_allocs++;
+		arena->capacity = capacity;
+	}
+	arena->cur = arena->block;
+	arena->end = arena->block + arena->capacity;
+	return 0;
+}
+
+void
+asn_arena_reset(asn_arena_t *arena) {
+	if(arena->chunks) {
+		while(arena->chunks) {
+			asn_arena_chunk_t *next = arena->chunks->next;
+			free(arena->chunks);
+			arena->chunks = next;
+		}
+		/* Grow the primary block to cover the high-water mark */
+		if(arena->high_water > arena->capacity) {
+			size_t capacity = arena->capacity ? arena->capacity : ASN_ARENA_ALIGN;
+			uint8_t *block;
+			while(capacity < arena->high_water) capacity <<= 1;
+			block = (uint8_t *)malloc(capacity);
+			if(block) {
+				free(arena->block);
+				arena->block = block;
+				arena->capacity = capacity;
+				arena->num_sys_allocs++;
+			}
+		}
+	}
+	arena->cur = arena->block;
+	arena->end = arena->block + arena->capacity;
+	arena->in_use = 0;
+}
+
+void
+asn_arena_destroy(asn_arena_t *arena) {
+	while(arena->chunks) {
+		asn_arena_chunk_t *next = arena->chunks->next;
+		free(arena->chunks);
+		arena->chunks = next;
+	}
+	free(arena->block);
+	memset(arena, 0, sizeof(*arena));
+}
@@ -64,9 +64,10 @@ asn_get_undo(asn_bit_data_t *pd, int nbits) {
 
 /*
  * Extract a small number of bits (<= 31) from the specified PER data pointer.
+ * Called by asn_get_few_bits() near the end of the stream and for refills.
  */
 int32_t
-asn_get_few_bits(asn_bit_data_t *pd, int nbits) {
+asn__get_few_bits(asn_bit_data_t *pd, int nbits) {
 	size_t off;	/* Next after last bit offset */
 	ssize_t nleft;	/* Number of bits left in this stream */
 	uint32_t accum;
@@ -110,7 +111,11 @@ asn_get_few_bits(asn_bit_data_t *pd, int nbits) {
 	/*
 	 * Extract specified number of bits.
 	 */
-	if(off <= 8)
+	if(nbits && nbits <= 31 && ((pd->nbits + 7) >> 3) >= 8)
+		/* A single word covers the 0..7 bits offset plus up to 31 bits */
+		accum = (uint32_t)((asn__load_be64(buf) << (off - nbits))
+			>> (64 - nbits));
+	else if(off <= 8)
 		accum = nbits ? (buf[0]) >> (8 - off) : 0;
 	else if(off <= 16)
 		accum = ((buf[0] << 8) + buf[1]) >> (16 - off);
@@ -162,6 +167,31 @@ asn_get_many_bits(asn_bit_data_t *pd, uint8_t *dst, int alright, int nbits) {
 		nbits &= ~7;
 	}
 
+	/* Seven bytes per word while the stream holds a whole word */
+	while(nbits >= 56) {
+		uint64_t word;
+		if(pd->nboff >= 8) {
+			pd->buffer += (pd->nboff >> 3);
+			pd->nbits  -= (pd->nboff & ~0x07);
+			pd->nboff  &= 0x07;
+		}
+		if(pd->nbits - pd->nboff < 56
+		|| ((pd->nbits + 7) >> 3) < 8)
+			break;
+		word = asn__load_be64(pd->buffer) << pd->nboff;
+		dst[0] = (uint8_t)(word >> 56);
+		dst[1] = (uint8_t)(word >> 48);
+		dst[2] = (uint8_t)(word >> 40);
+		dst[3] = (uint8_t)(word >> 32);
+		dst[4] = (uint8_t)(word >> 24);
+		dst[5] = (uint8_t)(word >> 16);
+		dst[6] = (uint8_t)(word >> 8);
+		dst += 7;
+		pd->nboff += 56;
+		pd->moved += 56;
+		nbits -= 56;
+	}
+
 	while(nbits) {
 		if(nbits >= 24) {
 			value = asn_get_few_bits(pd, 24);
@@ -192,18 +222,17 @@ asn_get_many_bits(asn_bit_data_t *pd, uint8_t *dst, int alright, int nbits) {
 }
 
 /*
- * Put a small number of bits (<= 31).
+ * Put up to 56 bits. Whole bytes are flushed as soon as less than a word of
+ * (tmpspace) is left, so that the bits always go out through one word store.
  */
-int
-asn_put_few_bits(asn_bit_outp_t *po, uint32_t bits, int obits) {
+static int
+asn_put_word_bits(asn_bit_outp_t *po, uint64_t bits, int obits) {
 	size_t off;	/* Next after last bit offset */
-	size_t omsk;	/* Existing last byte meaningful bits mask */
+	uint64_t word;
 	uint8_t *buf;
 
-	if(obits <= 0 || obits >= 32) return obits ? -1 : 0;
-
-	ASN_DEBUG("[PER put %d bits %x to %p+%d bits]",
-			obits, (int)bits, (void *)po->buffer, (int)po->nboff);
+	ASN_DEBUG("[PER put %d bits %llx to %p+%d bits]",
+			obits, (unsigned long long)bits, (void *)po->buffer, (int)po->nboff);
 
 	/*
 	 * Normalize position indicator.
@@ -217,7 +246,7 @@ asn_put_few_bits(asn_bit_outp_t *po, uint32_t bits, int obits) {
 	/*
 	 * Flush whole-bytes output, if necessary.
 	 */
-	if(po->nboff + obits > po->nbits) {
+	if(po->nbits < 64) {
 		size_t complete_bytes;
 		if(!po->buffer) po->buffer = po->tmpspace;
 		complete_bytes = (po->buffer - po->tmpspace);
@@ -233,55 +262,38 @@ asn_put_few_bits(asn_bit_outp_t *po, uint32_t bits, int obits) {
 	}
 
 	/*
-	 * Now, due to sizeof(tmpspace), we are guaranteed large enough space.
+	 * Now, due to sizeof(tmpspace), we are guaranteed a word of space.
 	 */
 	buf = po->buffer;
-	omsk = ~((1 << (8 - po->nboff)) - 1);
 	off = (po->nboff + obits);
 
 	/* Clear data of debris before meaningful bits */
-	bits &= (((uint32_t)1 << obits) - 1);
-
-	ASN_DEBUG("[PER out %d %u/%x (t=%d,o=%d) %x&%x=%x]", obits,
-		(int)bits, (int)bits,
-		(int)po->nboff, (int)off,
-		buf[0], (int)(omsk&0xff),
-		(int)(buf[0] & omsk));
-
-	if(off <= 8)	/* Completely within 1 byte */
-		po->nboff = off,
-		bits <<= (8 - off),
-		buf[0] = (buf[0] & omsk) | bits;
-	else if(off <= 16)
-		po->nboff = off,
-		bits <<= (16 - off),
-		buf[0] = (buf[0] & omsk) | (bits >> 8),
-		buf[1] = bits;
-	else if(off <= 24)
-		po->nboff = off,
-		bits <<= (24 - off),
-		buf[0] = (buf[0] & omsk) | (bits >> 16),
-		buf[1] = bits >> 8,
-		buf[2] = bits;
-	else if(off <= 31)
-		po->nboff = off,
-		bits <<= (32 - off),
-		buf[0] = (buf[0] & omsk) | (bits >> 24),
-		buf[1] = bits >> 16,
-		buf[2] = bits >> 8,
-		buf[3] = bits;
-	else {
-		if(asn_put_few_bits(po, bits >> (obits - 24), 24)) return -1;
-		if(asn_put_few_bits(po, bits, obits - 24)) return -1;
-	}
+	bits &= (((uint64_t)1 << obits) - 1);
 
-	ASN_DEBUG("[PER out %u/%x => %02x buf+%ld]",
-		(int)bits, (int)bits, buf[0],
+	/* Keep the meaningful bits of the existing last byte */
+	word = po->nboff
+		? (uint64_t)(buf[0] & (0xff << (8 - po->nboff))) << 56 : 0;
+	word |= bits << (64 - off);
+	asn__store_be64(buf, word);
+	po->nboff = off;
+
+	ASN_DEBUG("[PER out %llx => %02x buf+%ld]",
+		(unsigned long long)bits, buf[0],
 		(long)(po->buffer - po->tmpspace));
 
 	return 0;
 }
 
+/*
+ * Put a small number of bits (<= 31).
+ * Called by asn_put_few_bits() when less than a word of (tmpspace) is left.
+ */
+int
+asn__put_few_bits(asn_bit_outp_t *po, uint32_t bits, int obits) {
+	if(obits <= 0 || obits >= 32) return obits ? -1 : 0;
+	return asn_put_word_bits(po, bits, obits);
+}
+
 
 /*
  * Output a large number of bits.
@@ -289,6 +301,14 @@ asn_put_few_bits(asn_bit_outp_t *po, uint32_t bits, int obits) {
 int
 asn_put_many_bits(asn_bit_outp_t *po, const uint8_t *src, int nbits) {
 
+	/* Seven bytes per word while (src) holds a whole word */
+	while(nbits >= 64) {
+		if(asn_put_word_bits(po, asn__load_be64(src) >> 8, 56))
+			return -1;
+		src += 7;
+		nbits -= 56;
+	}
+
 	while(nbits) {
 		uint32_t value;
 
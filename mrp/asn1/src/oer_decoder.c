@@ -39,6 +39,15 @@ oer_decode(const asn_codec_ctx_t *opt_codec_ctx,
 	/*
 	 * Invoke type-specific decoder.
 	 */
+	if(opt_codec_ctx->allocator) {
+		const asn_allocator_t *saved_allocator;
+		asn_dec_rval_t rval;
+		saved_allocator = asn_allocator_set(opt_codec_ctx->allocator);
+		rval = type_descriptor->op->oer_decoder(opt_codec_ctx,
+			type_descriptor, 0, struct_ptr, ptr, size);
+		asn_allocator_set(saved_allocator);
+		return rval;
+	}
 	return type_descriptor->op->oer_decoder(opt_codec_ctx, type_descriptor, 0,
 		struct_ptr,	/* Pointer to the destination structure */
 		ptr, size	/* Buffer and its size */
@@ -86,7 +86,14 @@ uper_decode(const asn_codec_ctx_t *opt_codec_ctx,
 	 */
 	if(!td->op->uper_decoder)
 		ASN__DECODE_FAILED;	/* PER is not compiled in */
-	rval = td->op->uper_decoder(opt_codec_ctx, td, 0, sptr, &pd);
+	if(opt_codec_ctx->allocator) {
+		const asn_allocator_t *saved_allocator;
+		saved_allocator = asn_allocator_set(opt_codec_ctx->allocator);
+		rval = td->op->uper_decoder(opt_codec_ctx, td, 0, sptr, &pd);
+		asn_allocator_set(saved_allocator);
+	} else {
+		rval = td->op->uper_decoder(opt_codec_ctx, td, 0, sptr, &pd);
+	}
 	if(rval.code == RC_OK) {
 		/* Return the number of consumed bits */
 		rval.consumed = ((pd.buffer - (const uint8_t *)buffer) << 3)
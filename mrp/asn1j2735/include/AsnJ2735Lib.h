@@ -10,14 +10,243 @@
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <vector>
 
+#include "codecErrors.h"
 #include "dsrcFrame.h"
 
 namespace AsnJ2735Lib
-{ /// UPER encoding functions
+{ /// allocation counters of a decoding arena
+	struct arenaStats_t
+	{
+		size_t numAllocs;     /// allocations served by the arena
+		size_t numSysAllocs;  /// allocations taken from the heap by the arena
+		size_t capacity;      /// size of the arena block, in bytes
+		size_t highWater;     /// maximum bytes in use during one decode
+	};
+	/// leading fields of an encoded message frame
+	struct msgHeader_t
+	{
+		uint16_t dsrcMsgId;
+		uint16_t regionalId;      /// MAP, SPaT, SRM and SSM: RoadRegulatorID of the first intersection
+		uint16_t intersectionId;  /// MAP, SPaT, SRM and SSM: IntersectionID of the first intersection
+		uint8_t  revision;        /// MAP: msgIssueRevision (mapVersion), SPaT: revision (msgCnt)
+		uint32_t vehId;           /// BSM: temporary ID
+		void reset(void)
+		{
+			dsrcMsgId = MsgEnum::DSRCmsgID_unknown;
+			regionalId = 0;
+			intersectionId = 0;
+			revision = 0;
+			vehId = 0;
+		};
+	};
+	/// an open type value left encoded in the payload: BSM Part II content or regional extension
+	struct openTypeRef_t
+	{
+		uint8_t id;        /// PartII-Id or RegionId
+		size_t  bitPos;    /// position of the value in the payload, in bits
+		size_t  numBytes;  /// length of the value, in bytes
+	};
+	/// BSM Part II contents and regional extensions skipped by decode_msgFrame_lazy
+	struct bsmExtensions_t
+	{
+		std::vector<openTypeRef_t> partII;
+		std::vector<openTypeRef_t> regional;
+		void reset(void)
+		{
+			partII.clear();
+			regional.clear();
+		};
+	};
+	/// UPER encoding functions
 	size_t encode_msgFrame(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size);
+	size_t encode_msgFrame_direct(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size);
 	/// UPER decoding functions
 	size_t decode_msgFrame(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut);
+	size_t decode_msgFrame_arena(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut);
+	size_t decode_msgFrame_direct(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut);
+	size_t decode_msgFrame_lazy(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut, bsmExtensions_t& bsmExtOut);
+	/// copy an open type value into valueBuf, where it is a standalone UPER encoding of its type
+	size_t get_openTypeValue(const uint8_t* buf, size_t size, const openTypeRef_t& ref, uint8_t* valueBuf, size_t valueSize);
+	arenaStats_t get_decodeArenaStats(void);
+	/// OER encoding and decoding, for links that favour codec speed over payload size. The
+	/// MessageFrame is the same as with UPER; decode_msgFrame_oer builds it in the per-thread arena
+	size_t encode_msgFrame_oer(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size);
+	size_t decode_msgFrame_oer(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut);
+	/// read the leading fields only, without decoding the rest of the message
+	bool peek_msgFrame(const uint8_t* buf, size_t size, msgHeader_t& headerOut);
+	/// RTCM UPER encoding and decoding without copying the RTCMmessage octets: rtcmOut refers to buf,
+	/// which the caller keeps for as long as rtcmOut is used
+	size_t encode_rtcm_view(const RTCMview_t& rtcmIn, uint8_t* buf, size_t size);
+	size_t decode_rtcm_view(const uint8_t* buf, size_t size, RTCMview_t& rtcmOut);
+	/// copy the RTCMmessage octets into payloadBuf, needed only when rtcm.data() is NULL
+	size_t get_rtcmPayload(const RTCMview_t& rtcm, uint8_t* payloadBuf, size_t payloadSize);
+
+	/// DSRC message ID of each dsrc element type
+	template<typename T> struct msgId;
+	template<> struct msgId<MapData_element_t> {static constexpr uint16_t value = MsgEnum::DSRCmsgID_map;};
+	template<> struct msgId<SPAT_element_t>    {static constexpr uint16_t value = MsgEnum::DSRCmsgID_spat;};
+	template<> struct msgId<BSM_element_t>     {static constexpr uint16_t value = MsgEnum::DSRCmsgID_bsm;};
+	template<> struct msgId<RTCM_element_t>    {static constexpr uint16_t value = MsgEnum::DSRCmsgID_rtcm;};
+	template<> struct msgId<SRM_element_t>     {static constexpr uint16_t value = MsgEnum::DSRCmsgID_srm;};
+	template<> struct msgId<SSM_element_t>     {static constexpr uint16_t value = MsgEnum::DSRCmsgID_ssm;};
+	/// UPER encoding and decoding of a single message type, for callers that handle one type and need
+	/// no Frame_element_t. T is one of the six element types of Frame_element_t. encode and decode take
+	/// the direct paths where there is one, as encode_msgFrame_direct and decode_msgFrame_direct do.
+	/// decode returns 0 when the MessageFrame holds another message type
+	template<typename T> size_t encode(const T& msgIn, uint8_t* buf, size_t size);
+	template<typename T> size_t decode(const uint8_t* buf, size_t size, T& msgOut);
+	/// the same through the asn1c MessageFrame tree, decode_asn1c building it in the per-thread arena
+	template<typename T> size_t encode_asn1c(const T& msgIn, uint8_t* buf, size_t size);
+	template<typename T> size_t decode_asn1c(const uint8_t* buf, size_t size, T& msgOut);
+
+	/// UPER decoder that hands each message to a visitor as its own element type.
+	/// One element of each type is kept, and a message is decoded with decode<T> into the element of
+	/// its type only, which is then passed to visitor(const T&). The visitor needs an operator() for
+	/// every element type it may be given (a template one takes the rest). decode returns the number
+	/// of bytes decoded, 0 on failure or an unknown message type, and the visitor is not called then
+	class MsgDecoder
+	{
+		public:
+			MsgDecoder(void)
+			{
+				mapData.reset();
+				spat.reset();
+				bsm.reset();
+				rtcm.reset();
+				srm.reset();
+				ssm.reset();
+			};
+
+			template<typename V>
+			size_t decode(const uint8_t* buf, size_t size, V& visitor)
+			{ // messageId follows the extension bit of MessageFrame
+				if ((buf == NULL) || (size < 2))
+					return(0);
+				switch(((buf[0] & 0x7F) << 8) | buf[1])
+				{
+				case MsgEnum::DSRCmsgID_map:
+					return(visit(buf, size, mapData, visitor));
+				case MsgEnum::DSRCmsgID_spat:
+					return(visit(buf, size, spat, visitor));
+				case MsgEnum::DSRCmsgID_bsm:
+					return(visit(buf, size, bsm, visitor));
+				case MsgEnum::DSRCmsgID_rtcm:
+					return(visit(buf, size, rtcm, visitor));
+				case MsgEnum::DSRCmsgID_srm:
+					return(visit(buf, size, srm, visitor));
+				case MsgEnum::DSRCmsgID_ssm:
+					return(visit(buf, size, ssm, visitor));
+				default:
+					return(0);
+				}
+			};
+
+		private:
+			MapData_element_t mapData;
+			SPAT_element_t    spat;
+			BSM_element_t     bsm;
+			RTCM_element_t    rtcm;
+			SRM_element_t     srm;
+			SSM_element_t     ssm;
+
+			template<typename T, typename V>
+			static size_t visit(const uint8_t* buf, size_t size, T& msg, V& visitor)
+			{
+				size_t numBytes = AsnJ2735Lib::decode(buf, size, msg);
+				if (numBytes > 0)
+					visitor(static_cast<const T&>(msg));
+				return(numBytes);
+			};
+	};
+
+	/// layout of a UPER encoded SPaT: which optional members are present, and where the fields
+	/// that SpatEncoder patches are, as bit positions from the start of the SPAT value
+	struct spatLayout_t
+	{
+		uint32_t groupKey;           /// permitted signal groups and timeStamp presence
+		uint64_t timingKey;          /// presence of TimeChangeDetails members, by signal group
+		size_t   numBytes;           /// size of the encoded MessageFrame
+		size_t   valuePos;           /// bit position of the SPAT value in the MessageFrame
+		uint32_t regionalIdPos;
+		uint32_t idPos;
+		uint32_t msgCntPos;
+		uint32_t statusPos;
+		uint32_t minutePos;
+		uint32_t secPos;
+		uint32_t currStatePos[16];   /// by signalGroupID - 1
+		uint32_t startTimePos[16];
+		uint32_t minEndTimePos[16];
+		uint32_t maxEndTimePos[16];
+	};
+	/// UPER encoder of the SPaT of one intersection.
+	/// The last encoded MessageFrame is kept with its layout. When the next SPaT has the same layout
+	/// (same signal groups and the same optional members), the fields are written into the kept
+	/// MessageFrame in place, otherwise the SPaT is encoded in full. The bytes are the same as
+	/// encode_msgFrame either way. A SPaT of more than one intersection, or with MovementEvents after
+	/// the current one, is always encoded in full.
+	class SpatEncoder
+	{
+		public:
+			SpatEncoder(void) : hasLayout(false), numFullEncodes(0), numPatches(0) {};
+			/// UPER encoding of spatIn into buf, returns the number of bytes, 0 on failure
+			size_t encode(const SPAT_element_t& spatIn, uint8_t* buf, size_t size);
+			size_t getNumFullEncodes(void) const
+				{return(numFullEncodes);};
+			size_t getNumPatches(void) const
+				{return(numPatches);};
+
+		private:
+			bool hasLayout;
+			spatLayout_t layout;
+			std::vector<uint8_t> msgFrame;
+			size_t numFullEncodes;
+			size_t numPatches;
+	};
+
+	/// an encoded message in a batch
+	struct msgBuf_t
+	{
+		const uint8_t* buf;
+		size_t size;
+	};
+	/// decoding status of a message in a batch
+	enum class decodeStatus : uint8_t {decoded, empty, failed};
+	/// decoding result of a message in a batch
+	struct decodeResult_t
+	{
+		decodeStatus status;
+		size_t consumed;            /// number of bytes used for decoding, 0 when not decoded
+		codecError error;           /// reason of the failure when status is failed, otherwise codecError::none
+		Frame_element_t dsrcFrame;  /// dsrcFrame.dsrcMsgId tells which message is filled
+	};
+	/// batch UPER decoder, decoding with decode_msgFrame_direct.
+	/// The decoder is kept for the life of a job so that its worker threads, their decoding arenas
+	/// and the result slots are reused from batch to batch.
+	class BatchDecoder
+	{
+		public:
+			/// numWorkers = 0 decodes in the calling thread, otherwise the batch is shared between
+			/// the calling thread and numWorkers worker threads
+			BatchDecoder(unsigned int numWorkers = 0);
+			~BatchDecoder(void);
+			BatchDecoder(const BatchDecoder&) = delete;
+			BatchDecoder& operator=(const BatchDecoder&) = delete;
+
+			/// decode numMsgs messages into results (resized to numMsgs, results[i] for msgs[i]),
+			/// returns the number of messages decoded
+			size_t decode(const msgBuf_t* msgs, size_t numMsgs, std::vector<decodeResult_t>& results);
+			size_t decode(const std::vector<msgBuf_t>& msgs, std::vector<decodeResult_t>& results)
+				{return(decode(msgs.data(), msgs.size(), results));};
+			unsigned int getNumWorkers(void) const
+				{return(numWorkers);};
+
+		private:
+			struct workerPool_t;
+			unsigned int numWorkers;
+			workerPool_t* pWorkerPool;
+	};
 };
 
 #endif
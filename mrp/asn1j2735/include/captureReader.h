@@ -0,0 +1,90 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _CAPTURE_READER_H
+#define _CAPTURE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AsnJ2735Lib.h"
+
+namespace AsnJ2735Lib
+{ /// record counts of a capture walked by CaptureReader
+	struct captureStats_t
+	{
+		size_t numRecords;      /// packet records walked
+		size_t numWsm;          /// records that carry a WAVE Short Message
+		size_t numSecured;      /// WSMs whose J2735 payload was taken out of IEEE 1609.2 data
+		size_t numEncrypted;    /// WSMs in encrypted 1609.2 data, skipped
+		size_t numOther;        /// records of another protocol or link type, skipped
+		size_t numMalformed;    /// truncated records, and malformed WSMP or 1609.2 headers
+		uint64_t payloadBytes;  /// bytes of the J2735 payloads handed out
+		void reset(void)
+		{
+			numRecords = 0;
+			numWsm = 0;
+			numSecured = 0;
+			numEncrypted = 0;
+			numOther = 0;
+			numMalformed = 0;
+			payloadBytes = 0;
+		};
+	};
+	/// J2735 payloads of a pcap or pcapng capture of WSMP frames, over Ethernet, IEEE 802.11 or radiotap.
+	/// The file is memory-mapped and each payload is handed out as a msgBuf_t into the mapping, after the
+	/// link-layer, WSMP (IEEE 1609.3 version 2 or 3) and 1609.2 headers, without copying. A payload stays
+	/// valid until close() or the destruction of the reader. Signed 1609.2 data is not verified.
+	class CaptureReader
+	{
+		public:
+			CaptureReader(void);
+			~CaptureReader(void);
+			CaptureReader(const CaptureReader&) = delete;
+			CaptureReader& operator=(const CaptureReader&) = delete;
+
+			/// map the file and read its header, false when it cannot be mapped or is not a capture
+			bool open(const char* fname);
+			void close(void);
+			/// walk the records up to the next J2735 payload, false at the end of the capture
+			bool next(msgBuf_t& msgOut);
+			/// append the next payloads to msgs, at most maxMsgs of them, and return the number appended
+			size_t read(std::vector<msgBuf_t>& msgs, size_t maxMsgs);
+			/// go back to the first record, and reset the counts
+			void rewind(void);
+			const captureStats_t& getStats(void) const
+				{return(stats);};
+			size_t getFileSize(void) const
+				{return(fileSize);};
+			/// start of the mapping, for the offset in the file of a payload handed out
+			const uint8_t* getFileData(void) const
+				{return(pFile);};
+			bool isPcapng(void) const
+				{return(pcapng);};
+
+		private:
+			const uint8_t* pFile;
+			size_t fileSize;
+			size_t pos;                        /// offset of the next record or block
+			bool pcapng;
+			bool swapped;                      /// byte order of the file or current section differs from the host's
+			uint32_t linkType;                 /// pcap link type
+			std::vector<uint32_t> ifLinkTypes; /// pcapng link type of each interface of the current section
+			captureStats_t stats;
+			/// next packet record, false at the end of the capture
+			bool nextPcapRecord(const uint8_t*& packet, size_t& size, uint32_t& recordLinkType);
+			bool nextPcapngRecord(const uint8_t*& packet, size_t& size, uint32_t& recordLinkType);
+			uint32_t get32(const uint8_t* p) const;
+			uint16_t get16(const uint8_t* p) const;
+	};
+	/// WSM data of a WAVE Short Message (IEEE 1609.3-2010 version 2 or 1609.3-2016 version 3)
+	bool get_wsmData(const uint8_t* buf, size_t size, msgBuf_t& dataOut);
+	/// payload of IEEE 1609.2 data, unsecured or signed. Fails on encrypted data and on malformed headers
+	bool get_1609dot2Payload(const uint8_t* buf, size_t size, msgBuf_t& payloadOut);
+};
+
+#endif
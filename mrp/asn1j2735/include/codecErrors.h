@@ -0,0 +1,66 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _CODEC_ERRORS_H
+#define _CODEC_ERRORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace AsnJ2735Lib
+{ /// reason of a failed encoding or decoding
+	enum class codecError : uint8_t
+	{
+		none,
+		allocFailed,      /// allocation of an asn1c structure failed
+		encodeFailed,     /// the asn1c UPER encoder rejected the MessageFrame, or the buffer is too small
+		decodeFailed,     /// malformed or truncated UPER encoding, or a constraint violation
+		wrongMsgType,     /// unknown message ID, or a MessageFrame of another type than asked for
+		missingElement,   /// an element that the dsrc structure needs is absent
+		invalidValue      /// a value that the dsrc structure cannot hold
+	};
+	const size_t numCodecErrors = 7;
+	const char* codecErrorName(codecError error);
+
+	/// failure counts by reason (indexed by codecError), of all threads since start or the last reset
+	struct codecErrorStats_t
+	{
+		uint64_t counts[numCodecErrors];
+		uint64_t numLogged;      /// failures handed to the log sink
+		uint64_t numSuppressed;  /// failures over the log rate, counted only
+	};
+	codecErrorStats_t get_codecErrorStats(void);
+	void reset_codecErrorStats(void);
+	/// reason of the last failure in the calling thread. It is set when an encoding or decoding function
+	/// fails and is not cleared on success, so read it right after the failed call
+	codecError get_lastCodecError(void);
+
+	/// integer values that go with a failure, such as the ID of the element and the value found.
+	/// what names them in order; numValues is 0 when there are none
+	const size_t maxCodecErrorValues = 4;
+	struct codecErrorDetail_t
+	{
+		size_t numValues;
+		int64_t values[maxCodecErrorValues];
+	};
+
+	/// log sink, called with the function that failed (where), what failed, both string literals, and
+	/// the values that go with it. It is called from the failing thread, for at most maxPerSecond failures
+	/// per second over all threads; the rest are counted only. There is no sink by default
+	typedef void (*codecLogSink_t)(codecError error, const char* where, const char* what, const codecErrorDetail_t& detail);
+	void set_codecLogSink(codecLogSink_t sink, uint32_t maxPerSecond = 10);
+	/// sink that writes one line per failure to stderr, with its values if any
+	void codecLogSink_stderr(codecError error, const char* where, const char* what, const codecErrorDetail_t& detail);
+
+	/// count a failure, note it as the last one of the calling thread and pass it to the log sink.
+	/// Used by the codec; where and what shall be string literals
+	void report_codecError(codecError error, const char* where, const char* what);
+	/// as above, with up to maxCodecErrorValues values that what names, e.g. "laneId, unknown directionalUse"
+	void report_codecError(codecError error, const char* where, const char* what, std::initializer_list<int64_t> values);
+};
+
+#endif
@@ -17,6 +17,8 @@
 #include "dsrcMapData.h"
 #include "msgEnum.h"
 
+/// dsrcMsgId names the member in use. The other members stay as their last reset left them,
+/// so reset() needs to reset the member in use only
 struct Frame_element_t
 {
 	uint16_t dsrcMsgId;
@@ -26,7 +28,7 @@ struct Frame_element_t
 	RTCM_element_t    rtcm;
 	SRM_element_t     srm;
 	SSM_element_t     ssm;
-	void reset(void)
+	Frame_element_t(void)
 	{
 		dsrcMsgId = MsgEnum::DSRCmsgID_unknown;
 		mapData.reset();
@@ -36,6 +38,33 @@ struct Frame_element_t
 		srm.reset();
 		ssm.reset();
 	};
+	void reset(void)
+	{
+		switch(dsrcMsgId)
+		{
+		case MsgEnum::DSRCmsgID_map:
+			mapData.reset();
+			break;
+		case MsgEnum::DSRCmsgID_spat:
+			spat.reset();
+			break;
+		case MsgEnum::DSRCmsgID_bsm:
+			bsm.reset();
+			break;
+		case MsgEnum::DSRCmsgID_rtcm:
+			rtcm.reset();
+			break;
+		case MsgEnum::DSRCmsgID_srm:
+			srm.reset();
+			break;
+		case MsgEnum::DSRCmsgID_ssm:
+			ssm.reset();
+			break;
+		default:
+			break;
+		}
+		dsrcMsgId = MsgEnum::DSRCmsgID_unknown;
+	};
 };
 
 #endif
@@ -12,6 +12,7 @@
 #include <bitset>
 #include <vector>
 
+#include "fixedList.h"
 #include "msgEnum.h"
 
 struct conn_element_t
@@ -77,7 +78,7 @@ struct lane_element_t
 		 */
 	uint16_t width;        // in centimeter
 	uint8_t  controlPhase; // 1 - 8
-	std::vector<conn_element_t> mpConnectTo;
+	FixedList<conn_element_t, MsgEnum::maxConnectsTo> mpConnectTo;
 	std::vector<node_element_t> mpNodes;
 };
 
@@ -113,7 +114,7 @@ struct MapData_element_t
 		 *    Reserved                              (4-7)
 		 */
 	geo_refPoint_t geoRef;
-	std::vector<uint16_t> speeds;
+	FixedList<uint16_t, MsgEnum::maxIntersectionGeometries> speeds;
 	std::vector<approach_element_t> mpApproaches;
 	void reset(void)
 	{
@@ -7,6 +7,7 @@
 #ifndef _DSRC_RTCM_H
 #define _DSRC_RTCM_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include "msgEnum.h"
@@ -24,4 +25,27 @@ struct RTCM_element_t
 	};
 };
 
+/// RTCM_element_t that refers to the RTCMmessage octets instead of holding a copy of them:
+/// the octets of the encoded MessageFrame when decoded, or the caller's octets when encoding.
+/// The octets start at bit bitPos of buf, which in a UPER MessageFrame need not be a byte boundary;
+/// data() is NULL then, and AsnJ2735Lib::get_rtcmPayload takes them out
+struct RTCMview_t
+{
+	uint8_t  msgCnt;            // (0..127)
+	uint8_t  rev;               // (0..3)
+	uint32_t timeStampMinute;   // minute of the year
+	const uint8_t* buf;
+	size_t   bitPos;
+	size_t   payloadSize;       // (1..1023) octets
+	const uint8_t* data(void) const
+		{return(((buf == NULL) || ((bitPos & 7) != 0)) ? NULL : buf + (bitPos >> 3));};
+	void reset(void)
+	{
+		timeStampMinute = MsgEnum::invalid_timeStampMinute;
+		buf = NULL;
+		bitPos = 0;
+		payloadSize = 0;
+	};
+};
+
 #endif
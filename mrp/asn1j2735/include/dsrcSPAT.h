@@ -9,9 +9,12 @@
 
 #include <cstdint>
 #include <bitset>
+#include <vector>
+#include "fixedList.h"
 #include "msgEnum.h"
 
-struct PhaseState_element_t
+/// MovementEvent of a signal group
+struct MovementEvent_element_t
 {
 	MsgEnum::phaseState  currState;
 	// following time marks are in tenths of a second in the current or next hour
@@ -27,7 +30,22 @@ struct PhaseState_element_t
 	};
 };
 
-struct SPAT_element_t
+/// phase of a signal group. The current MovementEvent is held in the inherited members, and the
+/// predicted ones that follow it in the nextEvents of its IntersectionState_element_t
+struct PhaseState_element_t : MovementEvent_element_t
+{
+	uint8_t  numNextEvents;    // predicted MovementEvents after the current one
+	uint16_t firstNextEvent;   // index of the first of them in IntersectionState_element_t::nextEvents
+	void reset(void)
+	{
+		MovementEvent_element_t::reset();
+		numNextEvents = 0;
+		firstNextEvent = 0;
+	};
+};
+
+/// IntersectionState of a SPaT
+struct IntersectionState_element_t
 {
 	uint16_t regionalId;
 	uint16_t id;                // intersection ID
@@ -56,6 +74,25 @@ struct SPAT_element_t
 		 */
 	PhaseState_element_t phaseState[8];
 	PhaseState_element_t pedPhaseState[8];
+	/// predicted MovementEvents of all signal groups, those of each group together and in time order.
+	/// They are kept apart from the phases, so that a SPaT without predictions costs no more than before;
+	/// reset keeps the capacity
+	std::vector<MovementEvent_element_t> nextEvents;
+	size_t numEvents(const PhaseState_element_t& phase) const
+		{return(1 + phase.numNextEvents);};
+	MovementEvent_element_t& event(PhaseState_element_t& phase, size_t i)
+		{return((i == 0) ? phase : nextEvents[phase.firstNextEvent + i - 1]);};
+	const MovementEvent_element_t& event(const PhaseState_element_t& phase, size_t i) const
+		{return((i == 0) ? phase : nextEvents[phase.firstNextEvent + i - 1]);};
+	/// give phase numNext (< MsgEnum::maxMovementEvents) predicted MovementEvents, reset, after its current one
+	void setNumNextEvents(PhaseState_element_t& phase, size_t numNext)
+	{
+		phase.numNextEvents = static_cast<uint8_t>(numNext);
+		phase.firstNextEvent = static_cast<uint16_t>(nextEvents.size());
+		MovementEvent_element_t nextEvent;
+		nextEvent.reset();
+		nextEvents.resize(nextEvents.size() + numNext, nextEvent);
+	};
 	void reset(void)
 	{
 		regionalId = 0;
@@ -68,6 +105,27 @@ struct SPAT_element_t
 			phaseState[i].reset();
 			pedPhaseState[i].reset();
 		}
+		nextEvents.clear();
+	};
+};
+
+/// SPaT of one or more intersections. The first intersection is held in the inherited members,
+/// so that code for single-intersection SPaT reads it as before, and the others in moreIntersections.
+/// These are kept apart from the frame, so that single-intersection SPaT costs no more than before;
+/// reset keeps their capacity, so a reused SPAT_element_t allocates only for the largest corridor seen
+struct SPAT_element_t : IntersectionState_element_t
+{
+	std::vector<IntersectionState_element_t> moreIntersections;  /// up to MsgEnum::maxSpatIntersections - 1
+	size_t numIntersections(void) const
+		{return(1 + moreIntersections.size());};
+	IntersectionState_element_t& intersection(size_t i)
+		{return((i == 0) ? *this : moreIntersections[i - 1]);};
+	const IntersectionState_element_t& intersection(size_t i) const
+		{return((i == 0) ? *this : moreIntersections[i - 1]);};
+	void reset(void)
+	{
+		IntersectionState_element_t::reset();
+		moreIntersections.clear();
 	};
 };
 
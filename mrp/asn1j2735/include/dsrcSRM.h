@@ -8,13 +8,12 @@
 #define _DSRC_SRM_H
 
 #include <cstdint>
+#include "fixedList.h"
 #include "msgEnum.h"
 
-struct SRM_element_t
+/// SignalRequestPackage of an SRM, the request for one intersection
+struct SignalRequest_element_t
 {
-	uint32_t  timeStampMinute; //  minute of the year
-	uint16_t  timeStampSec;    //  millisecond of the current minute
-	uint8_t   msgCnt;          // (0..127), set to 0xFF when EXCL
 	// intersection data for request
 	uint16_t  regionalId;
 	uint16_t  intId;
@@ -26,6 +25,29 @@ struct SRM_element_t
 	uint32_t  ETAminute;      // minute of the year
 	uint16_t  ETAsec;         // millisecond of the minute
 	uint16_t  duration;       // in milliseconds
+	// enum
+	MsgEnum::requestType  reqType;
+	void reset(void)
+	{
+		regionalId      = 0;
+		ETAminute       = MsgEnum::invalid_timeStampMinute;
+		ETAsec          = 0xFFFF;
+		duration        = 0xFFFF;
+		inApprochId     = 0;
+		inLaneId        = 0;
+		outApproachId   = 0;
+		outLaneId       = 0;
+		reqType         = MsgEnum::requestType::reserved;
+	};
+};
+
+/// SRM of one or more requests. The first request is held in the inherited members, so that code
+/// for single-request SRM reads it as before, and the others in moreRequests
+struct SRM_element_t : SignalRequest_element_t
+{
+	uint32_t  timeStampMinute; //  minute of the year
+	uint16_t  timeStampSec;    //  millisecond of the current minute
+	uint8_t   msgCnt;          // (0..127), set to 0xFF when EXCL
 	// vehicle data
 	uint32_t  vehId;
 	int32_t   latitude;       // in 1/10th micro degrees
@@ -34,28 +56,27 @@ struct SRM_element_t
 	uint16_t  heading;        // LSB of 0.0125 degrees
 	uint16_t  speed;          // units of 0.02 m/s, (0..8191), 0x1FFF(8191) = unavailable
 	// enum
-	MsgEnum::requestType  reqType;
 	MsgEnum::basicRole    vehRole;
 	MsgEnum::vehicleType  vehType;
 	MsgEnum::transGear    transState;
+	FixedList<SignalRequest_element_t, MsgEnum::maxSignalRequests - 1> moreRequests;
+	size_t numRequests(void) const
+		{return(1 + moreRequests.size());};
+	SignalRequest_element_t& request(size_t i)
+		{return((i == 0) ? *this : moreRequests[i - 1]);};
+	const SignalRequest_element_t& request(size_t i) const
+		{return((i == 0) ? *this : moreRequests[i - 1]);};
 	void reset(void)
 	{
+		SignalRequest_element_t::reset();
 		timeStampMinute = MsgEnum::invalid_timeStampMinute;
 		msgCnt          = 0xFF;
-		regionalId      = 0;
-		ETAminute       = MsgEnum::invalid_timeStampMinute;
-		ETAsec          = 0xFFFF;
-		duration        = 0xFFFF;
-		inApprochId     = 0;
-		inLaneId        = 0;
-		outApproachId   = 0;
-		outLaneId       = 0;
 		elevation       = MsgEnum::unknown_elevation;
 		speed           = MsgEnum::unknown_speed;
 		transState      = MsgEnum::transGear::unavailable;
-		reqType         = MsgEnum::requestType::reserved;
 		vehRole         = MsgEnum::basicRole::unavailable;
 		vehType         = MsgEnum::vehicleType::unavailable;
+		moreRequests.clear();
 	};
 };
 
@@ -8,7 +8,7 @@
 #define _DSRC_SSM_H
 
 #include <cstdint>
-#include <vector>
+#include "fixedList.h"
 #include "msgEnum.h"
 
 struct SignalRequetStatus_t
@@ -48,7 +48,7 @@ struct SSM_element_t
 	uint8_t   updateCnt;         // (0..127), change whenever mpSignalRequetStatus has changed
 	uint16_t  regionalId;
 	uint16_t  id;                // intersection ID
-	std::vector<SignalRequetStatus_t> mpSignalRequetStatus;  // maximum entries: 32
+	FixedList<SignalRequetStatus_t, MsgEnum::maxSignalStatusPackages> mpSignalRequetStatus;
 	void reset(void)
 	{
 		timeStampMinute = MsgEnum::invalid_timeStampMinute;
@@ -0,0 +1,96 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _FIXED_LIST_H
+#define _FIXED_LIST_H
+
+#include <cstddef>
+
+/// list of at most N elements held inline, for the lists of the dsrc element structures that J2735 bounds
+/// with a SIZE constraint. It follows std::vector as far as the codec uses it, except that push_back
+/// and resize return false instead of growing beyond N. No member allocates, and clear() only drops
+/// the count, so an element structure that is reused from message to message never touches the heap.
+template<typename T, size_t N>
+class FixedList
+{
+	public:
+		typedef T value_type;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		FixedList(void) : count(0) {};
+		FixedList(const FixedList& other) : count(other.count)
+		{
+			for (size_t i = 0; i < count; i++)
+				items[i] = other.items[i];
+		};
+		FixedList& operator=(const FixedList& other)
+		{
+			count = other.count;
+			for (size_t i = 0; i < count; i++)
+				items[i] = other.items[i];
+			return(*this);
+		};
+
+		static constexpr size_t capacity(void)
+			{return(N);};
+		size_t size(void) const
+			{return(count);};
+		bool empty(void) const
+			{return(count == 0);};
+		void clear(void)
+			{count = 0;};
+
+		bool push_back(const T& item)
+		{
+			if (count == N)
+				return(false);
+			items[count++] = item;
+			return(true);
+		};
+		/// new elements are value-initialized, as with std::vector
+		bool resize(size_t n)
+		{
+			if (n > N)
+				return(false);
+			for (size_t i = count; i < n; i++)
+				items[i] = T();
+			count = n;
+			return(true);
+		};
+
+		T& operator[](size_t i)
+			{return(items[i]);};
+		const T& operator[](size_t i) const
+			{return(items[i]);};
+		T& front(void)
+			{return(items[0]);};
+		const T& front(void) const
+			{return(items[0]);};
+		T& back(void)
+			{return(items[count - 1]);};
+		const T& back(void) const
+			{return(items[count - 1]);};
+		T* data(void)
+			{return(items);};
+		const T* data(void) const
+			{return(items);};
+
+		iterator begin(void)
+			{return(items);};
+		iterator end(void)
+			{return(items + count);};
+		const_iterator begin(void) const
+			{return(items);};
+		const_iterator end(void) const
+			{return(items + count);};
+
+	private:
+		size_t count;
+		T items[N];
+};
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef _DSRCMSGENUM_H
 #define _DSRCMSGENUM_H
 
+#include <cstddef>
 #include <cstdint>
 #include <bitset>
 #include <string>
@@ -31,6 +32,14 @@ namespace MsgEnum
 	static const uint16_t unknown_timeDetail = 36001;
 	static const uint16_t unknown_speed = 8191;
 
+	/// SIZE constraints of J2735 lists held inline by the dsrc element structures
+	static const size_t   maxSignalStatusPackages = 32;    /// SignalStatusPackageList
+	static const size_t   maxIntersectionGeometries = 32;  /// IntersectionGeometryList, one per distinct speed limit
+	static const size_t   maxConnectsTo = 16;              /// ConnectsToList
+	static const size_t   maxSpatIntersections = 32;       /// IntersectionStateList, the first inline and the others in a vector
+	static const size_t   maxMovementEvents = 16;          /// MovementEventList, the first inline and the others in a vector
+	static const size_t   maxSignalRequests = 32;          /// SignalRequestList
+
 	static const uint8_t  rswz_roadwork = 3;
 
 	enum class approachType    : uint8_t {inbound = 1, outbound, crosswalk = 4};
@@ -0,0 +1,143 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _PAYLOAD_CACHE_H
+#define _PAYLOAD_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "dsrcFrame.h"
+
+namespace AsnJ2735Lib
+{ /// lookup counts of a PayloadCache since its construction
+	struct payloadCacheStats_t
+	{
+		uint64_t numHits;
+		uint64_t numMisses;
+		uint64_t numEvictions;  /// entries replaced to make room for a new payload
+	};
+	/// 64-bit hash of the payload bytes, read 8 bytes at a time
+	uint64_t payloadHash(const uint8_t* buf, size_t size);
+
+	/// bounded content-addressed cache from a payload to a value of type T: what was decoded from it,
+	/// or what was concluded from it. A lookup hashes the payload and compares the bytes of an entry
+	/// with the same hash, so a hit is exact. At most numSlots payloads are kept, the least recently
+	/// used one giving way to a new one; the payload and T storage of a slot are reused.
+	/// Not thread-safe, keep one per thread.
+	template<typename T>
+	class PayloadCache
+	{
+		public:
+			explicit PayloadCache(size_t numSlots = 16) : slots(numSlots), useCount(0)
+			{
+				for (auto& slot : slots)
+					slot.inUse = false;
+				stats.numHits = 0;
+				stats.numMisses = 0;
+				stats.numEvictions = 0;
+			};
+			/// the value stored for these payload bytes, NULL when they are not in the cache
+			T* find(const uint8_t* buf, size_t size)
+			{
+				uint64_t hash = payloadHash(buf, size);
+				for (auto& slot : slots)
+				{
+					if (slot.inUse && (slot.hash == hash) && (slot.payload.size() == size)
+						&& (std::memcmp(&slot.payload[0], buf, size) == 0))
+					{
+						slot.lastUse = ++useCount;
+						stats.numHits++;
+						return(&slot.value);
+					}
+				}
+				stats.numMisses++;
+				return(NULL);
+			};
+			/// take the least recently used slot for these payload bytes, and return its value for the
+			/// caller to fill in. The value keeps whatever the slot held before
+			T* insert(const uint8_t* buf, size_t size)
+			{
+				if (slots.empty() || (size == 0))
+					return(NULL);
+				slot_t* pSlot = &slots[0];
+				for (auto& slot : slots)
+				{
+					if (!slot.inUse)
+					{
+						pSlot = &slot;
+						break;
+					}
+					if (slot.lastUse < pSlot->lastUse)
+						pSlot = &slot;
+				}
+				if (pSlot->inUse)
+					stats.numEvictions++;
+				pSlot->inUse = true;
+				pSlot->hash = payloadHash(buf, size);
+				pSlot->lastUse = ++useCount;
+				pSlot->payload.assign(buf, buf + size);
+				return(&pSlot->value);
+			};
+			/// drop the entry of a value returned by find or insert, e.g. when decoding into it failed
+			void erase(const T* pValue)
+			{
+				for (auto& slot : slots)
+				{
+					if (&slot.value == pValue)
+						slot.inUse = false;
+				}
+			};
+			/// drop all entries, when what the values were concluded from has changed
+			void clear(void)
+			{
+				for (auto& slot : slots)
+					slot.inUse = false;
+			};
+			const payloadCacheStats_t& getStats(void) const
+				{return(stats);};
+
+		private:
+			struct slot_t
+			{
+				bool inUse;
+				uint64_t hash;
+				uint64_t lastUse;
+				std::vector<uint8_t> payload;
+				T value;
+			};
+			std::vector<slot_t> slots;
+			uint64_t useCount;
+			payloadCacheStats_t stats;
+	};
+
+	/// decoding with decode_msgFrame_direct in front of which sits a PayloadCache of the decoded frames.
+	/// A payload that was decoded recently, such as a MAP re-broadcast every second or a SPaT repeated by
+	/// the RSU, is not decoded again
+	class CachedDecoder
+	{
+		public:
+			explicit CachedDecoder(size_t numSlots = 16) : cache(numSlots) {};
+			/// decode, or find, the payload. On success, pFrameOut points to the frame held in the cache,
+			/// which stays valid until the next call, and isRepeat tells whether it came from the cache.
+			/// Returns the number of bytes consumed, 0 on failure. Failures are not cached
+			size_t decode(const uint8_t* buf, size_t size, const Frame_element_t*& pFrameOut, bool& isRepeat);
+			const payloadCacheStats_t& getStats(void) const
+				{return(cache.getStats());};
+
+		private:
+			struct decodedFrame_t
+			{
+				size_t consumed;
+				Frame_element_t dsrcFrame;
+			};
+			PayloadCache<decodedFrame_t> cache;
+	};
+};
+
+#endif
@@ -0,0 +1,103 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _STREAM_DECODER_H
+#define _STREAM_DECODER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "AsnJ2735Lib.h"
+
+namespace AsnJ2735Lib
+{ /// frame counts of a StreamDecoder since its construction or the last reset
+	struct streamStats_t
+	{
+		size_t numFrames;       /// frames handed out by next, whatever their status
+		size_t numDecoded;
+		size_t numFailed;       /// frames that failed decoding, including the flushed and oversized ones
+		size_t numFlushed;      /// partial frames given up on at the deadline
+		size_t numOversized;    /// frames longer than the ring can hold
+		size_t numCompactions;  /// moves of a partial frame from the end of the ring to its start
+		uint64_t bytesMoved;    /// bytes moved by the compactions
+		uint64_t bytesSkipped;  /// bytes of flushed and oversized frames dropped as they arrived
+		void reset(void)
+		{
+			numFrames = 0;
+			numDecoded = 0;
+			numFailed = 0;
+			numFlushed = 0;
+			numOversized = 0;
+			numCompactions = 0;
+			bytesMoved = 0;
+			bytesSkipped = 0;
+		};
+	};
+	/// decoder of a stream of J2735 payloads, each preceded by its length as 2 bytes in network byte
+	/// order, such as a UDP forwarder's output or a recorded binary stream. The bytes are read by the
+	/// caller straight into a ring buffer that the caller owns: getWriteBuf gives where to read to and
+	/// commit how many bytes were read. next decodes the complete frames in order with
+	/// decode_msgFrame_direct, in place in the ring, as reads may end in the middle of a frame.
+	/// The bytes held are kept contiguous: when the end of the ring is reached, the unfinished frame,
+	/// shorter than the ring, is moved back to its start, and no payload byte is ever copied out.
+	/// With a deadline, a frame that stays unfinished that long is handed out as failed and the rest
+	/// of its bytes are dropped when they arrive, so a stalled source delays the frames after it by
+	/// at most the deadline. Not thread-safe, keep one per stream.
+	class StreamDecoder
+	{
+		public:
+			/// smallest ring that can make progress: the length prefix plus one payload byte
+			static const size_t minCapacity = 3;
+			/// maxLatency = 0 waits for each frame to complete. A ring shorter than minCapacity is
+			/// rejected: isValid is false, getWriteBuf gives no space and next hands out nothing
+			StreamDecoder(uint8_t* ring, size_t capacity,
+				std::chrono::milliseconds maxLatency = std::chrono::milliseconds(0));
+			StreamDecoder(const StreamDecoder&) = delete;
+			StreamDecoder& operator=(const StreamDecoder&) = delete;
+
+			/// contiguous free space of the ring to read the next bytes into. Its size is 0 when the ring
+			/// is full of complete frames, which next has to take out first
+			uint8_t* getWriteBuf(size_t& sizeOut);
+			/// numBytes were read into the space given by getWriteBuf
+			void commit(size_t numBytes);
+			/// hand out the next complete frame, or the unfinished one past its deadline.
+			/// Returns false when there is none yet
+			bool next(decodeResult_t& resultOut);
+			/// as next, at time now, which the caller may already have at hand
+			bool next(decodeResult_t& resultOut, std::chrono::steady_clock::time_point now);
+			/// drop the bytes held, e.g. to resynchronise after the source restarts
+			void reset(void);
+			/// whether the ring given at construction is usable
+			bool isValid(void) const
+				{return(capacity > 0);};
+			/// number of bytes held, complete frames and the unfinished one
+			size_t getNumPending(void) const
+				{return(writePos - readPos);};
+			const streamStats_t& getStats(void) const
+				{return(stats);};
+			void resetStats(void)
+				{stats.reset();};
+
+		private:
+			uint8_t* pRing;
+			size_t capacity;
+			size_t readPos;       /// start of the first frame not yet handed out
+			size_t writePos;      /// end of the bytes held
+			size_t skipBytes;     /// bytes of a flushed or oversized frame yet to arrive, to be dropped
+			bool isFlushed;       /// the frame at readPos was flushed before its length arrived
+			std::chrono::milliseconds maxLatency;
+			std::chrono::steady_clock::time_point frameStart;  /// when the first byte of the frame at readPos arrived
+			std::chrono::steady_clock::time_point lastCommit;
+			streamStats_t stats;
+			/// fill in the result of a frame that is given up on
+			void handOutFailed(decodeResult_t& resultOut);
+			/// drop the frame at readPos, its bytes held now and the rest as they arrive
+			void dropFrame(void);
+	};
+};
+
+#endif
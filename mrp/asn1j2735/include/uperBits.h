@@ -0,0 +1,348 @@
+//************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _UPER_BITS_H
+#define _UPER_BITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// bit-level primitives of ASN.1 Unaligned Packed Encoding Rules (X.691)
+namespace UperBits
+{
+	/// UPER bit stream reader over a caller-owned buffer.
+	/// Errors are sticky: once a read fails (overrun, value out of range, unsupported encoding),
+	/// all later reads return 0 and ok() returns false, so callers check once at the end.
+	/// Open types that the caller does not decode (regional extensions, BSM Part II) fail the read,
+	/// unless lazy is set, in which case they are skipped by their length determinant.
+	class Reader
+	{
+		public:
+			Reader(const uint8_t* buf, size_t size, bool lazy = false) :
+				pbuf(buf), totalBits(size * 8), pos(0), error(false), skipOpenTypes(lazy) {};
+
+			bool ok(void) const
+				{return(!error);};
+			void fail(void)
+				{error = true;};
+			size_t position(void) const
+				{return(pos);};
+			size_t size(void) const
+				{return(totalBits);};
+			bool isLazy(void) const
+				{return(skipOpenTypes);};
+			const uint8_t* data(void) const
+				{return(pbuf);};
+
+			/// read nbits (<= 32) as an unsigned number, most significant bit first
+			uint32_t get(unsigned int nbits)
+			{
+				if ((nbits == 0) || error)
+					return(0);
+				if ((nbits > 32) || (pos + nbits > totalBits))
+				{
+					error = true;
+					return(0);
+				}
+				const uint8_t* p = pbuf + (pos >> 3);
+				unsigned int offset = static_cast<unsigned int>(pos & 7);
+				unsigned int numBytes = (offset + nbits + 7) >> 3;
+				uint64_t acc = 0;
+				for (unsigned int i = 0; i < numBytes; i++)
+					acc = (acc << 8) | p[i];
+				acc >>= (numBytes * 8 - offset - nbits);
+				pos += nbits;
+				return(static_cast<uint32_t>(acc & ((1ULL << nbits) - 1)));
+			};
+
+			bool getBit(void)
+				{return(get(1) != 0);};
+
+			/// constrained whole number (lb..ub) encoded in nbits
+			int64_t getRange(int64_t lb, int64_t ub, unsigned int nbits)
+			{
+				int64_t value = lb + static_cast<int64_t>(get(nbits));
+				if (value > ub)
+				{
+					error = true;
+					return(0);
+				}
+				return(value);
+			};
+
+			/// root value of an extensible constrained type, fails on an extension value
+			int64_t getExtRange(int64_t lb, int64_t ub, unsigned int nbits)
+			{
+				if (getBit())
+				{
+					error = true;
+					return(0);
+				}
+				return(getRange(lb, ub, nbits));
+			};
+
+			/// unconstrained length determinant (X.691#11.9.3.6-7), fragmentation is not supported
+			size_t getLength(void)
+			{
+				size_t value = get(8);
+				if ((value & 0x80) == 0)
+					return(value);
+				if ((value & 0x40) == 0)
+					return(((value & 0x3F) << 8) | get(8));
+				error = true;
+				return(0);
+			};
+
+			/// bit-map of nbits (<= 32) optional/default members
+			uint32_t getPresence(unsigned int nbits)
+				{return(get(nbits));};
+
+			void skip(size_t nbits)
+			{
+				if (error || (pos + nbits > totalBits))
+				{
+					error = true;
+					return;
+				}
+				pos += nbits;
+			};
+
+			/// read numBytes octets into out, a plain copy when the position is byte-aligned
+			void getOctets(uint8_t* out, size_t numBytes)
+			{
+				if (error || (pos + numBytes * 8 > totalBits))
+				{
+					error = true;
+					return;
+				}
+				if ((pos & 7) == 0)
+				{
+					std::memcpy(out, pbuf + (pos >> 3), numBytes);
+					pos += numBytes * 8;
+					return;
+				}
+				for (size_t i = 0; i < numBytes; i++)
+					out[i] = static_cast<uint8_t>(get(8));
+			};
+
+			/// skip an open type value
+			void skipOpenType(void)
+				{skip(getLength() * 8);};
+
+			/// enter an open type value, returns the bit position where the value ends
+			size_t enterOpenType(void)
+			{
+				size_t numBytes = getLength();
+				size_t end = pos + numBytes * 8;
+				if ((numBytes == 0) || (end > totalBits))
+				{
+					error = true;
+					return(pos);
+				}
+				return(end);
+			};
+
+			/// leave an open type value: the remaining padding must be less than 8 zero bits
+			void leaveOpenType(size_t end)
+			{
+				if (error || (pos > end) || (end - pos >= 8) || (get(static_cast<unsigned int>(end - pos)) != 0))
+					error = true;
+			};
+
+			/// skip extension additions of an extensible SEQUENCE whose extension bit is set
+			void skipExtensions(void)
+			{
+				if (getBit())
+				{ // normally small length > 64
+					error = true;
+					return;
+				}
+				unsigned int numBits = get(6) + 1;
+				size_t numPresent = 0;
+				for (unsigned int i = 0; i < numBits; i++)
+				{
+					if (getBit())
+						numPresent++;
+				}
+				for (size_t i = 0; i < numPresent; i++)
+					skipOpenType();
+			};
+
+			/// skip SEQUENCE (SIZE(1..4)) OF RegionalExtension.
+			/// No regional extension is compiled into mrp/asn1, so the asn1c path rejects them all
+			void skipRegionalList(void)
+			{
+				if (!skipOpenTypes)
+				{
+					error = true;
+					return;
+				}
+				size_t count = get(2) + 1;
+				for (size_t i = 0; i < count; i++)
+				{
+					get(8);
+					skipOpenType();
+				}
+			};
+
+			/// skip a single RegionalExtension
+			void skipRegional(void)
+			{
+				if (!skipOpenTypes)
+				{
+					error = true;
+					return;
+				}
+				get(8);
+				skipOpenType();
+			};
+
+			/// skip DescriptiveName ::= IA5String (SIZE(1..63))
+			void skipDescriptiveName(void)
+				{skip((get(6) + 1) * 7);};
+
+		private:
+			const uint8_t* pbuf;
+			size_t totalBits;
+			size_t pos;
+			bool   error;
+			bool   skipOpenTypes;
+	};
+
+	/// UPER bit stream writer into a caller-owned buffer.
+	/// Errors are sticky as with Reader: a value outside its constraint or a buffer overrun
+	/// stops all later writes and ok() returns false. Unused bits of the last byte are zero.
+	class Writer
+	{
+		public:
+			Writer(uint8_t* buf, size_t size) : pbuf(buf), totalBits(size * 8), pos(0), error(false) {};
+
+			bool ok(void) const
+				{return(!error);};
+			void fail(void)
+				{error = true;};
+			size_t position(void) const
+				{return(pos);};
+			/// number of bytes holding the bits written so far
+			size_t bytes(void) const
+				{return((pos + 7) >> 3);};
+
+			/// write the nbits (<= 32) least significant bits of value, most significant bit first
+			void put(uint32_t value, unsigned int nbits)
+			{
+				if ((nbits == 0) || error)
+					return;
+				if ((nbits > 32) || (pos + nbits > totalBits))
+				{
+					error = true;
+					return;
+				}
+				uint8_t* p = pbuf + (pos >> 3);
+				unsigned int offset = static_cast<unsigned int>(pos & 7);
+				unsigned int numBytes = (offset + nbits + 7) >> 3;
+				uint64_t acc = (static_cast<uint64_t>(value) & ((1ULL << nbits) - 1)) << (numBytes * 8 - offset - nbits);
+				uint8_t head = (offset == 0) ? 0 : static_cast<uint8_t>(p[0] & (0xFF << (8 - offset)));
+				for (unsigned int i = 0; i < numBytes; i++)
+					p[i] = static_cast<uint8_t>(acc >> ((numBytes - 1 - i) * 8));
+				p[0] = static_cast<uint8_t>(p[0] | head);
+				pos += nbits;
+			};
+
+			void putBit(bool value)
+				{put(value ? 1 : 0, 1);};
+
+			/// constrained whole number (lb..ub) encoded in nbits, fails when value is out of range
+			void putRange(int64_t value, int64_t lb, int64_t ub, unsigned int nbits)
+			{
+				if ((value < lb) || (value > ub))
+				{
+					error = true;
+					return;
+				}
+				put(static_cast<uint32_t>(value - lb), nbits);
+			};
+
+			/// root value of an extensible constrained type
+			void putExtRange(int64_t value, int64_t lb, int64_t ub, unsigned int nbits)
+			{
+				putBit(false);
+				putRange(value, lb, ub, nbits);
+			};
+
+			/// write numBytes octets, a plain copy when the position is byte-aligned
+			void putOctets(const uint8_t* octets, size_t numBytes)
+			{
+				if (error || (pos + numBytes * 8 > totalBits))
+				{
+					error = true;
+					return;
+				}
+				if ((pos & 7) == 0)
+				{
+					std::memcpy(pbuf + (pos >> 3), octets, numBytes);
+					pos += numBytes * 8;
+					return;
+				}
+				for (size_t i = 0; i < numBytes; i++)
+					put(octets[i], 8);
+			};
+
+			/// overwrite the nbits (<= 32) at bitPos with the least significant bits of value,
+			/// keeping the bits around them. The write position is not moved
+			void patch(size_t bitPos, uint32_t value, unsigned int nbits)
+			{
+				if ((nbits == 0) || error)
+					return;
+				if ((nbits > 32) || (bitPos + nbits > totalBits))
+				{
+					error = true;
+					return;
+				}
+				uint8_t* p = pbuf + (bitPos >> 3);
+				unsigned int offset = static_cast<unsigned int>(bitPos & 7);
+				unsigned int numBytes = (offset + nbits + 7) >> 3;
+				unsigned int shift = numBytes * 8 - offset - nbits;
+				uint64_t mask = ((1ULL << nbits) - 1) << shift;
+				uint64_t acc = 0;
+				for (unsigned int i = 0; i < numBytes; i++)
+					acc = (acc << 8) | p[i];
+				acc = (acc & ~mask) | ((static_cast<uint64_t>(value) << shift) & mask);
+				for (unsigned int i = 0; i < numBytes; i++)
+					p[i] = static_cast<uint8_t>(acc >> ((numBytes - 1 - i) * 8));
+			};
+
+			/// patch a constrained whole number (lb..ub) encoded in nbits, fails when value is out of range
+			void patchRange(size_t bitPos, int64_t value, int64_t lb, int64_t ub, unsigned int nbits)
+			{
+				if ((value < lb) || (value > ub))
+				{
+					error = true;
+					return;
+				}
+				patch(bitPos, static_cast<uint32_t>(value - lb), nbits);
+			};
+
+			/// unconstrained length determinant (X.691#11.9.3.6-7), fragmentation is not supported
+			void putLength(size_t value)
+			{
+				if (value < 0x80)
+					put(static_cast<uint32_t>(value), 8);
+				else if (value < 0x4000)
+					put(static_cast<uint32_t>(0x8000 | value), 16);
+				else
+					error = true;
+			};
+
+		private:
+			uint8_t* pbuf;
+			size_t totalBits;
+			size_t pos;
+			bool   error;
+	};
+};
+
+#endif
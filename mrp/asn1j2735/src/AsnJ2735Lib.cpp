@@ -7,17 +7,19 @@
 #include <algorithm>
 #include <bitset>
 #include <cmath>
-#include <iostream>
-#include <string>
 #include <vector>
 #include <ctime>
 
 // asn1
 #include <asn_application.h>
+#include <asn_allocator.h>
 #include "MessageFrame.h"
 // asn1j2735
 #include "AsnJ2735Lib.h"
 
+using AsnJ2735Lib::codecError;
+using AsnJ2735Lib::report_codecError;
+
 /// convert number of bits to number of bytes
 auto numbits2numbytes = [](const ssize_t& bit_nums)->size_t
 	{return((bit_nums <= 0) ? (0) : ((bit_nums + 7) >> 3));};
@@ -44,9 +46,10 @@ auto octString2ul = [](const uint8_t* pbuf, const size_t& size)->unsigned long
 /// reverse bit-order of unsigned long
 auto reverseul = [](const unsigned long& value, const int& num_bits)->unsigned long
 {
-	std::string str = std::bitset<32>(value).to_string().substr(32 - num_bits);
-	std::reverse(str.begin(), str.end());
-	return(std::bitset<32>(str).to_ulong());
+	unsigned long ret = 0;
+	for (int i = 0; i < num_bits; i++)
+		ret = (ret << 1) | ((value >> i) & 0x01);
+	return(ret);
 };
 
 /// convert BIT STRING to unsigned long
@@ -94,24 +97,21 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 	//	RestrictionClassList                EXCL
 	//	RegionalExtension                   EXCL
 	// -------------------------------------------------------- //
-	std::string prog_name = "mapData2msgFrame_single: ";
-	std::string allocate_level{"MapData"};
 	// msgIssueRevision
 	mapData.msgIssueRevision	= mapDataIn.mapVersion;
 	// LayerType
 	if ((mapData.layerType = (LayerType_t *)calloc(1, sizeof(LayerType_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".LayerType" << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.LayerType");
 		return(false);
 	}
 	*(mapData.layerType) = LayerType_intersectionData;
 	// IntersectionGeometryList - one intersection per MapData
-	allocate_level += ".IntersectionGeometryList.IntersectionGeometry";
 	if (((mapData.intersections = (IntersectionGeometryList_t *)calloc(1, sizeof(IntersectionGeometryList_t))) == NULL)
 		|| ((mapData.intersections->list.array = (IntersectionGeometry_t **)calloc(1, sizeof(IntersectionGeometry_t *))) == NULL)
 		|| ((mapData.intersections->list.array[0] = (IntersectionGeometry_t *)calloc(1, sizeof(IntersectionGeometry_t))) == NULL))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry");
 		return(false);
 	}
 	mapData.intersections->list.size = 1;
@@ -134,7 +134,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 	pIntersectionGeometry->id.id = mapDataIn.id;
 	if ((pIntersectionGeometry->id.region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".id.region" << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.id.region");
 		return(false);
 	}
 	*(pIntersectionGeometry->id.region) = mapDataIn.regionalId;
@@ -147,7 +147,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 	{ // include elevation data
 		if ((pIntersectionGeometry->refPoint.elevation = (DSRC_Elevation_t *)calloc(1, sizeof(DSRC_Elevation_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".Position3D.Elevation" << std::endl;
+			report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.Position3D.Elevation");
 			return(false);
 		}
 		*(pIntersectionGeometry->refPoint.elevation) = mapDataIn.geoRef.elevation;
@@ -156,7 +156,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 	uint16_t refLaneWidth = mapDataIn.mpApproaches[0].mpLanes[0].width;
 	if ((pIntersectionGeometry->laneWidth = (LaneWidth_t *)calloc(1, sizeof(LaneWidth_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".LaneWidth" << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneWidth");
 		return(false);
 	}
 	*(pIntersectionGeometry->laneWidth) = refLaneWidth;
@@ -166,7 +166,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 		|| ((pIntersectionGeometry->speedLimits->list.array = static_cast<RegulatorySpeedLimit_t **>(std::calloc(1, sizeof(RegulatorySpeedLimit_t *)))) == NULL)
 		|| ((pIntersectionGeometry->speedLimits->list.array[0] = static_cast<RegulatorySpeedLimit_t *>(std::calloc(1, sizeof(RegulatorySpeedLimit_t)))) == NULL))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".SpeedLimitList" << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.SpeedLimitList");
 		return(false);
 	}
 	pIntersectionGeometry->speedLimits->list.size = 1;
@@ -174,7 +174,6 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 	pIntersectionGeometry->speedLimits->list.array[0]->type  = SpeedLimitType_vehicleMaxSpeed;
 	pIntersectionGeometry->speedLimits->list.array[0]->speed = refSpeedLimt;
 	// LaneList
-	std::string branch_level{".LaneList"};
 	size_t num_lanes = 0;
 	for (auto it = mapDataIn.mpApproaches.begin(); it != mapDataIn.mpApproaches.end(); ++it)
 	{
@@ -183,11 +182,10 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 	}
 	if ((pIntersectionGeometry->laneSet.list.array = (GenericLane_t **)calloc(num_lanes, sizeof(GenericLane_t *))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList");
 		return(false);
 	}
 	pIntersectionGeometry->laneSet.list.size = static_cast<int>(num_lanes);
-	branch_level += ".GenericLane";
 	int& laneListCnt = pIntersectionGeometry->laneSet.list.count;
 	// loop through approaches / lanes
 	bool has_error = false;  // for earlier return
@@ -197,7 +195,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 		{
 			if ((pIntersectionGeometry->laneSet.list.array[laneListCnt] = (GenericLane_t *)calloc(1, sizeof(GenericLane_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane");
 				has_error = true;
 				break;
 			}
@@ -234,7 +232,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 			auto& laneDirection = pGenericLane->laneAttributes.directionalUse;
 			if (!ul2bitString(&laneDirection.buf, laneDirection.size, laneDirection.bits_unused, 2, direction_attributes.to_ulong()))
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".LaneAttributes.LaneDirection" << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneDirection");
 				has_error = true;
 				break;
 			}
@@ -242,7 +240,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 			auto& laneSharing = pGenericLane->laneAttributes.sharedWith;
 			if (!ul2bitString(&laneSharing.buf, laneSharing.size, laneSharing.bits_unused, 10, 0))
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".LaneAttributes.LaneSharing" << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneSharing");
 				has_error = true;
 				break;
 			}
@@ -254,7 +252,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 				auto& crosswalk = laneTypeAttributes.choice.crosswalk;
 				if (!ul2bitString(&crosswalk.buf, crosswalk.size, crosswalk.bits_unused, 16, laneStruct.attributes.to_ulong()))
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".LaneAttributes.LaneTypeAttributes.Crosswalk" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneTypeAttributes.Crosswalk");
 					has_error = true;
 					break;
 				}
@@ -265,7 +263,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 				auto& vehicle = laneTypeAttributes.choice.vehicle;
 				if (!ul2bitString(&vehicle.buf, vehicle.size, vehicle.bits_unused, 8, (laneStruct.attributes.to_ulong() & 0xFF)))
 				{
-					std::cerr << prog_name << "allocate " << allocate_level << branch_level << ".LaneAttributes.LaneTypeAttributes.Vehicle" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneTypeAttributes.Vehicle");
 					has_error = true;
 					break;
 				}
@@ -289,8 +287,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 			}
 			if (has_error)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-				std::cerr << ".ApproachID" << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ApproachID");
 				break;
 			}
 			// AllowedManeuvers - 12 bits BIT STRING
@@ -300,7 +297,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 					|| !(ul2bitString(&pGenericLane->maneuvers->buf, pGenericLane->maneuvers->size,
 						pGenericLane->maneuvers->bits_unused, 12, (laneStruct.attributes.to_ulong() >> 8))))
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".AllowedManeuvers" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.AllowedManeuvers");
 					has_error = true;
 					break;
 				}
@@ -311,7 +308,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 				if (((pGenericLane->connectsTo = (ConnectsToList_t *)calloc(1, sizeof(ConnectsToList_t))) == NULL)
 					|| ((pGenericLane->connectsTo->list.array = (Connection_t **)calloc(laneStruct.mpConnectTo.size(), sizeof(Connection_t *))) == NULL))
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ConnectsToList" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList");
 					has_error = true;
 					break;
 				}
@@ -321,7 +318,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 				{
 					if ((pGenericLane->connectsTo->list.array[connListCnt] = (Connection_t *)calloc(1, sizeof(Connection_t))) == NULL)
 					{
-						std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ConnectsToList.Connection" << std::endl;
+						report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection");
 						has_error = true;
 						break;
 					}
@@ -368,8 +365,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 							|| !(ul2bitString(&connLane.maneuver->buf, connLane.maneuver->size,
 								connLane.maneuver->bits_unused, 12, connecting_maneuvers.to_ulong())))
 						{
-							std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-							std::cerr << ".ConnectsToList.Connection.connectingLane.AllowedManeuvers" << std::endl;
+							report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection.connectingLane.AllowedManeuvers");
 							has_error = true;
 							break;
 						}
@@ -380,8 +376,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 						if (((pConnection->remoteIntersection = (IntersectionReferenceID_t *)calloc(1, sizeof(IntersectionReferenceID_t))) == NULL)
 							|| ((pConnection->remoteIntersection->region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL))
 						{
-							std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-							std::cerr << ".ConnectsToList.Connection.IntersectionReferenceID" << std::endl;
+							report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection.IntersectionReferenceID");
 							has_error = true;
 							break;
 						}
@@ -393,8 +388,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 					{
 						if ((pConnection->signalGroup = (SignalGroupID_t *)calloc(1, sizeof(SignalGroupID_t))) == NULL)
 						{
-							std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-							std::cerr << ".ConnectsToList.Connection.signalGroup" << std::endl;
+							report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection.signalGroup");
 							has_error = true;
 							break;
 						}
@@ -409,7 +403,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 			auto& nodeSet = pGenericLane->nodeList.choice.nodes;
 			if ((nodeSet.list.array = (NodeXY_t **)calloc(laneStruct.mpNodes.size(), sizeof(NodeXY_t *))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".NodeListXY" << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY");
 				has_error = true;
 				break;
 			}
@@ -420,7 +414,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 			{
 				if ((nodeSet.list.array[nodeListCnt] = (NodeXY_t *)calloc(1, sizeof(NodeXY_t))) == NULL)
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".NodeListXY.NodeXY" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY");
 					has_error = true;
 					break;
 				}
@@ -484,8 +478,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 					{
 						if ((pNode->attributes = (NodeAttributeSetXY_t *)calloc(1, sizeof(NodeAttributeSetXY_t))) == NULL)
 						{
-							std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-							std::cerr << ".NodeListXY.NodeXY.NodeAttributeSetXY" << std::endl;
+							report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY.NodeAttributeSetXY");
 							has_error = true;
 							break;
 						}
@@ -494,8 +487,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 						{
 							if ((pNode->attributes->dWidth = (Offset_B10_t *)calloc(1, sizeof(Offset_B10_t))) == NULL)
 							{
-								std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-								std::cerr << ".NodeListXY.NodeXY.NodeAttributeSetXY.dWidth" << std::endl;
+								report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY.NodeAttributeSetXY.dWidth");
 								has_error = true;
 								break;
 							}
@@ -509,8 +501,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 								|| ((pNode->attributes->data->list.array = (LaneDataAttribute_t **)calloc(1, sizeof(LaneDataAttribute_t *))) == NULL)
 								|| ((pNode->attributes->data->list.array[0] = (LaneDataAttribute_t *)calloc(1, sizeof(LaneDataAttribute_t))) == NULL))
 							{
-								std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-								std::cerr << ".NodeListXY.NodeXY.NodeAttributeSetXY.LaneDataAttribute" << std::endl;
+								report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY.NodeAttributeSetXY.LaneDataAttribute");
 								has_error = true;
 								break;
 							}
@@ -521,8 +512,7 @@ auto mapData2msgFrame_single = [](const MapData_element_t& mapDataIn, MapData_t&
 							if (((pdata->choice.speedLimits.list.array = (RegulatorySpeedLimit_t **)calloc(1, sizeof(RegulatorySpeedLimit_t *))) == NULL)
 								|| ((pdata->choice.speedLimits.list.array[0] = (RegulatorySpeedLimit_t *)calloc(1, sizeof(RegulatorySpeedLimit_t))) == NULL))
 							{
-								std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-								std::cerr << ".NodeListXY.NodeXY.NodeAttributeSetXY.LaneDataAttribute.RegulatorySpeedLimit" << std::endl;
+								report_codecError(codecError::allocFailed, "mapData2msgFrame_single", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY.NodeAttributeSetXY.LaneDataAttribute.RegulatorySpeedLimit");
 								has_error = true;
 								break;
 							}
@@ -559,28 +549,24 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 	//	RestrictionClassList                EXCL
 	//	RegionalExtension                   EXCL
 	// -------------------------------------------------------- //
-	std::string prog_name = "mapData2msgFrame_multi: ";
-	std::string allocate_level{"MapData"};
 	// msgIssueRevision
 	mapData.msgIssueRevision	= mapDataIn.mapVersion;
 	// LayerType
 	if ((mapData.layerType = (LayerType_t *)calloc(1, sizeof(LayerType_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".LayerType" << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.LayerType");
 		return(false);
 	}
 	*(mapData.layerType) = LayerType_intersectionData;
 	// IntersectionGeometryList - one intersection per MapData, one IntersectionGeometry per distinct speed limit
-	allocate_level += ".IntersectionGeometryList";
 	if (((mapData.intersections = (IntersectionGeometryList_t *)calloc(1, sizeof(IntersectionGeometryList_t))) == NULL)
 		|| ((mapData.intersections->list.array = (IntersectionGeometry_t **)calloc(mapDataIn.speeds.size(), sizeof(IntersectionGeometry_t *))) == NULL))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList");
 		return(false);
 	}
 	mapData.intersections->list.size = static_cast<int>(mapDataIn.speeds.size());
 	// loop through distinct speed limits
-	allocate_level += ".IntersectionGeometry";
 	bool has_error = false;  // for earlier return
 	int& geoListCnt = mapData.intersections->list.count;
 	for (const auto& speed_limit : mapDataIn.speeds)
@@ -600,7 +586,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 		// allocate IntersectionGeometry - one per speed group
 		if ((mapData.intersections->list.array[geoListCnt] = (IntersectionGeometry_t *)calloc(1, sizeof(IntersectionGeometry_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+			report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry");
 			has_error = true;
 			break;
 		}
@@ -627,7 +613,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 		pIntersectionGeometry->id.id = mapDataIn.id;
 		if ((pIntersectionGeometry->id.region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".id.region" << std::endl;
+			report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.id.region");
 			has_error = true;
 			break;
 		}
@@ -641,7 +627,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 		{ // include elevation data
 			if ((pIntersectionGeometry->refPoint.elevation = (DSRC_Elevation_t *)calloc(1, sizeof(DSRC_Elevation_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << ".Position3D.Elevation" << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.Position3D.Elevation");
 				has_error = true;
 				break;
 			}
@@ -650,7 +636,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 		// LaneWidth
 		if ((pIntersectionGeometry->laneWidth = (LaneWidth_t *)calloc(1, sizeof(LaneWidth_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".LaneWidth" << std::endl;
+			report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneWidth");
 			has_error = true;
 			break;
 		}
@@ -662,8 +648,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 				|| ((pIntersectionGeometry->speedLimits->list.array = (RegulatorySpeedLimit_t **)calloc(1, sizeof(RegulatorySpeedLimit_t *))) == NULL)
 				|| ((pIntersectionGeometry->speedLimits->list.array[0] = (RegulatorySpeedLimit_t *)calloc(1, sizeof(RegulatorySpeedLimit_t))) == NULL))
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level;
-				std::cerr << ".SpeedLimitList.RegulatorySpeedLimit" << std::endl;
+				report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.SpeedLimitList.RegulatorySpeedLimit");
 				has_error = true;
 				break;
 			}
@@ -673,15 +658,13 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 			pIntersectionGeometry->speedLimits->list.array[0]->speed = speed_limit;
 		}
 		// LaneList
-		std::string branch_level{".LaneList"};
 		if ((pIntersectionGeometry->laneSet.list.array = (GenericLane_t **)calloc(num_lanes, sizeof(GenericLane_t *))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
+			report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList");
 			has_error = true;
 			break;
 		}
 		pIntersectionGeometry->laneSet.list.size = static_cast<int>(num_lanes);
-		branch_level += ".GenericLane";
 		int& laneListCnt = pIntersectionGeometry->laneSet.list.count;
 		// loop through approaches / lanes
 		for (const auto& i_approach : approachIndex)
@@ -691,7 +674,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 			{
 				if ((pIntersectionGeometry->laneSet.list.array[laneListCnt] = (GenericLane_t *)calloc(1, sizeof(GenericLane_t))) == NULL)
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane");
 					has_error = true;
 					break;
 				}
@@ -728,7 +711,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 				auto& laneDirection = pGenericLane->laneAttributes.directionalUse;
 				if (!ul2bitString(&laneDirection.buf, laneDirection.size, laneDirection.bits_unused, 2, direction_attributes.to_ulong()))
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".LaneAttributes.LaneDirection" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneDirection");
 					has_error = true;
 					break;
 				}
@@ -736,8 +719,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 				auto& laneSharing = pGenericLane->laneAttributes.sharedWith;
 				if (!ul2bitString(&laneSharing.buf, laneSharing.size, laneSharing.bits_unused, 10, 0))
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-					std::cerr << ".LaneAttributes.LaneSharing" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneSharing");
 					has_error = true;
 					break;
 				}
@@ -749,8 +731,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 					auto& crosswalk = laneTypeAttributes.choice.crosswalk;
 					if (!ul2bitString(&crosswalk.buf, crosswalk.size, crosswalk.bits_unused, 16, laneStruct.attributes.to_ulong()))
 					{
-						std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-						std::cerr << ".LaneAttributes.LaneTypeAttributes.Crosswalk" << std::endl;
+						report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneTypeAttributes.Crosswalk");
 						has_error = true;
 						break;
 					}
@@ -761,8 +742,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 					auto& vehicle = laneTypeAttributes.choice.vehicle;
 					if (!ul2bitString(&vehicle.buf, vehicle.size, vehicle.bits_unused, 8, (laneStruct.attributes.to_ulong() & 0xFF)))
 					{
-						std::cerr << prog_name << "allocate " << allocate_level << branch_level;
-						std::cerr << ".LaneAttributes.LaneTypeAttributes.Vehicle" << std::endl;
+						report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.LaneAttributes.LaneTypeAttributes.Vehicle");
 						has_error = true;
 						break;
 					}
@@ -786,7 +766,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 				}
 				if (has_error)
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ApproachID" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ApproachID");
 					break;
 				}
 				// AllowedManeuvers - 12 bits BIT STRING
@@ -796,7 +776,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 						|| !(ul2bitString(&pGenericLane->maneuvers->buf, pGenericLane->maneuvers->size,
 							pGenericLane->maneuvers->bits_unused, 12, (laneStruct.attributes.to_ulong() >> 8))))
 					{
-						std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".AllowedManeuvers" << std::endl;
+						report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.AllowedManeuvers");
 						has_error = true;
 						break;
 					}
@@ -807,7 +787,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 					if (((pGenericLane->connectsTo = (ConnectsToList_t *)calloc(1, sizeof(ConnectsToList_t))) == NULL)
 						|| ((pGenericLane->connectsTo->list.array = (Connection_t **)calloc(laneStruct.mpConnectTo.size(), sizeof(Connection_t *))) == NULL))
 					{
-						std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ConnectsToList" << std::endl;
+						report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList");
 						has_error = true;
 						break;
 					}
@@ -817,7 +797,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 					{
 						if ((pGenericLane->connectsTo->list.array[connListCnt] = (Connection_t *)calloc(1, sizeof(Connection_t))) == NULL)
 						{
-							std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ConnectsToList.Connection" << std::endl;
+							report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection");
 							has_error = true;
 							break;
 						}
@@ -865,8 +845,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 								|| !(ul2bitString(&connLane.maneuver->buf, connLane.maneuver->size,
 									connLane.maneuver->bits_unused, 12, connecting_maneuvers.to_ulong())))
 							{
-								std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-								std::cerr << ".ConnectsToList.Connection.connectingLane.AllowedManeuvers" << std::endl;
+								report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection.connectingLane.AllowedManeuvers");
 								has_error = true;
 								break;
 							}
@@ -877,8 +856,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 							if (((pConnection->remoteIntersection = (IntersectionReferenceID_t *)calloc(1, sizeof(IntersectionReferenceID_t))) == NULL)
 								|| ((pConnection->remoteIntersection->region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL))
 							{
-								std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-								std::cerr << ".ConnectsToList.Connection.IntersectionReferenceID" << std::endl;
+								report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection.IntersectionReferenceID");
 								has_error = true;
 								break;
 							}
@@ -890,8 +868,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 						{
 							if ((pConnection->signalGroup = (SignalGroupID_t *)calloc(1, sizeof(SignalGroupID_t))) == NULL)
 							{
-								std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-								std::cerr << ".ConnectsToList.Connection.signalGroup" << std::endl;
+								report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.ConnectsToList.Connection.signalGroup");
 								has_error = true;
 								break;
 							}
@@ -906,7 +883,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 				auto& nodeSet = pGenericLane->nodeList.choice.nodes;
 				if ((nodeSet.list.array = (NodeXY_t **)calloc(laneStruct.mpNodes.size(), sizeof(NodeXY_t *))) == NULL)
 				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".NodeListXY" << std::endl;
+					report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY");
 					has_error = true;
 					break;
 				}
@@ -918,7 +895,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 					const auto& nodeStruct = laneStruct.mpNodes[i_node];
 					if ((nodeSet.list.array[nodeListCnt] = (NodeXY_t *)calloc(1, sizeof(NodeXY_t))) == NULL)
 					{
-						std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".NodeListXY.NodeXY" << std::endl;
+						report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY");
 						has_error = true;
 						break;
 					}
@@ -978,8 +955,7 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 						if (((pNode->attributes = (NodeAttributeSetXY_t *)calloc(1, sizeof(NodeAttributeSetXY_t))) == NULL)
 							|| ((pNode->attributes->dWidth = (Offset_B10_t *)calloc(1, sizeof(Offset_B10_t))) == NULL))
 						{
-							std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-							std::cerr << ".NodeListXY.NodeXY.NodeAttributeSetXY" << std::endl;
+							report_codecError(codecError::allocFailed, "mapData2msgFrame_multi", "MapData.IntersectionGeometryList.IntersectionGeometry.LaneList.GenericLane.NodeListXY.NodeXY.NodeAttributeSetXY");
 							has_error = true;
 							break;
 						}
@@ -998,8 +974,63 @@ auto mapData2msgFrame_multi = [](const MapData_element_t& mapDataIn, MapData_t&
 	return(!has_error);
 };
 
-/// fill SPAT_t structure
-auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
+/// fill MovementEvent_t structure
+auto movementEvent2msgFrame = [](const MovementEvent_element_t& eventIn, MovementEvent_t* pMovementEvent)->bool
+{	// MovementEvent
+	// -- Required objects ------------------------------------ //
+	//	MovementPhaseState
+	// -- OPTIONAL objects ------------ including/excluding  -- //
+	//	TimeChangeDetails                   OPTIONAL
+	//	AdvisorySpeedList                   EXCL
+	//	RegionalExtension                   EXCL
+	// -------------------------------------------------------- //
+	// MovementPhaseState
+	pMovementEvent->eventState = static_cast<MovementPhaseState_t>(eventIn.currState);
+	// TimeChangeDetails
+	// -- Required objects ------------------------------------ //
+	// 	minEndTime
+	// -- OPTIONAL objects ------------ including/excluding  -- //
+	//	startTime                           OPTIONAL
+	//	maxEndTime                          OPTIONAL
+	//	likelyTime                          EXCL
+	//	confidence (on likelyTime)          EXCL
+	//	nextTime                            EXCL
+	// -------------------------------------------------------- //
+	if (eventIn.minEndTime < MsgEnum::unknown_timeDetail)
+	{
+		if ((pMovementEvent->timing = (TimeChangeDetails *)calloc(1, sizeof(TimeChangeDetails))) == NULL)
+		{
+			report_codecError(codecError::allocFailed, "movementEvent2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList.MovementState.MovementEventList.MovementEvent.TimeChangeDetails");
+			return(false);
+		}
+		// minEndTime
+		pMovementEvent->timing->minEndTime = eventIn.minEndTime;
+		// startTime
+		if (eventIn.startTime < MsgEnum::unknown_timeDetail)
+		{
+			if ((pMovementEvent->timing->startTime = (DSRC_TimeMark_t *)calloc(1, sizeof(DSRC_TimeMark_t))) == NULL)
+			{
+				report_codecError(codecError::allocFailed, "movementEvent2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList.MovementState.MovementEventList.MovementEvent.TimeChangeDetails.startTime");
+				return(false);
+			}
+			*(pMovementEvent->timing->startTime) = eventIn.startTime;
+		}
+		// maxEndTime
+		if (eventIn.maxEndTime < MsgEnum::unknown_timeDetail)
+		{
+			if ((pMovementEvent->timing->maxEndTime = (DSRC_TimeMark_t *)calloc(1, sizeof(DSRC_TimeMark_t))) == NULL)
+			{
+				report_codecError(codecError::allocFailed, "movementEvent2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList.MovementState.MovementEventList.MovementEvent.TimeChangeDetails.maxEndTime");
+				return(false);
+			}
+			*(pMovementEvent->timing->maxEndTime) = eventIn.maxEndTime;
+		}
+	}
+	return(true);
+};
+
+/// fill IntersectionState_t structure
+auto intersectionState2msgFrame = [](const IntersectionState_element_t& spatIn, IntersectionState_t* pIntsectionState)->bool
 { // get array of signalGroupID for permitted vehicular and pedestrian phases
 	std::vector<int> signalGroupArray;
 	for (uint8_t i = 0; i < 8; i++)
@@ -1014,26 +1045,6 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 	}
 	if (signalGroupArray.empty())
 		return(false);   // nothing to encode
-	// SPAT:
-	// -- Required objects ------------------------------------ //
-	//	IntersectionStateList
-	// -- OPTIONAL objects ------------ including/excluding  -- //
-	//	MinuteOfTheYear                     EXCL
-	//	DescriptiveName                     EXCL
-	//	RegionalExtension                   EXCL
-	// -------------------------------------------------------- //
-	// IntersectionStateList - one intersection per SPAT
-	std::string prog_name = "spat2msgFrame: ";
-	std::string allocate_level{"SPAT.IntersectionStateList.IntersectionState"};
-	if (((spat.intersections.list.array = (IntersectionState_t **)calloc(1, sizeof(IntersectionState_t *))) == NULL)
-		|| ((spat.intersections.list.array[0] = (IntersectionState_t *)calloc(1, sizeof(IntersectionState_t))) == NULL))
-	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
-		return(false);
-	}
-	spat.intersections.list.size  = 1;
-	spat.intersections.list.count = 1;
-	IntersectionState_t* pIntsectionState = spat.intersections.list.array[0];
 	// IntersectionStateList::IntersectionState
 	// -- Required objects ------------------------------------ //
 	//	IntersectionReferenceID
@@ -1057,7 +1068,7 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 	pIntsectionState->id.id = spatIn.id;
 	if ((pIntsectionState->id.region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".id.region" << std::endl;
+		report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.id.region");
 		return(false);
 	}
 	*(pIntsectionState->id.region) = spatIn.regionalId;
@@ -1067,7 +1078,7 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 	if (!ul2bitString(&pIntsectionState->status.buf, pIntsectionState->status.size,
 		pIntsectionState->status.bits_unused, 16, spatIn.status.to_ulong()))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".IntersectionStatusObject" << std::endl;
+		report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.IntersectionStatusObject");
 		return(false);
 	}
 	// TimeStamp
@@ -1075,7 +1086,7 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 	{
 		if ((pIntsectionState->moy = (MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".MinuteOfTheYear" << std::endl;
+			report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MinuteOfTheYear");
 			return(false);
 		}
 		*(pIntsectionState->moy) = spatIn.timeStampMinute;
@@ -1084,22 +1095,20 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 	{
 		if ((pIntsectionState->timeStamp = (DSecond_t *)calloc(1, sizeof(DSecond_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".timeStamp" << std::endl;
+			report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.timeStamp");
 			return(false);
 		}
 		*(pIntsectionState->timeStamp) = spatIn.timeStampSec;
 	}
-	// MovementList
-	allocate_level += ".MovementList"; // one MovementState per vehicular/pedestrian signal group
+	// MovementList - one MovementState per vehicular/pedestrian signal group
 	if ((pIntsectionState->states.list.array =
 		(MovementState_t **)calloc(signalGroupArray.size(), sizeof(MovementState_t *))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList");
 		return(false);
 	}
 	pIntsectionState->states.list.size  = static_cast<int>(signalGroupArray.size());
 	// loop through permitted movements
-	allocate_level += ".MovementState";
 	bool has_error = false;  // for earlier return
 	int& stateListCnt = pIntsectionState->states.list.count;
 	for (const auto& signal_group : signalGroupArray)
@@ -1109,7 +1118,7 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 		// allocate MovementState object
 		if ((pIntsectionState->states.list.array[stateListCnt] = (MovementState_t *)calloc(1, sizeof(MovementState_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+			report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList.MovementState");
 			has_error = true;
 			break;
 		}
@@ -1125,76 +1134,69 @@ auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
 		// -------------------------------------------------------- //
 		// SignalGroupID
 		pMovementState->signalGroup = signal_group + 1;
-		// MovementEventList - one MovementEvent per movement
-		std::string branch_level(".MovementEventList.MovementEvent");
-		if (((pMovementState->state_time_speed.list.array = (MovementEvent_t **)calloc(1, sizeof(MovementEvent_t *))) == NULL)
-			|| ((pMovementState->state_time_speed.list.array[0] = (MovementEvent_t *)calloc(1, sizeof(MovementEvent_t))) == NULL))
+		// MovementEventList - the current MovementEvent and the predicted ones that follow
+		size_t numEvents = spatIn.numEvents(phaseState);
+		if ((pMovementState->state_time_speed.list.array = (MovementEvent_t **)calloc(numEvents, sizeof(MovementEvent_t *))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
+			report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList.MovementState.MovementEventList");
 			has_error = true;
 			break;
 		}
-		pMovementState->state_time_speed.list.size  = 1;
-		pMovementState->state_time_speed.list.count = 1;
-		MovementEvent_t* pMovementEvent = pMovementState->state_time_speed.list.array[0];
-		// MovementEvent
-		// -- Required objects ------------------------------------ //
-		//	MovementPhaseState
-		// -- OPTIONAL objects ------------ including/excluding  -- //
-		//	TimeChangeDetails                   OPTIONAL
-		//	AdvisorySpeedList                   EXCL
-		//	RegionalExtension                   EXCL
-		// -------------------------------------------------------- //
-		// MovementPhaseState
-		pMovementEvent->eventState = static_cast<MovementPhaseState_t>(phaseState.currState);
-		branch_level += ".TimeChangeDetails";
-		// TimeChangeDetails
-		// -- Required objects ------------------------------------ //
-		// 	minEndTime
-		// -- OPTIONAL objects ------------ including/excluding  -- //
-		//	startTime                           OPTIONAL
-		//	maxEndTime                          OPTIONAL
-		//	likelyTime                          EXCL
-		//	confidence (on likelyTime)          EXCL
-		//	nextTime                            EXCL
-		// -------------------------------------------------------- //
-		if (phaseState.minEndTime < MsgEnum::unknown_timeDetail)
+		pMovementState->state_time_speed.list.size  = static_cast<int>(numEvents);
+		int& eventListCnt = pMovementState->state_time_speed.list.count;
+		for (size_t k = 0; k < numEvents; k++)
 		{
-			if ((pMovementEvent->timing = (TimeChangeDetails *)calloc(1, sizeof(TimeChangeDetails))) == NULL)
+			if ((pMovementState->state_time_speed.list.array[eventListCnt] = (MovementEvent_t *)calloc(1, sizeof(MovementEvent_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
+				report_codecError(codecError::allocFailed, "intersectionState2msgFrame", "SPAT.IntersectionStateList.IntersectionState.MovementList.MovementState.MovementEventList.MovementEvent");
 				has_error = true;
 				break;
 			}
-			// minEndTime
-			pMovementEvent->timing->minEndTime = phaseState.minEndTime;
-			// startTime
-			if (phaseState.startTime < MsgEnum::unknown_timeDetail)
+			if (!movementEvent2msgFrame(spatIn.event(phaseState, k), pMovementState->state_time_speed.list.array[eventListCnt++]))
 			{
-				if ((pMovementEvent->timing->startTime = (DSRC_TimeMark_t *)calloc(1, sizeof(DSRC_TimeMark_t))) == NULL)
-				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".startTime" << std::endl;
-					has_error = true;
-					break;
-				}
-				*(pMovementEvent->timing->startTime) = phaseState.startTime;
-			}
-			// maxEndTime
-			if (phaseState.maxEndTime < MsgEnum::unknown_timeDetail)
-			{
-				if ((pMovementEvent->timing->maxEndTime = (DSRC_TimeMark_t *)calloc(1, sizeof(DSRC_TimeMark_t))) == NULL)
-				{
-					std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".maxEndTime" << std::endl;
-					has_error = true;
-					break;
-				}
-				*(pMovementEvent->timing->maxEndTime) = phaseState.maxEndTime;
+				has_error = true;
+				break;
 			}
 		}
+		if (has_error)
+			break;
 	}
 	return(!has_error);
 };
 
+/// fill SPAT_t structure
+auto spat2msgFrame = [](const SPAT_element_t& spatIn, SPAT_t& spat)->bool
+{
+	// SPAT:
+	// -- Required objects ------------------------------------ //
+	//	IntersectionStateList
+	// -- OPTIONAL objects ------------ including/excluding  -- //
+	//	MinuteOfTheYear                     EXCL
+	//	DescriptiveName                     EXCL
+	//	RegionalExtension                   EXCL
+	// -------------------------------------------------------- //
+	// IntersectionStateList - one IntersectionState per intersection
+	size_t numIntersections = spatIn.numIntersections();
+	if ((spat.intersections.list.array = (IntersectionState_t **)calloc(numIntersections, sizeof(IntersectionState_t *))) == NULL)
+	{
+		report_codecError(codecError::allocFailed, "spat2msgFrame", "SPAT.IntersectionStateList");
+		return(false);
+	}
+	spat.intersections.list.size  = static_cast<int>(numIntersections);
+	int& stateListCnt = spat.intersections.list.count;
+	for (size_t i = 0; i < numIntersections; i++)
+	{
+		if ((spat.intersections.list.array[stateListCnt] = (IntersectionState_t *)calloc(1, sizeof(IntersectionState_t))) == NULL)
+		{
+			report_codecError(codecError::allocFailed, "spat2msgFrame", "SPAT.IntersectionStateList.IntersectionState");
+			return(false);
+		}
+		if (!intersectionState2msgFrame(spatIn.intersection(i), spat.intersections.list.array[stateListCnt++]))
+			return(false);
+	}
+	return(true);
+};
+
 /// fill BasicSafetyMessage_t structure
 auto bsm2msgFrame = [](const BSM_element_t& bsmIn, BasicSafetyMessage_t& bsm)->bool
 {	// BSM:
@@ -1204,14 +1206,12 @@ auto bsm2msgFrame = [](const BSM_element_t& bsmIn, BasicSafetyMessage_t& bsm)->b
 	//	partII                              EXCL
 	//	RegionalExtension                   EXCL
 	// -------------------------------------------------------- //
-	std::string prog_name{"bsm2msgFrame: "};
-	std::string allocate_level{"BSM.BSMcoreData"};
 	auto& coreData = bsm.coreData;
 	coreData.msgCnt = bsmIn.msgCnt;
 	// TemporaryID
 	if (!id2temporaryId(&coreData.id.buf, coreData.id.size, bsmIn.id))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".TemporaryID" << std::endl;
+		report_codecError(codecError::allocFailed, "bsm2msgFrame", "BSM.BSMcoreData.TemporaryID");
 		return(false);
 	}
 	coreData.secMark = bsmIn.timeStampSec;
@@ -1231,12 +1231,11 @@ auto bsm2msgFrame = [](const BSM_element_t& bsmIn, BasicSafetyMessage_t& bsm)->b
 	coreData.accelSet.yaw = bsmIn.yawRate;
 	coreData.size.width = bsmIn.vehWidth;
 	coreData.size.length = bsmIn.vehLen;
-	allocate_level += ".BrakeSystemStatus";
 	auto& brakeSystemStatus = coreData.brakes;
 	auto& wheelBrakes = brakeSystemStatus.wheelBrakes;  // SIZE (5) BIT STRING
 	if (!ul2bitString(&wheelBrakes.buf, wheelBrakes.size, wheelBrakes.bits_unused, 5, bsmIn.brakeAppliedStatus.to_ulong()))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".BrakeAppliedStatus" << std::endl;
+		report_codecError(codecError::allocFailed, "bsm2msgFrame", "BSM.BSMcoreData.BrakeSystemStatus.BrakeAppliedStatus");
 		return(false);
 	}
 	brakeSystemStatus.traction = static_cast<TractionControlStatus_t>(bsmIn.tractionControlStatus);
@@ -1263,8 +1262,6 @@ auto rtcm2msgFrame = [](const RTCM_element_t& rtcmIn, RTCMcorrections_t& rtcm)->
 	//	RTCMheader                          EXCL
 	//	RegionalExtension                   EXCL
 	// -------------------------------------------------------- //
-	std::string prog_name{"rtcm2msgFrame: "};
-	std::string allocate_level{"RTCM"};
 	rtcm.msgCnt = rtcmIn.msgCnt;
 	rtcm.rev = rtcmIn.rev;
 	// MinuteOfTheYear
@@ -1272,17 +1269,16 @@ auto rtcm2msgFrame = [](const RTCM_element_t& rtcmIn, RTCMcorrections_t& rtcm)->
 	{
 		if ((rtcm.timeStamp = (MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".MinuteOfTheYear" << std::endl;
+			report_codecError(codecError::allocFailed, "rtcm2msgFrame", "RTCM.MinuteOfTheYear");
 			return(false);
 		}
 		*(rtcm.timeStamp) = rtcmIn.timeStampMinute;
 	}
 	// RTCMmessageList - one payload per RTCM
-	allocate_level += ".RTCMmessageList.RTCMmessage";
 	if (((rtcm.msgs.list.array = (RTCMmessage_t **)calloc(1, sizeof(RTCMmessage_t *))) == NULL)
 		|| ((rtcm.msgs.list.array[0] = (RTCMmessage_t *)calloc(1, sizeof(RTCMmessage_t))) == NULL))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "rtcm2msgFrame", "RTCM.RTCMmessageList.RTCMmessage");
 		return(false);
 	}
 	rtcm.msgs.list.size  = 1;
@@ -1290,66 +1286,20 @@ auto rtcm2msgFrame = [](const RTCM_element_t& rtcmIn, RTCMcorrections_t& rtcm)->
 	RTCMmessage_t* pRTCMmessage = rtcm.msgs.list.array[0];
 	if (OCTET_STRING_fromBuf(pRTCMmessage, reinterpret_cast<const char*>(&rtcmIn.payload[0]), (int)rtcmIn.payload.size()) < 0)
 	{
-		std::cerr << prog_name << "failed OCTET_STRING_fromBuf " << std::endl;
+		report_codecError(codecError::allocFailed, "rtcm2msgFrame", "OCTET_STRING_fromBuf");
 		return(false);
 	}
 	return(true);
 };
 
-/// fill SignalRequestMessage_t structure
-auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)->bool
+/// fill SignalRequestPackage_t structure
+auto signalRequestPackage2msgFrame = [](const SignalRequest_element_t& srmIn, SignalRequestPackage_t* pSignalRequestPackage)->bool
 {
-	std::string prog_name{"srm2msgFrame: "};
 	if ((srmIn.inApprochId == 0) && (srmIn.inLaneId == 0))
 	{
-		std::cerr << prog_name << "either entry approachID or laneID shall be specified" << std::endl;
+		report_codecError(codecError::invalidValue, "signalRequestPackage2msgFrame", "either entry approachID or laneID shall be specified");
 		return(false);
 	}
-	// SRM:
-	// -- Required objects ------------------------------------ //
-	//	DSecond
-	//	RequestorDescription
-	// -- OPTIONAL objects ------------ including/excluding  -- //
-	//	MinuteOfTheYear                     OPTIONAL
-	//	MsgCount                            OPTIONAL
-	//	SignalRequestList                   INCL
-	//	RegionalExtension                   EXCL
-	// -------------------------------------------------------- //
-	std::string allocate_level{"SRM"};
-	// DSecond
-	srm.second = srmIn.timeStampSec;
-	// MinuteOfTheYear
-	if (srmIn.timeStampMinute < MsgEnum::invalid_timeStampMinute)
-	{
-		if ((srm.timeStamp = (MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
-		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".MinuteOfTheYear" << std::endl;
-			return(false);
-		}
-		*(srm.timeStamp) = srmIn.timeStampMinute;
-	}
-	// MsgCount
-	if (srmIn.msgCnt < 0xFF)
-	{
-		if ((srm.sequenceNumber = (DSRC_MsgCount_t *)calloc(1, sizeof(DSRC_MsgCount_t))) == NULL)
-		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".MsgCount" << std::endl;
-			return(false);
-		}
-		*(srm.sequenceNumber) = srmIn.msgCnt;
-	}
-	// SignalRequestList - request for one intersection
-	std::string branch_level(".SignalRequestList.SignalRequestPackage");
-	if (((srm.requests = (SignalRequestList_t *)calloc(1, sizeof(SignalRequestList_t))) == NULL)
-		|| ((srm.requests->list.array = (SignalRequestPackage_t **)calloc(1, sizeof(SignalRequestPackage_t *))) == NULL)
-		|| ((srm.requests->list.array[0] = (SignalRequestPackage_t *)calloc(1, sizeof(SignalRequestPackage_t))) == NULL))
-	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << std::endl;
-		return(false);
-	}
-	srm.requests->list.size = 1;
-	srm.requests->list.count = 1;
-	SignalRequestPackage_t* pSignalRequestPackage = srm.requests->list.array[0];
 	// SignalRequestPackage
 	// -- Required objects ------------------------------------ //
 	//	SignalRequest
@@ -1364,7 +1314,7 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	{
 		if ((pSignalRequestPackage->minute = (MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ETAminute" << std::endl;
+			report_codecError(codecError::allocFailed, "signalRequestPackage2msgFrame", "SRM.SignalRequestList.SignalRequestPackage.ETAminute");
 			return(false);
 		}
 		*(pSignalRequestPackage->minute) = srmIn.ETAminute;
@@ -1373,7 +1323,7 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	{
 		if ((pSignalRequestPackage->second = (DSecond_t *)calloc(1, sizeof(DSecond_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".ETAsec" << std::endl;
+			report_codecError(codecError::allocFailed, "signalRequestPackage2msgFrame", "SRM.SignalRequestList.SignalRequestPackage.ETAsec");
 			return(false);
 		}
 		*(pSignalRequestPackage->second) = srmIn.ETAsec;
@@ -1383,7 +1333,7 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	{
 		if ((pSignalRequestPackage->duration = (DSecond_t *)calloc(1, sizeof(DSecond_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << branch_level << ".duration" << std::endl;
+			report_codecError(codecError::allocFailed, "signalRequestPackage2msgFrame", "SRM.SignalRequestList.SignalRequestPackage.duration");
 			return(false);
 		}
 		*(pSignalRequestPackage->duration) = srmIn.duration;
@@ -1408,8 +1358,7 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	signalRequest.id.id = srmIn.intId;
 	if ((signalRequest.id.region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-		std::cerr << ".SignalRequest.SignalRequest.id.region" << std::endl;
+		report_codecError(codecError::allocFailed, "signalRequestPackage2msgFrame", "SRM.SignalRequestList.SignalRequestPackage.SignalRequest.SignalRequest.id.region");
 		return(false);
 	}
 	*(signalRequest.id.region) = srmIn.regionalId;
@@ -1433,8 +1382,7 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	{
 		if ((signalRequest.outBoundLane = (IntersectionAccessPoint_t *)calloc(1, sizeof(IntersectionAccessPoint_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << branch_level;
-			std::cerr << ".SignalRequest.outBoundLane" << std::endl;
+			report_codecError(codecError::allocFailed, "signalRequestPackage2msgFrame", "SRM.SignalRequestList.SignalRequestPackage.SignalRequest.outBoundLane");
 			return(false);
 		}
 		if (srmIn.outLaneId == 0)
@@ -1448,8 +1396,65 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 			signalRequest.outBoundLane->choice.lane = srmIn.outLaneId;
 		}
 	}
+	return(true);
+};
+
+/// fill SignalRequestMessage_t structure
+auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)->bool
+{
+	// SRM:
+	// -- Required objects ------------------------------------ //
+	//	DSecond
+	//	RequestorDescription
+	// -- OPTIONAL objects ------------ including/excluding  -- //
+	//	MinuteOfTheYear                     OPTIONAL
+	//	MsgCount                            OPTIONAL
+	//	SignalRequestList                   INCL
+	//	RegionalExtension                   EXCL
+	// -------------------------------------------------------- //
+	// DSecond
+	srm.second = srmIn.timeStampSec;
+	// MinuteOfTheYear
+	if (srmIn.timeStampMinute < MsgEnum::invalid_timeStampMinute)
+	{
+		if ((srm.timeStamp = (MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
+		{
+			report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.MinuteOfTheYear");
+			return(false);
+		}
+		*(srm.timeStamp) = srmIn.timeStampMinute;
+	}
+	// MsgCount
+	if (srmIn.msgCnt < 0xFF)
+	{
+		if ((srm.sequenceNumber = (DSRC_MsgCount_t *)calloc(1, sizeof(DSRC_MsgCount_t))) == NULL)
+		{
+			report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.MsgCount");
+			return(false);
+		}
+		*(srm.sequenceNumber) = srmIn.msgCnt;
+	}
+	// SignalRequestList - one SignalRequestPackage per intersection
+	size_t numRequests = srmIn.numRequests();
+	if (((srm.requests = (SignalRequestList_t *)calloc(1, sizeof(SignalRequestList_t))) == NULL)
+		|| ((srm.requests->list.array = (SignalRequestPackage_t **)calloc(numRequests, sizeof(SignalRequestPackage_t *))) == NULL))
+	{
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.SignalRequestList");
+		return(false);
+	}
+	srm.requests->list.size = static_cast<int>(numRequests);
+	int& requestListCnt = srm.requests->list.count;
+	for (size_t i = 0; i < numRequests; i++)
+	{
+		if ((srm.requests->list.array[requestListCnt] = (SignalRequestPackage_t *)calloc(1, sizeof(SignalRequestPackage_t))) == NULL)
+		{
+			report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.SignalRequestList.SignalRequestPackage");
+			return(false);
+		}
+		if (!signalRequestPackage2msgFrame(srmIn.request(i), srm.requests->list.array[requestListCnt++]))
+			return(false);
+	}
 	// RequestorDescription
-	allocate_level += ".RequestorDescription";
 	auto& requestor = srm.requestor;
 	// RequestorDescription
 	// -- Required objects ------------------------------------ //
@@ -1468,13 +1473,13 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	requestor.id.present = VehicleID_PR_entityID;
 	if (!id2temporaryId(&requestor.id.choice.entityID.buf, requestor.id.choice.entityID.size, srmIn.vehId))
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".VehicleID" << std::endl;
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.VehicleID");
 		return(false);
 	}
 	// RequestorType
 	if ((requestor.type = (RequestorType_t *)calloc(1, sizeof(RequestorType_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".RequestorType" << std::endl;
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.RequestorType");
 		return(false);
 	}
 	// RequestorType
@@ -1492,14 +1497,14 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	// VehicleType
 	if ((requestor.type->hpmsType = (VehicleType_t *)calloc(1, sizeof(VehicleType_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".RequestorType.VehicleType" << std::endl;
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.RequestorType.VehicleType");
 		return(false);
 	}
 	*(requestor.type->hpmsType) = static_cast<VehicleType_t>(srmIn.vehType);
 	// RequestorPositionVector
 	if ((requestor.position = (RequestorPositionVector_t *)calloc(1, sizeof(RequestorPositionVector_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".RequestorPositionVector" << std::endl;
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.RequestorPositionVector");
 		return(false);
 	}
 	// RequestorPositionVector
@@ -1516,8 +1521,7 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	{
 		if ((requestor.position->position.elevation = (DSRC_Elevation_t *)calloc(1, sizeof(DSRC_Elevation_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level;
-			std::cerr	<< ".RequestorPositionVector.Position3D.elevation" << std::endl;
+			report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.RequestorPositionVector.Position3D.elevation");
 			return(false);
 		}
 		*(requestor.position->position.elevation) = srmIn.elevation;
@@ -1525,16 +1529,14 @@ auto srm2msgFrame = [](const SRM_element_t& srmIn, SignalRequestMessage_t& srm)-
 	// heading
 	if ((requestor.position->heading = (DSRC_Angle_t *)calloc(1, sizeof(DSRC_Angle_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level;
-		std::cerr	<< ".RequestorPositionVector.heading" << std::endl;
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.RequestorPositionVector.heading");
 		return(false);
 	}
 	*(requestor.position->heading) = srmIn.heading;
 	// speed
 	if ((requestor.position->speed = (TransmissionAndSpeed_t *)calloc(1, sizeof(TransmissionAndSpeed_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level;
-		std::cerr << ".RequestorPositionVector.speed" << std::endl;
+		report_codecError(codecError::allocFailed, "srm2msgFrame", "SRM.RequestorDescription.RequestorPositionVector.speed");
 		return(false);
 	}
 	requestor.position->speed->transmisson = static_cast<TransmissionState_t>(srmIn.transState);
@@ -1556,8 +1558,6 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 	//	MsgCount                            OPTIONAL
 	//	RegionalExtension                   EXCL
 	// -------------------------------------------------------- //
-	std::string prog_name{"ssm2msgFrame :"};
-	std::string allocate_level{"SSM"};
 	// DSecond
 	ssm.second = ssmIn.timeStampSec;
 	// MinuteOfTheYear
@@ -1565,7 +1565,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 	{
 		if ((ssm.timeStamp = (MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".MinuteOfTheYear" << std::endl;
+			report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.MinuteOfTheYear");
 			return(false);
 		}
 		*(ssm.timeStamp) = ssmIn.timeStampMinute;
@@ -1575,23 +1575,21 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 	{
 		if ((ssm.sequenceNumber = (DSRC_MsgCount_t *)calloc(1, sizeof(DSRC_MsgCount_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".MsgCount" << std::endl;
+			report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.MsgCount");
 			return(false);
 		}
 		*(ssm.sequenceNumber) = ssmIn.msgCnt;
 	}
 	// SignalStatusList - one intersection per SSM
-	allocate_level += ".SignalStatusList";
 	if ((ssm.status.list.array = (SignalStatus_t **)calloc(1, sizeof(SignalStatus_t *))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList");
 		return(false);
 	}
 	ssm.status.list.size  = 1;
-	allocate_level += ".SignalStatus";
 	if ((ssm.status.list.array[0] = (SignalStatus_t *)calloc(1, sizeof(SignalStatus_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus");
 		return(false);
 	}
 	ssm.status.list.count = 1;
@@ -1616,28 +1614,26 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 	pSignalStatus->id.id = ssmIn.id;
 	if ((pSignalStatus->id.region = (RoadRegulatorID_t *)calloc(1, sizeof(RoadRegulatorID_t))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << ".id.region" << std::endl;
+		report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.id.region");
 		return(false);
 	}
 	*(pSignalStatus->id.region) = ssmIn.regionalId;
 	// SignalStatusPackageList
-	allocate_level += ".SignalStatusPackageList";
 	if ((pSignalStatus->sigStatus.list.array = (SignalStatusPackage_t **)calloc(ssmIn.mpSignalRequetStatus.size(), sizeof(SignalStatusPackage_t *))) == NULL)
 	{
-		std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+		report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList");
 		return(false);
 	}
 	pSignalStatus->sigStatus.list.size = static_cast<int>(ssmIn.mpSignalRequetStatus.size());
 
 	// loop through the list of priority/preemption requests
-	allocate_level += ".SignalStatusPackage";
 	bool has_error = false;  // for earlier return
 	int& statusListCnt = pSignalStatus->sigStatus.list.count;
 	for (const auto& signalRequetStatus : ssmIn.mpSignalRequetStatus)
 	{
 		if ((pSignalStatus->sigStatus.list.array[statusListCnt] = (SignalStatusPackage_t *)calloc(1, sizeof(SignalStatusPackage_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << std::endl;
+			report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage");
 			has_error = true;
 			break;
 		}
@@ -1660,7 +1656,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		// inboundOn
 		if ((signalRequetStatus.inApprochId == 0) && (signalRequetStatus.inLaneId == 0))
 		{
-			std::cerr << prog_name << "either entry approach or lane needs to be specified" << std::endl;
+			report_codecError(codecError::invalidValue, "ssm2msgFrame", "either entry approach or lane needs to be specified");
 			has_error = true;
 			break;
 		}
@@ -1679,7 +1675,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		{
 			if ((pSignalStatusPackage->outboundOn = (IntersectionAccessPoint_t *)calloc(1, sizeof(IntersectionAccessPoint_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << ".outboundOn" << std::endl;
+				report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.outboundOn");
 				has_error = true;
 				break;
 			}
@@ -1699,7 +1695,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		{
 			if ((pSignalStatusPackage->minute =	(MinuteOfTheYear_t *)calloc(1, sizeof(MinuteOfTheYear_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << ".ETAminute" << std::endl;
+				report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.ETAminute");
 				has_error = true;
 				break;
 			}
@@ -1709,7 +1705,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		{
 			if ((pSignalStatusPackage->second = (DSecond_t *)calloc(1, sizeof(DSecond_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << ".ETAsec" << std::endl;
+				report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.ETAsec");
 				has_error = true;
 				break;
 			}
@@ -1720,7 +1716,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		{
 			if ((pSignalStatusPackage->duration = (DSecond_t *)calloc(1, sizeof(DSecond_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << ".duration" << std::endl;
+				report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.duration");
 				has_error = true;
 				break;
 			}
@@ -1729,7 +1725,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		// SignalRequesterInfo
 		if ((pSignalStatusPackage->requester = (SignalRequesterInfo_t *)calloc(1, sizeof(SignalRequesterInfo_t))) == NULL)
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".SignalRequesterInfo" << std::endl;
+			report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.SignalRequesterInfo");
 			has_error = true;
 			break;
 		}
@@ -1748,7 +1744,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		pSignalRequesterInfo->id.present = VehicleID_PR_entityID;
 		if (!id2temporaryId(&(pSignalRequesterInfo->id.choice.entityID.buf), pSignalRequesterInfo->id.choice.entityID.size, signalRequetStatus.vehId))
 		{
-			std::cerr << prog_name << "failed allocate " << allocate_level << ".SignalRequesterInfo.VehicleID" << std::endl;
+			report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.SignalRequesterInfo.VehicleID");
 			has_error = true;
 			break;
 		}
@@ -1761,7 +1757,7 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 		{
 			if ((pSignalRequesterInfo->role = (BasicVehicleRole_t *)calloc(1, sizeof(BasicVehicleRole_t))) == NULL)
 			{
-				std::cerr << prog_name << "failed allocate " << allocate_level << ".SignalRequesterInfo.BasicVehicleRole" << std::endl;
+				report_codecError(codecError::allocFailed, "ssm2msgFrame", "SSM.SignalStatusList.SignalStatus.SignalStatusPackageList.SignalStatusPackage.SignalRequesterInfo.BasicVehicleRole");
 				has_error = true;
 				break;
 			}
@@ -1774,7 +1770,6 @@ auto ssm2msgFrame = [](const SSM_element_t& ssmIn, SignalStatusMessage_t& ssm)
 /// convert MapData_t, which specifies speed limit at lane/node level, to MapData_element_t
 auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& mapDataOut)->bool
 {
-	std::string prog_name{"msgFrame2mapData_single: "};
 	const IntersectionGeometry_t* pIntersectionGeometry = mapData.intersections->list.array[0];
 	mapDataOut.id = static_cast<uint16_t>(pIntersectionGeometry->id.id);
 	mapDataOut.regionalId = (pIntersectionGeometry->id.region != NULL) ? static_cast<uint16_t>(*(pIntersectionGeometry->id.region)) : 0;
@@ -1794,7 +1789,7 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 	// LaneWidth
 	if (pIntersectionGeometry->laneWidth == NULL)
 	{
-		std::cerr << prog_name << "missing LaneWidth" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2mapData_single", "missing LaneWidth");
 		mapDataOut.reset();
 		return(false);
 	}
@@ -1808,7 +1803,7 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 	// LaneList
 	if (pIntersectionGeometry->laneSet.list.count == 0)
 	{
-		std::cerr << prog_name << "missing LaneList" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2mapData_single", "missing LaneList");
 		mapDataOut.reset();
 		return(false);
 	}
@@ -1821,16 +1816,14 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 		uint8_t directionalUse = static_cast<uint8_t>(bitString2ul(laneDirection.buf, laneDirection.size, laneDirection.bits_unused));
 		if ((directionalUse < 0x01) || (directionalUse > 0x03))
 		{
-			std::cerr << prog_name << "laneId=" << pGenericLane->laneID;
-			std::cerr << ", unknown directionalUse=" << static_cast<unsigned int>(directionalUse);
-			std::cerr << ", bitString size=" << laneDirection.size;
-			std::cerr << ", bits_unused=" << laneDirection.bits_unused << std::endl;
+			report_codecError(codecError::invalidValue, "msgFrame2mapData_single", "laneId, unknown directionalUse, bitString size, bits_unused",
+				{pGenericLane->laneID, directionalUse, static_cast<int64_t>(laneDirection.size), laneDirection.bits_unused});
 			has_error = true;
 			break;
 		}
 		if ((pGenericLane->ingressApproach == NULL) && (pGenericLane->egressApproach == NULL))
 		{
-			std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing ApproachID" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2mapData_single", "laneId, missing ApproachID", {pGenericLane->laneID});
 			has_error = true;
 			break;
 		}
@@ -1838,7 +1831,7 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 			&& ((pGenericLane->connectsTo == NULL) || (pGenericLane->connectsTo->list.count == 0)
 				|| (pGenericLane->connectsTo->list.array[0]->signalGroup == NULL)))
 		{ // required to provide signal phase that controls the movement
-			std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing ConnectsTo" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2mapData_single", "laneId, missing ConnectsTo", {pGenericLane->laneID});
 			has_error = true;
 			break;
 		}
@@ -1847,7 +1840,7 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 			|| (pGenericLane->nodeList.choice.nodes.list.count < 2)
 			|| (pGenericLane->nodeList.choice.nodes.list.count > 63))
 		{
-			std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing NodeListXY" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2mapData_single", "laneId, missing NodeListXY", {pGenericLane->laneID});
 			has_error = true;
 			break;
 		}
@@ -1855,8 +1848,8 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 			(*(pGenericLane->ingressApproach)) : (*(pGenericLane->egressApproach)));
 		if ((approachId == 0) || (approachId > 15))
 		{
-			std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", out-of-bound approachId ";
-			std::cerr	<< static_cast<unsigned int>(approachId) << std::endl;
+			report_codecError(codecError::invalidValue, "msgFrame2mapData_single", "laneId, out-of-bound approachId",
+				{pGenericLane->laneID, approachId});
 			has_error = true;
 			break;
 		}
@@ -1890,7 +1883,7 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 		if (directionalUse != 0x03)
 		{ // not crosswalk
 			if (pGenericLane->maneuvers == NULL)
-				std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing AllowedManeuvers" << std::endl;
+				report_codecError(codecError::missingElement, "msgFrame2mapData_single", "laneId, missing AllowedManeuvers", {pGenericLane->laneID});
 			else
 				allowedManeuvers = bitString2ul(pGenericLane->maneuvers->buf, pGenericLane->maneuvers->size, pGenericLane->maneuvers->bits_unused);
 		}
@@ -1901,7 +1894,13 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 		// loop through connecting lanes
 		if ((pGenericLane->connectsTo != NULL) && (pGenericLane->connectsTo->list.count > 0))
 		{
-			laneStruct.mpConnectTo.resize(pGenericLane->connectsTo->list.count);
+			if (!laneStruct.mpConnectTo.resize(pGenericLane->connectsTo->list.count))
+			{
+				report_codecError(codecError::invalidValue, "msgFrame2mapData_single", "laneId, ConnectsToList over maxConnectsTo",
+					{pGenericLane->laneID, pGenericLane->connectsTo->list.count});
+				has_error = true;
+				break;
+			}
 			for (int k = 0; k < pGenericLane->connectsTo->list.count; k++)
 			{ // assign ConnectStruct variables
 				const Connection_t* pConnection = pGenericLane->connectsTo->list.array[k];
@@ -2004,8 +2003,13 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 		laneStruct.width = refLaneWidth;
 		if ((directionalUse != 0x03) && (appStruct.speed_limit != refSpeedLimt))
 			appStruct.speed_limit = refSpeedLimt;
-		if (std::find(mapDataOut.speeds.begin(), mapDataOut.speeds.end(),	appStruct.speed_limit) == mapDataOut.speeds.end())
-			mapDataOut.speeds.push_back(appStruct.speed_limit);
+		if ((std::find(mapDataOut.speeds.begin(), mapDataOut.speeds.end(),	appStruct.speed_limit) == mapDataOut.speeds.end())
+			&& !mapDataOut.speeds.push_back(appStruct.speed_limit))
+		{
+			report_codecError(codecError::invalidValue, "msgFrame2mapData_single", "more distinct speed limits than",
+				{static_cast<int64_t>(mapDataOut.speeds.capacity())});
+			has_error = true;
+		}
 		if (nodeCnt != pGenericLane->nodeList.choice.nodes.list.count)
 			laneStruct.mpNodes.resize(nodeCnt);
 		appStruct.mpLanes.push_back(laneStruct);
@@ -2013,7 +2017,7 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 	if (std::count_if(mapDataOut.speeds.begin(), mapDataOut.speeds.end(),
 		[](const uint16_t& item){return((item > 0) && (item < MsgEnum::unknown_speed));}) == 0)
 	{
-		std::cerr << prog_name << "missing speedLimit" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2mapData_single", "missing speedLimit");
 		has_error = true;
 	}
 	else
@@ -2026,7 +2030,6 @@ auto msgFrame2mapData_single = [](const MapData_t& mapData, MapData_element_t& m
 /// convert MapData_t, which specifies speed limit at the approach level, to MapData_element_t
 auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& mapDataOut)->bool
 {
-	std::string prog_name{"msgFrame2mapData_multi: "};
 	mapDataOut.id = static_cast<uint16_t>(mapData.intersections->list.array[0]->id.id);
 	if (mapData.intersections->list.array[0]->id.region != NULL)
 		mapDataOut.regionalId = static_cast<uint16_t>(*(mapData.intersections->list.array[0]->id.region));
@@ -2050,20 +2053,20 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 		const IntersectionGeometry_t* pIntersectionGeometry = mapData.intersections->list.array[i];
 		if (static_cast<uint16_t>(pIntersectionGeometry->id.id) != mapDataOut.id)
 		{
-			std::cerr << prog_name << "containing multiples IntersectionReferenceID" << std::endl;
+			report_codecError(codecError::invalidValue, "msgFrame2mapData_multi", "containing multiples IntersectionReferenceID");
 			has_error = true;
 			break;
 		}
 		if (pIntersectionGeometry->laneWidth == NULL)
 		{
-			std::cerr << prog_name << "missing LaneWidth" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "missing LaneWidth");
 			has_error = true;
 			break;
 		}
 		uint16_t refLaneWidth = static_cast<uint16_t>(*(pIntersectionGeometry->laneWidth));
 		if (pIntersectionGeometry->laneSet.list.count == 0)
 		{
-			std::cerr << prog_name << "missing LaneList" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "missing LaneList");
 			has_error = true;
 			break;
 		}
@@ -2072,9 +2075,8 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 		uint8_t  laneDirectionalUse = static_cast<uint8_t>(bitString2ul(firstLaneDirection.buf, firstLaneDirection.size, firstLaneDirection.bits_unused));
 		if ((laneDirectionalUse < 0x01) || (laneDirectionalUse > 0x03))
 		{
-			std::cerr << prog_name << "unknown laneDirectionalUse=" << static_cast<unsigned int>(laneDirectionalUse);
-			std::cerr << ", bitString size=" << firstLaneDirection.size;
-			std::cerr << ", bits_unused=" << firstLaneDirection.bits_unused << std::endl;
+			report_codecError(codecError::invalidValue, "msgFrame2mapData_multi", "unknown laneDirectionalUse, bitString size, bits_unused",
+				{laneDirectionalUse, static_cast<int64_t>(firstLaneDirection.size), firstLaneDirection.bits_unused});
 			has_error = true;
 			break;
 		}
@@ -2101,16 +2103,14 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 			uint8_t directionalUse = static_cast<uint8_t>(bitString2ul(laneDirection.buf, laneDirection.size, laneDirection.bits_unused));
 			if ((directionalUse < 0x01) || (directionalUse > 0x03))
 			{
-				std::cerr << prog_name << "laneId=" << pGenericLane->laneID;
-				std::cerr << ", unknown directionalUse=" << static_cast<unsigned int>(directionalUse);
-				std::cerr << ", bitString size=" << laneDirection.size;
-				std::cerr << ", bits_unused=" << laneDirection.bits_unused << std::endl;
+				report_codecError(codecError::invalidValue, "msgFrame2mapData_multi", "laneId, unknown directionalUse, bitString size, bits_unused",
+					{pGenericLane->laneID, directionalUse, static_cast<int64_t>(laneDirection.size), laneDirection.bits_unused});
 				has_error = true;
 				break;
 			}
 			if ((pGenericLane->ingressApproach == NULL) && (pGenericLane->egressApproach == NULL))
 			{
-				std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing ApproachID" << std::endl;
+				report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "laneId, missing ApproachID", {pGenericLane->laneID});
 				has_error = true;
 				break;
 			}
@@ -2118,7 +2118,7 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 				&& ((pGenericLane->connectsTo == NULL) || (pGenericLane->connectsTo->list.count == 0)
 					|| (pGenericLane->connectsTo->list.array[0]->signalGroup == NULL)))
 			{ // required to provide signal phase that controls the movement
-				std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing ConnectsTo" << std::endl;
+				report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "laneId, missing ConnectsTo", {pGenericLane->laneID});
 				has_error = true;
 				break;
 			}
@@ -2127,7 +2127,7 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 				|| (pGenericLane->nodeList.choice.nodes.list.count < 2)
 				|| (pGenericLane->nodeList.choice.nodes.list.count > 63))
 			{
-				std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing NodeListXY" << std::endl;
+				report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "laneId, missing NodeListXY", {pGenericLane->laneID});
 				has_error = true;
 				break;
 			}
@@ -2164,7 +2164,7 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 			if (directionalUse != 0x03)
 			{ // not crosswalk
 				if (pGenericLane->maneuvers == NULL)
-					std::cerr << prog_name << "laneId=" << pGenericLane->laneID << ", missing AllowedManeuvers" << std::endl;
+					report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "laneId, missing AllowedManeuvers", {pGenericLane->laneID});
 				else
 					allowedManeuvers = bitString2ul(pGenericLane->maneuvers->buf, pGenericLane->maneuvers->size, pGenericLane->maneuvers->bits_unused);
 			}
@@ -2178,7 +2178,13 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 			// loop through connecting lanes
 			if (pGenericLane->connectsTo != NULL)
 			{
-				laneStruct.mpConnectTo.resize(pGenericLane->connectsTo->list.count);
+				if (!laneStruct.mpConnectTo.resize(pGenericLane->connectsTo->list.count))
+				{
+					report_codecError(codecError::invalidValue, "msgFrame2mapData_multi", "laneId, ConnectsToList over maxConnectsTo",
+						{pGenericLane->laneID, pGenericLane->connectsTo->list.count});
+					has_error = true;
+					break;
+				}
 				for (int k = 0; k < pGenericLane->connectsTo->list.count; k++)
 				{ // assign ConnectStruct variables
 					const Connection_t* pConnection = pGenericLane->connectsTo->list.array[k];
@@ -2274,7 +2280,7 @@ auto msgFrame2mapData_multi = [](const MapData_t& mapData, MapData_element_t& ma
 	if (std::count_if(mapDataOut.speeds.begin(), mapDataOut.speeds.end(),
 		[](const uint16_t& item){return((item > 0) && (item < MsgEnum::unknown_speed));}) == 0)
 	{
-		std::cerr << prog_name << "missing speedLimit" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2mapData_multi", "missing speedLimit");
 		has_error = true;
 	}
 	else
@@ -2290,23 +2296,16 @@ auto msgFrame2mapData = [](const MapData_t& mapData, MapData_element_t& mapDataO
 	if ((mapData.intersections == NULL) || (mapData.intersections->list.array == NULL)
 		|| (mapData.intersections->list.array[0] == NULL) || (mapData.intersections->list.count == 0))
 	{
-		std::cerr << "msgFrame2mapData: empty IntersectionGeometryList" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2mapData", "empty IntersectionGeometryList");
 		return(false);
 	}
 	mapDataOut.isSingleFrame = (mapData.intersections->list.count == 1) ? true : false;
 	return((mapDataOut.isSingleFrame) ? msgFrame2mapData_single(mapData, mapDataOut) : msgFrame2mapData_multi(mapData, mapDataOut));
 };
 
-/// convert SPAT_t to SPAT_element_t
-auto msgFrame2spat = [](const SPAT_t& spat, SPAT_element_t& spatOut)->bool
+/// convert IntersectionState_t to IntersectionState_element_t
+auto msgFrame2intersectionState = [](const IntersectionState_t* pIntsectionState, IntersectionState_element_t& spatOut)->bool
 {
-	std::string prog_name{"msgFrame2spat: "};
-	if (spat.intersections.list.count == 0)
-	{
-		std::cerr << prog_name << "empty IntersectionStateList" << std::endl;
-		return(false);
-	}
-	const IntersectionState_t* pIntsectionState = spat.intersections.list.array[0];
 	spatOut.id = static_cast<uint16_t>(pIntsectionState->id.id);
 	if (pIntsectionState->id.region != NULL)
 		spatOut.regionalId = static_cast<uint16_t>(*(pIntsectionState->id.region));
@@ -2318,7 +2317,7 @@ auto msgFrame2spat = [](const SPAT_t& spat, SPAT_element_t& spatOut)->bool
 	spatOut.status = std::bitset<16>(bitString2ul(pIntsectionState->status.buf, pIntsectionState->status.size, pIntsectionState->status.bits_unused));
 	if (pIntsectionState->states.list.count == 0)
 	{
-		std::cerr << prog_name << "empty MovementList" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2intersectionState", "empty MovementList");
 		spatOut.reset();
 		return(false);
 	}
@@ -2330,28 +2329,40 @@ auto msgFrame2spat = [](const SPAT_t& spat, SPAT_element_t& spatOut)->bool
 		const MovementState_t* pMovementState = pIntsectionState->states.list.array[i];
 		if ((pMovementState->signalGroup < 1) || (pMovementState->signalGroup > 2 * 8))
 		{
-			std::cerr << prog_name << "invalid SignalGroupID" << std::endl;
+			report_codecError(codecError::invalidValue, "msgFrame2intersectionState", "invalid SignalGroupID");
 			has_error = true;
 			break;
 		}
-		if (pMovementState->state_time_speed.list.count == 0)
+		size_t numEvents = static_cast<size_t>(pMovementState->state_time_speed.list.count);
+		if (numEvents == 0)
 			continue;
-		const MovementEvent_t* pMovementEvent = pMovementState->state_time_speed.list.array[0];
 		int j = static_cast<int>((pMovementState->signalGroup - 1) % 8);
 		PhaseState_element_t& phaseState = (pMovementState->signalGroup > 8) ?
 			spatOut.pedPhaseState[j] : spatOut.phaseState[j];
+		if (numEvents > MsgEnum::maxMovementEvents)
+		{
+			report_codecError(codecError::invalidValue, "msgFrame2intersectionState", "MovementEventList over maxMovementEvents");
+			has_error = true;
+			break;
+		}
+		spatOut.setNumNextEvents(phaseState, numEvents - 1);
 		if (pMovementState->signalGroup > 8)
 			permittedPedPhases.set(j);
 		else
 			permittedPhases.set(j);
-		phaseState.currState = static_cast<MsgEnum::phaseState>(pMovementEvent->eventState);
-		if (pMovementEvent->timing != NULL)
+		for (size_t k = 0; k < numEvents; k++)
 		{
-			phaseState.minEndTime = static_cast<uint16_t>(pMovementEvent->timing->minEndTime);
-			if (pMovementEvent->timing->startTime != NULL)
-				phaseState.startTime = static_cast<uint16_t>(*(pMovementEvent->timing->startTime));
-			if (pMovementEvent->timing->maxEndTime != NULL)
-				phaseState.maxEndTime = static_cast<uint16_t>(*(pMovementEvent->timing->maxEndTime));
+			const MovementEvent_t* pMovementEvent = pMovementState->state_time_speed.list.array[k];
+			MovementEvent_element_t& eventOut = spatOut.event(phaseState, k);
+			eventOut.currState = static_cast<MsgEnum::phaseState>(pMovementEvent->eventState);
+			if (pMovementEvent->timing != NULL)
+			{
+				eventOut.minEndTime = static_cast<uint16_t>(pMovementEvent->timing->minEndTime);
+				if (pMovementEvent->timing->startTime != NULL)
+					eventOut.startTime = static_cast<uint16_t>(*(pMovementEvent->timing->startTime));
+				if (pMovementEvent->timing->maxEndTime != NULL)
+					eventOut.maxEndTime = static_cast<uint16_t>(*(pMovementEvent->timing->maxEndTime));
+			}
 		}
 	}
 	if (has_error)
@@ -2359,13 +2370,40 @@ auto msgFrame2spat = [](const SPAT_t& spat, SPAT_element_t& spatOut)->bool
 	return(!has_error);
 };
 
+/// convert SPAT_t to SPAT_element_t
+auto msgFrame2spat = [](const SPAT_t& spat, SPAT_element_t& spatOut)->bool
+{
+	if (spat.intersections.list.count == 0)
+	{
+		report_codecError(codecError::missingElement, "msgFrame2spat", "empty IntersectionStateList");
+		return(false);
+	}
+	size_t numIntersections = static_cast<size_t>(spat.intersections.list.count);
+	if (numIntersections > MsgEnum::maxSpatIntersections)
+	{
+		report_codecError(codecError::invalidValue, "msgFrame2spat", "IntersectionStateList over maxSpatIntersections");
+		return(false);
+	}
+	spatOut.moreIntersections.resize(numIntersections - 1);
+	for (size_t i = 1; i < numIntersections; i++)
+		spatOut.intersection(i).reset();
+	for (size_t i = 0; i < numIntersections; i++)
+	{
+		if (!msgFrame2intersectionState(spat.intersections.list.array[i], spatOut.intersection(i)))
+		{
+			spatOut.reset();
+			return(false);
+		}
+	}
+	return(true);
+};
+
 /// convert RTCMcorrections_t to RTCM_element_t
 auto msgFrame2rtcm = [](const RTCMcorrections_t& rtcm, RTCM_element_t& rtcmOut)->bool
 {
-	std::string prog_name{"msgFrame2rtcm: "};
 	if (rtcm.msgs.list.count == 0)
 	{
-		std::cerr << prog_name << "empty RTCMmessageList" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2rtcm", "empty RTCMmessageList");
 		return(false);
 	}
 	rtcmOut.msgCnt = static_cast<uint8_t>(rtcm.msgCnt);
@@ -2375,7 +2413,7 @@ auto msgFrame2rtcm = [](const RTCMcorrections_t& rtcm, RTCM_element_t& rtcmOut)-
 	const RTCMmessage_t* pRTCMmessage = rtcm.msgs.list.array[0];
 	if (pRTCMmessage->size == 0)
 	{
-		std::cerr << prog_name << "empty RTCMmessage" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2rtcm", "empty RTCMmessage");
 		rtcmOut.reset();
 		return(false);
 	}
@@ -2383,21 +2421,9 @@ auto msgFrame2rtcm = [](const RTCMcorrections_t& rtcm, RTCM_element_t& rtcmOut)-
 	return(true);
 };
 
-/// convert SignalRequestMessage_t to SRM_element_t
-auto msgFrame2srm = [](const SignalRequestMessage_t& srm, SRM_element_t& srmOut)->bool
+/// convert SignalRequestPackage_t to SignalRequest_element_t
+auto msgFrame2signalRequestPackage = [](const SignalRequestPackage_t* pSignalRequestPackage, SignalRequest_element_t& srmOut)->void
 {
-	std::string prog_name{"msgFrame2srm: "};
-	if ((srm.requests == NULL) || (srm.requests->list.count == 0))
-	{
-		std::cerr << prog_name << "missing SignalRequestList" << std::endl;
-		return(false);
-	}
-	srmOut.timeStampSec = static_cast<uint16_t>(srm.second);
-	if (srm.timeStamp != NULL)
-		srmOut.timeStampMinute = static_cast<uint32_t>(*(srm.timeStamp));
-	if (srm.sequenceNumber != NULL)
-		srmOut.msgCnt = static_cast<uint8_t>(*(srm.sequenceNumber));
-	const SignalRequestPackage_t* pSignalRequestPackage = srm.requests->list.array[0];
 	if (pSignalRequestPackage->minute != NULL)
 		srmOut.ETAminute = static_cast<uint32_t>(*(pSignalRequestPackage->minute));
 	if (pSignalRequestPackage->second != NULL)
@@ -2421,31 +2447,59 @@ auto msgFrame2srm = [](const SignalRequestMessage_t& srm, SRM_element_t& srmOut)
 		else if (signalRequest.outBoundLane->present == IntersectionAccessPoint_PR_lane)
 			srmOut.outLaneId = static_cast<uint8_t>(signalRequest.outBoundLane->choice.lane);
 	}
+};
+
+/// convert SignalRequestMessage_t to SRM_element_t
+auto msgFrame2srm = [](const SignalRequestMessage_t& srm, SRM_element_t& srmOut)->bool
+{
+	if ((srm.requests == NULL) || (srm.requests->list.count == 0))
+	{
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing SignalRequestList");
+		return(false);
+	}
+	srmOut.timeStampSec = static_cast<uint16_t>(srm.second);
+	if (srm.timeStamp != NULL)
+		srmOut.timeStampMinute = static_cast<uint32_t>(*(srm.timeStamp));
+	if (srm.sequenceNumber != NULL)
+		srmOut.msgCnt = static_cast<uint8_t>(*(srm.sequenceNumber));
+	size_t numRequests = static_cast<size_t>(srm.requests->list.count);
+	if (!srmOut.moreRequests.resize(numRequests - 1))
+	{
+		report_codecError(codecError::invalidValue, "msgFrame2srm", "SignalRequestList over maxSignalRequests");
+		srmOut.reset();
+		return(false);
+	}
+	for (size_t i = 0; i < numRequests; i++)
+	{
+		if (i > 0)
+			srmOut.request(i).reset();
+		msgFrame2signalRequestPackage(srm.requests->list.array[i], srmOut.request(i));
+	}
 	const RequestorDescription_t& requestor = srm.requestor;
 	if (requestor.id.present != VehicleID_PR_entityID)
 	{
-		std::cerr << prog_name << "missing Temporary ID" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing Temporary ID");
 		srmOut.reset();
 		return(false);
 	}
 	srmOut.vehId = static_cast<uint32_t>(octString2ul(requestor.id.choice.entityID.buf, requestor.id.choice.entityID.size));
 	if (requestor.type == NULL)
 	{
-		std::cerr << prog_name << "missing RequestorType" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing RequestorType");
 		srmOut.reset();
 		return(false);
 	}
 	srmOut.vehRole = static_cast<MsgEnum::basicRole>(requestor.type->role);
 	if (requestor.type->hpmsType == NULL)
 	{
-		std::cerr << prog_name << "missing VehicleType" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing VehicleType");
 		srmOut.reset();
 		return(false);
 	}
 	srmOut.vehType = static_cast<MsgEnum::vehicleType>(*(requestor.type->hpmsType));
 	if (requestor.position == NULL)
 	{
-		std::cerr << prog_name << "missing RequestorPositionVector" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing RequestorPositionVector");
 		srmOut.reset();
 		return(false);
 	}
@@ -2455,14 +2509,14 @@ auto msgFrame2srm = [](const SignalRequestMessage_t& srm, SRM_element_t& srmOut)
 		srmOut.elevation =static_cast<int32_t>(*(requestor.position->position.elevation));
 	if (requestor.position->heading == NULL)
 	{
-		std::cerr << prog_name << "missing heading" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing heading");
 		srmOut.reset();
 		return(false);
 	}
 	srmOut.heading = static_cast<uint16_t>(*(requestor.position->heading));
 	if (requestor.position->speed == NULL)
 	{
-		std::cerr << prog_name << "missing TransmissionAndSpeed" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2srm", "missing TransmissionAndSpeed");
 		srmOut.reset();
 		return(false);
 	}
@@ -2474,10 +2528,9 @@ auto msgFrame2srm = [](const SignalRequestMessage_t& srm, SRM_element_t& srmOut)
 /// convert SignalStatusMessage_t to SSM_element_t
 auto msgFrame2ssm = [](const SignalStatusMessage_t& ssm, SSM_element_t& ssmOut)->bool
 {
-	std::string prog_name{"msgFrame2ssm: "};
 	if (ssm.status.list.count == 0)
 	{
-		std::cerr << prog_name << "empty SignalStatusList" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2ssm", "empty SignalStatusList");
 		return(false);
 	}
 	ssmOut.timeStampSec = static_cast<uint16_t>(ssm.second);
@@ -2492,11 +2545,17 @@ auto msgFrame2ssm = [](const SignalStatusMessage_t& ssm, SSM_element_t& ssmOut)-
 		ssmOut.regionalId = static_cast<uint16_t>(*(pSignalStatus->id.region));
 	if (pSignalStatus->sigStatus.list.count == 0)
 	{
-		std::cerr << prog_name << "empty SignalStatusPackageList" << std::endl;
+		report_codecError(codecError::missingElement, "msgFrame2ssm", "empty SignalStatusPackageList");
+		ssmOut.reset();
+		return(false);
+	}
+	if (!ssmOut.mpSignalRequetStatus.resize(pSignalStatus->sigStatus.list.count))
+	{
+		report_codecError(codecError::invalidValue, "msgFrame2ssm", "SignalStatusPackageList over maxSignalStatusPackages",
+			{pSignalStatus->sigStatus.list.count});
 		ssmOut.reset();
 		return(false);
 	}
-	ssmOut.mpSignalRequetStatus.resize(pSignalStatus->sigStatus.list.count);
 	bool has_error = false;
 	for (int i = 0; i < pSignalStatus->sigStatus.list.count; i++)
 	{
@@ -2523,13 +2582,13 @@ auto msgFrame2ssm = [](const SignalStatusMessage_t& ssm, SSM_element_t& ssmOut)-
 			signalRequetStatus.duration = static_cast<uint16_t>(*(pSignalStatusPackage->duration));
 		if (pSignalStatusPackage->requester == NULL)
 		{
-			std::cerr << prog_name << "missing SignalRequesterInfo" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2ssm", "missing SignalRequesterInfo");
 			has_error = true;
 			break;
 		}
 		if (pSignalStatusPackage->requester->id.present != VehicleID_PR_entityID)
 		{
-			std::cerr << prog_name << "missing Temporary ID" << std::endl;
+			report_codecError(codecError::missingElement, "msgFrame2ssm", "missing Temporary ID");
 			has_error = true;
 			break;
 		}
@@ -2579,13 +2638,69 @@ auto msgFrame2bsm = [](const BasicSafetyMessage_t& bsm, BSM_element_t& bsmOut)->
 	return(true);
 };
 
-/// SAE J2735 UPER encoding function
-size_t AsnJ2735Lib::encode_msgFrame(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size)
+/// asn1c MessageFrame value of each dsrc element type, for the typed encoding and decoding functions
+template<typename T> struct msgFrameValue_t;
+template<> struct msgFrameValue_t<MapData_element_t>
+{
+	static const MessageFrame__value_PR present = MessageFrame__value_PR_MapData;
+	static bool fromElement(const MapData_element_t& mapDataIn, MessageFrame_t& msgFrame)
+	{
+		return((mapDataIn.isSingleFrame)
+			? mapData2msgFrame_single(mapDataIn, msgFrame.value.choice.MapData)
+			: mapData2msgFrame_multi(mapDataIn, msgFrame.value.choice.MapData));
+	};
+	static bool toElement(const MessageFrame_t& msgFrame, MapData_element_t& mapDataOut)
+		{return(msgFrame2mapData(msgFrame.value.choice.MapData, mapDataOut));};
+};
+template<> struct msgFrameValue_t<SPAT_element_t>
+{
+	static const MessageFrame__value_PR present = MessageFrame__value_PR_SPAT;
+	static bool fromElement(const SPAT_element_t& spatIn, MessageFrame_t& msgFrame)
+		{return(spat2msgFrame(spatIn, msgFrame.value.choice.SPAT));};
+	static bool toElement(const MessageFrame_t& msgFrame, SPAT_element_t& spatOut)
+		{return(msgFrame2spat(msgFrame.value.choice.SPAT, spatOut));};
+};
+template<> struct msgFrameValue_t<BSM_element_t>
+{
+	static const MessageFrame__value_PR present = MessageFrame__value_PR_BasicSafetyMessage;
+	static bool fromElement(const BSM_element_t& bsmIn, MessageFrame_t& msgFrame)
+		{return(bsm2msgFrame(bsmIn, msgFrame.value.choice.BasicSafetyMessage));};
+	static bool toElement(const MessageFrame_t& msgFrame, BSM_element_t& bsmOut)
+		{return(msgFrame2bsm(msgFrame.value.choice.BasicSafetyMessage, bsmOut));};
+};
+template<> struct msgFrameValue_t<RTCM_element_t>
+{
+	static const MessageFrame__value_PR present = MessageFrame__value_PR_RTCMcorrections;
+	static bool fromElement(const RTCM_element_t& rtcmIn, MessageFrame_t& msgFrame)
+		{return(rtcm2msgFrame(rtcmIn, msgFrame.value.choice.RTCMcorrections));};
+	static bool toElement(const MessageFrame_t& msgFrame, RTCM_element_t& rtcmOut)
+		{return(msgFrame2rtcm(msgFrame.value.choice.RTCMcorrections, rtcmOut));};
+};
+template<> struct msgFrameValue_t<SRM_element_t>
+{
+	static const MessageFrame__value_PR present = MessageFrame__value_PR_SignalRequestMessage;
+	static bool fromElement(const SRM_element_t& srmIn, MessageFrame_t& msgFrame)
+		{return(srm2msgFrame(srmIn, msgFrame.value.choice.SignalRequestMessage));};
+	static bool toElement(const MessageFrame_t& msgFrame, SRM_element_t& srmOut)
+		{return(msgFrame2srm(msgFrame.value.choice.SignalRequestMessage, srmOut));};
+};
+template<> struct msgFrameValue_t<SSM_element_t>
+{
+	static const MessageFrame__value_PR present = MessageFrame__value_PR_SignalStatusMessage;
+	static bool fromElement(const SSM_element_t& ssmIn, MessageFrame_t& msgFrame)
+		{return(ssm2msgFrame(ssmIn, msgFrame.value.choice.SignalStatusMessage));};
+	static bool toElement(const MessageFrame_t& msgFrame, SSM_element_t& ssmOut)
+		{return(msgFrame2ssm(msgFrame.value.choice.SignalStatusMessage, ssmOut));};
+};
+
+/// SAE J2735 UPER encoding function of a single message type
+template<typename T>
+size_t AsnJ2735Lib::encode_asn1c(const T& msgIn, uint8_t* buf, size_t size)
 {
 	MessageFrame_t* pMessageFrame = (MessageFrame_t *)calloc(1, sizeof(MessageFrame_t));
 	if (pMessageFrame == NULL)
 	{
-		std::cerr << "encode_msgFrame: failed allocate MessageFrame" << std::endl;
+		report_codecError(codecError::allocFailed, "encode_asn1c", "MessageFrame");
 		return(0);
 	}
 	// MessageFrame:
@@ -2593,100 +2708,268 @@ size_t AsnJ2735Lib::encode_msgFrame(const Frame_element_t& dsrcFrameIn, uint8_t*
 	// messageId
 	// value
 	// -------------------------------------------------------- //
-	bool tf2msgFrame;
+	pMessageFrame->value.present = msgFrameValue_t<T>::present;
+	if (!msgFrameValue_t<T>::fromElement(msgIn, *pMessageFrame))
+	{
+		ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
+		return(0);
+	}
+	pMessageFrame->messageId = msgId<T>::value;
+	asn_enc_rval_t rval = uper_encode_to_buffer(&asn_DEF_MessageFrame, 0, pMessageFrame, buf, size);
+	ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
+	if (rval.encoded <= 0)
+	{
+		report_codecError(codecError::encodeFailed, "encode_asn1c", "UPER encoding");
+		return(0);
+	}
+	return(numbits2numbytes(rval.encoded));
+}
+
+template size_t AsnJ2735Lib::encode_asn1c<MapData_element_t>(const MapData_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode_asn1c<SPAT_element_t>(const SPAT_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode_asn1c<BSM_element_t>(const BSM_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode_asn1c<RTCM_element_t>(const RTCM_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode_asn1c<SRM_element_t>(const SRM_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode_asn1c<SSM_element_t>(const SSM_element_t&, uint8_t*, size_t);
+
+/// SAE J2735 UPER encoding function
+size_t AsnJ2735Lib::encode_msgFrame(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size)
+{
 	switch(dsrcFrameIn.dsrcMsgId)
 	{
 	case MsgEnum::DSRCmsgID_map:
-		pMessageFrame->value.present = MessageFrame__value_PR_MapData;
-		tf2msgFrame = (dsrcFrameIn.mapData.isSingleFrame)
-			? mapData2msgFrame_single(dsrcFrameIn.mapData, pMessageFrame->value.choice.MapData)
-			: mapData2msgFrame_multi(dsrcFrameIn.mapData, pMessageFrame->value.choice.MapData);
-		break;
+		return(encode_asn1c(dsrcFrameIn.mapData, buf, size));
 	case MsgEnum::DSRCmsgID_spat:
-		pMessageFrame->value.present = MessageFrame__value_PR_SPAT;
-		tf2msgFrame = spat2msgFrame(dsrcFrameIn.spat, pMessageFrame->value.choice.SPAT);
-		break;
+		return(encode_asn1c(dsrcFrameIn.spat, buf, size));
 	case MsgEnum::DSRCmsgID_bsm:
-		pMessageFrame->value.present = MessageFrame__value_PR_BasicSafetyMessage;
-		tf2msgFrame = bsm2msgFrame(dsrcFrameIn.bsm, pMessageFrame->value.choice.BasicSafetyMessage);
-		break;
+		return(encode_asn1c(dsrcFrameIn.bsm, buf, size));
 	case MsgEnum::DSRCmsgID_rtcm:
-		pMessageFrame->value.present = MessageFrame__value_PR_RTCMcorrections;
-		tf2msgFrame = rtcm2msgFrame(dsrcFrameIn.rtcm, pMessageFrame->value.choice.RTCMcorrections);
-		break;
+		return(encode_asn1c(dsrcFrameIn.rtcm, buf, size));
 	case MsgEnum::DSRCmsgID_srm:
-		pMessageFrame->value.present = MessageFrame__value_PR_SignalRequestMessage;
-		tf2msgFrame = srm2msgFrame(dsrcFrameIn.srm, pMessageFrame->value.choice.SignalRequestMessage);
-		break;
+		return(encode_asn1c(dsrcFrameIn.srm, buf, size));
 	case MsgEnum::DSRCmsgID_ssm:
-		pMessageFrame->value.present = MessageFrame__value_PR_SignalStatusMessage;
-		tf2msgFrame = ssm2msgFrame(dsrcFrameIn.ssm, pMessageFrame->value.choice.SignalStatusMessage);
-		break;
+		return(encode_asn1c(dsrcFrameIn.ssm, buf, size));
 	default:
-		tf2msgFrame = false;
-		break;
+		report_codecError(codecError::wrongMsgType, "encode_msgFrame", "unknown dsrcMsgId");
+		return(0);
 	}
-	if (!tf2msgFrame)
+}
+
+/// SAE J2735 OER encoding function of a single message type. OER octet-aligns every field and spells out
+/// lengths that UPER packs into bits, so the encoding is larger but faster to parse. The open type value
+/// is encoded twice by the asn1c runtime, once to learn its length, so OER encoding is the slower one
+template<typename T>
+static size_t encode_oer(const T& msgIn, uint8_t* buf, size_t size)
+{
+	MessageFrame_t* pMessageFrame = (MessageFrame_t *)calloc(1, sizeof(MessageFrame_t));
+	if (pMessageFrame == NULL)
+	{
+		report_codecError(codecError::allocFailed, "encode_msgFrame_oer", "MessageFrame");
+		return(0);
+	}
+	pMessageFrame->value.present = msgFrameValue_t<T>::present;
+	if (!msgFrameValue_t<T>::fromElement(msgIn, *pMessageFrame))
 	{
 		ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
 		return(0);
 	}
-	pMessageFrame->messageId = dsrcFrameIn.dsrcMsgId;
-	asn_enc_rval_t rval = uper_encode_to_buffer(&asn_DEF_MessageFrame, 0, pMessageFrame, buf, size);
+	pMessageFrame->messageId = AsnJ2735Lib::msgId<T>::value;
+	asn_enc_rval_t rval = oer_encode_to_buffer(&asn_DEF_MessageFrame, 0, pMessageFrame, buf, size);
 	ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
-	return(numbits2numbytes(rval.encoded));
+	if (rval.encoded <= 0)
+	{
+		report_codecError(codecError::encodeFailed, "encode_msgFrame_oer", "OER encoding");
+		return(0);
+	}
+	return(static_cast<size_t>(rval.encoded));
 }
 
-/// SAE J2735 UPER decoding function
-size_t AsnJ2735Lib::decode_msgFrame(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut)
+/// SAE J2735 OER encoding function
+size_t AsnJ2735Lib::encode_msgFrame_oer(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size)
 {
-	dsrcFrameOut.reset();
-	MessageFrame_t* pMessageFrame = NULL;
-	asn_dec_rval_t rval = uper_decode(0, &asn_DEF_MessageFrame, (void **)&pMessageFrame, buf, size, 0, 0);
-	if (rval.code != RC_OK)
+	switch(dsrcFrameIn.dsrcMsgId)
 	{
-		std::cerr << "decode_msgFrame: failed UPER decoding" << std::endl;
-		ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
+	case MsgEnum::DSRCmsgID_map:
+		return(encode_oer(dsrcFrameIn.mapData, buf, size));
+	case MsgEnum::DSRCmsgID_spat:
+		return(encode_oer(dsrcFrameIn.spat, buf, size));
+	case MsgEnum::DSRCmsgID_bsm:
+		return(encode_oer(dsrcFrameIn.bsm, buf, size));
+	case MsgEnum::DSRCmsgID_rtcm:
+		return(encode_oer(dsrcFrameIn.rtcm, buf, size));
+	case MsgEnum::DSRCmsgID_srm:
+		return(encode_oer(dsrcFrameIn.srm, buf, size));
+	case MsgEnum::DSRCmsgID_ssm:
+		return(encode_oer(dsrcFrameIn.ssm, buf, size));
+	default:
+		report_codecError(codecError::wrongMsgType, "encode_msgFrame_oer", "unknown dsrcMsgId");
 		return(0);
 	}
-	/// convert decoded result to dsrcFrameOut, based on message ID
-	uint16_t dsrcMsgId = static_cast<uint16_t>(pMessageFrame->messageId);
+}
+
+/// convert decoded MessageFrame to dsrcFrameOut, based on message ID
+auto msgFrame2dsrcFrame = [](const MessageFrame_t& msgFrame, Frame_element_t& dsrcFrameOut)->bool
+{
+	uint16_t dsrcMsgId = static_cast<uint16_t>(msgFrame.messageId);
+	dsrcFrameOut.dsrcMsgId = dsrcMsgId;  // the member being filled, for reset() on failure
 	bool tf2out;
 	switch(dsrcMsgId)
 	{
 	case MsgEnum::DSRCmsgID_map:
-		tf2out = ((pMessageFrame->value.present == MessageFrame__value_PR_MapData)
-			&& msgFrame2mapData(pMessageFrame->value.choice.MapData, dsrcFrameOut.mapData));
+		tf2out = ((msgFrame.value.present == MessageFrame__value_PR_MapData)
+			&& msgFrame2mapData(msgFrame.value.choice.MapData, dsrcFrameOut.mapData));
 		break;
 	case MsgEnum::DSRCmsgID_spat:
-		tf2out = ((pMessageFrame->value.present == MessageFrame__value_PR_SPAT)
-				&& msgFrame2spat(pMessageFrame->value.choice.SPAT, dsrcFrameOut.spat));
+		tf2out = ((msgFrame.value.present == MessageFrame__value_PR_SPAT)
+				&& msgFrame2spat(msgFrame.value.choice.SPAT, dsrcFrameOut.spat));
 		break;
 	case MsgEnum::DSRCmsgID_bsm:
-		tf2out = ((pMessageFrame->value.present == MessageFrame__value_PR_BasicSafetyMessage)
-				&& msgFrame2bsm(pMessageFrame->value.choice.BasicSafetyMessage, dsrcFrameOut.bsm));
+		tf2out = ((msgFrame.value.present == MessageFrame__value_PR_BasicSafetyMessage)
+				&& msgFrame2bsm(msgFrame.value.choice.BasicSafetyMessage, dsrcFrameOut.bsm));
 		break;
 	case MsgEnum::DSRCmsgID_rtcm:
-		tf2out = ((pMessageFrame->value.present == MessageFrame__value_PR_RTCMcorrections)
-				&& msgFrame2rtcm(pMessageFrame->value.choice.RTCMcorrections, dsrcFrameOut.rtcm));
+		tf2out = ((msgFrame.value.present == MessageFrame__value_PR_RTCMcorrections)
+				&& msgFrame2rtcm(msgFrame.value.choice.RTCMcorrections, dsrcFrameOut.rtcm));
 		break;
 	case MsgEnum::DSRCmsgID_srm:
-		tf2out = ((pMessageFrame->value.present == MessageFrame__value_PR_SignalRequestMessage)
-				&& msgFrame2srm(pMessageFrame->value.choice.SignalRequestMessage, dsrcFrameOut.srm));
+		tf2out = ((msgFrame.value.present == MessageFrame__value_PR_SignalRequestMessage)
+				&& msgFrame2srm(msgFrame.value.choice.SignalRequestMessage, dsrcFrameOut.srm));
 		break;
 	case MsgEnum::DSRCmsgID_ssm:
-		tf2out = ((pMessageFrame->value.present == MessageFrame__value_PR_SignalStatusMessage)
-				&& msgFrame2ssm(pMessageFrame->value.choice.SignalStatusMessage, dsrcFrameOut.ssm));
+		tf2out = ((msgFrame.value.present == MessageFrame__value_PR_SignalStatusMessage)
+				&& msgFrame2ssm(msgFrame.value.choice.SignalStatusMessage, dsrcFrameOut.ssm));
 		break;
 	default:
+		report_codecError(codecError::wrongMsgType, "msgFrame2dsrcFrame", "unknown messageId");
 		tf2out = false;
 		break;
 	}
+	if (!tf2out)
+		dsrcFrameOut.reset();
+	return(tf2out);
+};
+
+/// SAE J2735 UPER decoding function
+size_t AsnJ2735Lib::decode_msgFrame(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut)
+{
+	dsrcFrameOut.reset();
+	MessageFrame_t* pMessageFrame = NULL;
+	asn_dec_rval_t rval = uper_decode(0, &asn_DEF_MessageFrame, (void **)&pMessageFrame, buf, size, 0, 0);
+	if (rval.code != RC_OK)
+	{
+		report_codecError(codecError::decodeFailed, "decode_msgFrame", "UPER decoding");
+		ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
+		return(0);
+	}
+	bool tf2out = msgFrame2dsrcFrame(*pMessageFrame, dsrcFrameOut);
 	ASN_STRUCT_FREE(asn_DEF_MessageFrame, pMessageFrame);
-	if (tf2out)
+	return((tf2out) ? numbits2numbytes(rval.consumed) : 0);
+}
+
+/// per-thread bump arena that holds the decoded MessageFrame tree
+class DecodeArena
+{
+	public:
+		asn_arena_t arena;
+		asn_codec_ctx_t codecCtx;
+		DecodeArena(void)
+		{ /// without its primary block, the arena still serves allocations from the C library
+			if (asn_arena_init(&arena, initialCapacity) != 0)
+				report_codecError(codecError::allocFailed, "DecodeArena", "primary arena block");
+			codecCtx.max_stack_size = ASN__DEFAULT_STACK_MAX;  /// the stack guard of a decoding without a context
+			codecCtx.allocator = &arena.allocator;
+		};
+		~DecodeArena(void)
+			{asn_arena_destroy(&arena);};
+	private:
+		static const size_t initialCapacity = 64 * 1024;
+};
+
+static thread_local DecodeArena decodeArena;
+
+/// SAE J2735 UPER decoding function, building the MessageFrame tree in the per-thread arena
+size_t AsnJ2735Lib::decode_msgFrame_arena(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut)
+{
+	dsrcFrameOut.reset();
+	MessageFrame_t* pMessageFrame = NULL;
+	asn_dec_rval_t rval = uper_decode(&decodeArena.codecCtx, &asn_DEF_MessageFrame, (void **)&pMessageFrame, buf, size, 0, 0);
+	bool tf2out = ((rval.code == RC_OK) && msgFrame2dsrcFrame(*pMessageFrame, dsrcFrameOut));
+	/// release the whole tree at once instead of ASN_STRUCT_FREE
+	asn_arena_reset(&decodeArena.arena);
+	if (rval.code != RC_OK)
 	{
-		dsrcFrameOut.dsrcMsgId = dsrcMsgId;
-		return(numbits2numbytes(rval.consumed));
+		report_codecError(codecError::decodeFailed, "decode_msgFrame_arena", "UPER decoding");
+		return(0);
 	}
-	return(0);
+	return((tf2out) ? numbits2numbytes(rval.consumed) : 0);
+}
+
+/// SAE J2735 OER decoding function, building the MessageFrame tree in the per-thread arena.
+/// The asn1c OER decoder does not enforce the constraints that UPER decoding enforces as it reads: values
+/// are checked with asn_check_constraints, and list sizes, which it does not check, by the conversion
+size_t AsnJ2735Lib::decode_msgFrame_oer(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut)
+{
+	dsrcFrameOut.reset();
+	MessageFrame_t* pMessageFrame = NULL;
+	asn_dec_rval_t rval = oer_decode(&decodeArena.codecCtx, &asn_DEF_MessageFrame, (void **)&pMessageFrame, buf, size);
+	bool isConstrained = ((rval.code == RC_OK) && (asn_check_constraints(&asn_DEF_MessageFrame, pMessageFrame, NULL, NULL) == 0));
+	bool tf2out = (isConstrained && msgFrame2dsrcFrame(*pMessageFrame, dsrcFrameOut));
+	asn_arena_reset(&decodeArena.arena);
+	if (rval.code != RC_OK)
+	{
+		report_codecError(codecError::decodeFailed, "decode_msgFrame_oer", "OER decoding");
+		return(0);
+	}
+	if (!isConstrained)
+	{
+		report_codecError(codecError::invalidValue, "decode_msgFrame_oer", "value out of its ASN.1 constraints");
+		return(0);
+	}
+	return((tf2out) ? rval.consumed : 0);
+}
+
+/// SAE J2735 UPER decoding function of a single message type, building the MessageFrame tree in the
+/// per-thread arena. A MessageFrame of another message type is not converted
+template<typename T>
+size_t AsnJ2735Lib::decode_asn1c(const uint8_t* buf, size_t size, T& msgOut)
+{
+	msgOut.reset();
+	MessageFrame_t* pMessageFrame = NULL;
+	asn_dec_rval_t rval = uper_decode(&decodeArena.codecCtx, &asn_DEF_MessageFrame, (void **)&pMessageFrame, buf, size, 0, 0);
+	bool isMsgType = ((rval.code == RC_OK) && (pMessageFrame->messageId == msgId<T>::value)
+		&& (pMessageFrame->value.present == msgFrameValue_t<T>::present));
+	bool tf2out = (isMsgType && msgFrameValue_t<T>::toElement(*pMessageFrame, msgOut));
+	asn_arena_reset(&decodeArena.arena);
+	if (rval.code != RC_OK)
+	{
+		report_codecError(codecError::decodeFailed, "decode_asn1c", "UPER decoding");
+		return(0);
+	}
+	if (!isMsgType)
+		report_codecError(codecError::wrongMsgType, "decode_asn1c", "MessageFrame of another message type");
+	if (!tf2out)
+	{
+		msgOut.reset();
+		return(0);
+	}
+	return(numbits2numbytes(rval.consumed));
+}
+
+template size_t AsnJ2735Lib::decode_asn1c<MapData_element_t>(const uint8_t*, size_t, MapData_element_t&);
+template size_t AsnJ2735Lib::decode_asn1c<SPAT_element_t>(const uint8_t*, size_t, SPAT_element_t&);
+template size_t AsnJ2735Lib::decode_asn1c<BSM_element_t>(const uint8_t*, size_t, BSM_element_t&);
+template size_t AsnJ2735Lib::decode_asn1c<RTCM_element_t>(const uint8_t*, size_t, RTCM_element_t&);
+template size_t AsnJ2735Lib::decode_asn1c<SRM_element_t>(const uint8_t*, size_t, SRM_element_t&);
+template size_t AsnJ2735Lib::decode_asn1c<SSM_element_t>(const uint8_t*, size_t, SSM_element_t&);
+
+/// allocation counters of the calling thread's decoding arena
+AsnJ2735Lib::arenaStats_t AsnJ2735Lib::get_decodeArenaStats(void)
+{
+	const asn_arena_t& arena = decodeArena.arena;
+	arenaStats_t stats;
+	stats.numAllocs = arena.num_allocs;
+	stats.numSysAllocs = arena.num_sys_allocs;
+	stats.capacity = arena.capacity;
+	stats.highWater = arena.high_water;
+	return(stats);
 }
@@ -0,0 +1,159 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* batchDecoder.cpp
+ * Batch decoding of recorded message frames.
+ * Each message is decoded with decode_msgFrame_direct into its own result slot. The result vector is kept
+ * by the caller and only resized, so the Frame_element_t members keep their storage from batch to batch.
+ * With worker threads, the calling thread and the workers claim fixed-size chunks of the batch from a
+ * shared index. The workers live as long as the BatchDecoder, so the per-thread decoding arenas used by
+ * the asn1c fallback stay warm between batches.
+ */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// asn1j2735
+#include "AsnJ2735Lib.h"
+
+/// a batch shared between the calling thread and the workers
+struct batchJob_t
+{
+	const AsnJ2735Lib::msgBuf_t* msgs = NULL;
+	AsnJ2735Lib::decodeResult_t* results = NULL;
+	size_t numMsgs = 0;
+	std::atomic<size_t> next{0};        /// first message not yet claimed
+	std::atomic<size_t> numDecoded{0};
+};
+
+struct AsnJ2735Lib::BatchDecoder::workerPool_t
+{
+	std::vector<std::thread> workers;
+	std::mutex mtx;
+	std::condition_variable cvStart;
+	std::condition_variable cvDone;
+	uint64_t jobSeq = 0;         /// incremented for every batch
+	unsigned int numBusy = 0;    /// workers yet to finish the current batch
+	bool stop = false;
+	batchJob_t job;
+};
+
+/// messages claimed at a time from a shared batch
+static const size_t batchChunkSize = 64;
+
+/// decode one message into its result slot
+auto decodeOne = [](const AsnJ2735Lib::msgBuf_t& msg, AsnJ2735Lib::decodeResult_t& result)->bool
+{
+	if ((msg.buf == NULL) || (msg.size == 0))
+	{
+		result.dsrcFrame.reset();
+		result.status = AsnJ2735Lib::decodeStatus::empty;
+		result.consumed = 0;
+		result.error = AsnJ2735Lib::codecError::none;
+		return(false);
+	}
+	result.consumed = AsnJ2735Lib::decode_msgFrame_direct(msg.buf, msg.size, result.dsrcFrame);
+	result.status = (result.consumed > 0) ? AsnJ2735Lib::decodeStatus::decoded : AsnJ2735Lib::decodeStatus::failed;
+	result.error = (result.consumed > 0) ? AsnJ2735Lib::codecError::none : AsnJ2735Lib::get_lastCodecError();
+	return(result.consumed > 0);
+};
+
+/// claim chunks of the current batch until it is exhausted
+auto drainBatch = [](batchJob_t& job)->void
+{
+	size_t numDecoded = 0;
+	while (1)
+	{
+		size_t first = job.next.fetch_add(batchChunkSize);
+		if (first >= job.numMsgs)
+			break;
+		size_t last = std::min(first + batchChunkSize, job.numMsgs);
+		for (size_t i = first; i < last; i++)
+		{
+			if (decodeOne(job.msgs[i], job.results[i]))
+				numDecoded++;
+		}
+	}
+	job.numDecoded += numDecoded;
+};
+
+AsnJ2735Lib::BatchDecoder::BatchDecoder(unsigned int numThreads) : numWorkers(numThreads), pWorkerPool(NULL)
+{
+	if (numWorkers == 0)
+		return;
+	pWorkerPool = new workerPool_t;
+	workerPool_t& pool = *pWorkerPool;
+	for (unsigned int i = 0; i < numWorkers; i++)
+	{
+		pool.workers.push_back(std::thread([&pool]()
+		{
+			uint64_t jobSeq = 0;
+			while (1)
+			{
+				{
+					std::unique_lock<std::mutex> lock(pool.mtx);
+					pool.cvStart.wait(lock, [&pool, jobSeq]{return(pool.stop || (pool.jobSeq != jobSeq));});
+					if (pool.stop)
+						return;
+					jobSeq = pool.jobSeq;
+				}
+				drainBatch(pool.job);
+				{
+					std::lock_guard<std::mutex> lock(pool.mtx);
+					if (--pool.numBusy == 0)
+						pool.cvDone.notify_one();
+				}
+			}
+		}));
+	}
+}
+
+AsnJ2735Lib::BatchDecoder::~BatchDecoder(void)
+{
+	if (pWorkerPool == NULL)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(pWorkerPool->mtx);
+		pWorkerPool->stop = true;
+	}
+	pWorkerPool->cvStart.notify_all();
+	for (auto& worker : pWorkerPool->workers)
+		worker.join();
+	delete pWorkerPool;
+}
+
+size_t AsnJ2735Lib::BatchDecoder::decode(const msgBuf_t* msgs, size_t numMsgs, std::vector<decodeResult_t>& results)
+{
+	results.resize(numMsgs);
+	if ((pWorkerPool == NULL) || (numMsgs <= batchChunkSize))
+	{ /// not worth waking up the workers
+		size_t numDecoded = 0;
+		for (size_t i = 0; i < numMsgs; i++)
+		{
+			if (decodeOne(msgs[i], results[i]))
+				numDecoded++;
+		}
+		return(numDecoded);
+	}
+	workerPool_t& pool = *pWorkerPool;
+	{
+		std::lock_guard<std::mutex> lock(pool.mtx);
+		pool.job.msgs = msgs;
+		pool.job.results = results.data();
+		pool.job.numMsgs = numMsgs;
+		pool.job.next = 0;
+		pool.job.numDecoded = 0;
+		pool.numBusy = numWorkers;
+		pool.jobSeq++;
+	}
+	pool.cvStart.notify_all();
+	drainBatch(pool.job);
+	std::unique_lock<std::mutex> lock(pool.mtx);
+	pool.cvDone.wait(lock, [&pool]{return(pool.numBusy == 0);});
+	return(pool.job.numDecoded);
+}
@@ -0,0 +1,532 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* captureReader.cpp
+ * Walk of pcap and pcapng captures of WAVE Short Messages.
+ * The file is mapped read-only and read sequentially. Each record is taken apart in place: the link-layer
+ * header (Ethernet with EtherType 0x88DC, or an IEEE 802.11 data frame with LLC/SNAP, behind a radiotap
+ * header or not), the WSMP header and, when the WSM data is IEEE 1609.2 data, the 1609.2 header, down to
+ * the J2735 MessageFrame. Nothing is copied; the reader hands out a pointer and a length into the mapping.
+ */
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// asn1j2735
+#include "captureReader.h"
+
+/// pcap link types
+static const uint32_t linkType_ethernet = 1;
+static const uint32_t linkType_ieee80211 = 105;
+static const uint32_t linkType_radiotap = 127;
+static const uint16_t etherType_wsmp = 0x88DC;
+static const uint16_t etherType_vlan = 0x8100;
+
+/// pcap magic numbers, with microsecond and nanosecond timestamps
+static const uint32_t pcapMagic_usec = 0xA1B2C3D4;
+static const uint32_t pcapMagic_nsec = 0xA1B23C4D;
+static const size_t pcapHeaderSize = 24;
+static const size_t pcapRecordHeaderSize = 16;
+
+/// pcapng block types
+static const uint32_t blockType_section = 0x0A0D0D0A;
+static const uint32_t blockType_interface = 1;
+static const uint32_t blockType_packet = 2;  /// obsolete Packet Block
+static const uint32_t blockType_simplePacket = 3;
+static const uint32_t blockType_enhancedPacket = 6;
+static const uint32_t pcapngByteOrderMagic = 0x1A2B3C4D;
+
+/// outcome of taking the headers off a record
+enum class stripResult {payload, other, encrypted, malformed};
+
+/// bounds-checked reading of a header. A read past the end clears ok and returns 0
+struct hdrCursor_t
+{
+	const uint8_t* buf;
+	size_t size;
+	size_t pos;
+	bool ok;
+	hdrCursor_t(const uint8_t* p, size_t n) : buf(p), size(n), pos(0), ok(true) {};
+	size_t remaining(void) const
+		{return(size - pos);};
+	uint8_t byte(void)
+	{
+		if (pos >= size)
+		{
+			ok = false;
+			return(0);
+		}
+		return(buf[pos++]);
+	};
+	uint16_t be16(void)
+	{
+		uint16_t hi = byte();
+		return(static_cast<uint16_t>((hi << 8) | byte()));
+	};
+	void skip(size_t n)
+	{
+		if (n > size - pos)
+		{
+			ok = false;
+			pos = size;
+		}
+		else
+			pos += n;
+	};
+	/// IEEE 1609.3-2016 count and length: 1 byte up to 127, 2 bytes up to 16383
+	size_t varLength(void)
+	{
+		uint8_t b = byte();
+		if ((b & 0x80) == 0)
+			return(b);
+		if ((b & 0xC0) == 0x80)
+			return((static_cast<size_t>(b & 0x3F) << 8) | byte());
+		ok = false;
+		return(0);
+	};
+	/// p-encoded PSID, 1 to 4 bytes with the length in the leading bits of the first
+	void skipPsid(void)
+	{
+		uint8_t b = byte();
+		if ((b & 0x80) == 0)
+			return;
+		if ((b & 0xC0) == 0x80)
+			skip(1);
+		else if ((b & 0xE0) == 0xC0)
+			skip(2);
+		else if ((b & 0xF0) == 0xE0)
+			skip(3);
+		else
+			ok = false;
+	};
+	/// OER length determinant, short form or long form of up to 4 bytes
+	size_t oerLength(void)
+	{
+		uint8_t b = byte();
+		if ((b & 0x80) == 0)
+			return(b);
+		size_t numBytes = b & 0x7F;
+		if ((numBytes == 0) || (numBytes > 4))
+		{
+			ok = false;
+			return(0);
+		}
+		size_t len = 0;
+		for (size_t i = 0; i < numBytes; i++)
+			len = (len << 8) | byte();
+		return(len);
+	};
+	/// the next n bytes as a message buffer
+	bool take(size_t n, AsnJ2735Lib::msgBuf_t& msgOut)
+	{
+		if (!ok || (n > remaining()))
+			return(false);
+		msgOut.buf = buf + pos;
+		msgOut.size = n;
+		pos += n;
+		return(true);
+	};
+};
+
+/// WAVE Information Element Extension fields, a count followed by elements of ID, length and value
+auto skipWaveExtensions = [](hdrCursor_t& cursor)->void
+{
+	size_t count = cursor.varLength();
+	for (size_t i = 0; (i < count) && cursor.ok; i++)
+	{
+		cursor.byte();
+		cursor.skip(cursor.varLength());
+	}
+};
+
+/// WSMP frame of a record, after the link-layer header
+auto getWsmpFrame = [](uint32_t linkType, const uint8_t* packet, size_t size, AsnJ2735Lib::msgBuf_t& wsmpOut)->stripResult
+{
+	hdrCursor_t cursor(packet, size);
+	if (linkType == linkType_ethernet)
+	{
+		cursor.skip(12);
+		uint16_t etherType = cursor.be16();
+		while (cursor.ok && (etherType == etherType_vlan))
+		{
+			cursor.skip(2);
+			etherType = cursor.be16();
+		}
+		if (!cursor.ok)
+			return(stripResult::malformed);
+		if (etherType != etherType_wsmp)
+			return(stripResult::other);
+		cursor.take(cursor.remaining(), wsmpOut);
+		return(stripResult::payload);
+	}
+	if (linkType == linkType_radiotap)
+	{ /// radiotap header, with its length at bytes 2 and 3 in little-endian
+		if (size < 4)
+			return(stripResult::malformed);
+		cursor.skip(static_cast<size_t>(packet[2]) | (static_cast<size_t>(packet[3]) << 8));
+		if (!cursor.ok)
+			return(stripResult::malformed);
+	}
+	else if (linkType != linkType_ieee80211)
+		return(stripResult::other);
+	/// IEEE 802.11 data frame, not protected and not null, followed by LLC/SNAP
+	size_t frameStart = cursor.pos;
+	uint8_t frameControl = cursor.byte();
+	uint8_t flags = cursor.byte();
+	if (!cursor.ok)
+		return(stripResult::malformed);
+	uint8_t frameType = static_cast<uint8_t>((frameControl >> 2) & 0x03);
+	uint8_t subType = static_cast<uint8_t>(frameControl >> 4);
+	if ((frameType != 2) || ((subType & 0x04) != 0) || ((flags & 0x40) != 0))
+		return(stripResult::other);
+	size_t headerSize = 24;
+	if ((flags & 0x03) == 0x03)
+		headerSize += 6;  /// Address 4
+	if ((subType & 0x08) != 0)
+		headerSize += ((flags & 0x80) != 0) ? 6 : 2;  /// QoS Control, and HT Control
+	cursor.pos = frameStart;
+	cursor.skip(headerSize);
+	uint8_t dsap = cursor.byte();
+	uint8_t ssap = cursor.byte();
+	uint8_t control = cursor.byte();
+	cursor.skip(3);
+	uint16_t etherType = cursor.be16();
+	if (!cursor.ok)
+		return(stripResult::malformed);
+	if ((dsap != 0xAA) || (ssap != 0xAA) || (control != 0x03) || (etherType != etherType_wsmp))
+		return(stripResult::other);
+	cursor.take(cursor.remaining(), wsmpOut);
+	return(stripResult::payload);
+};
+
+bool AsnJ2735Lib::get_wsmData(const uint8_t* buf, size_t size, msgBuf_t& dataOut)
+{
+	hdrCursor_t cursor(buf, size);
+	uint8_t versionByte = cursor.byte();
+	if ((versionByte & 0x07) == 3)
+	{ /// 1609.3-2016: subtype, option indicator and version, then the WSMP-T header
+		if ((versionByte >> 4) != 0)
+			return(false);  /// subtypes other than null networking carry no WSM for J2735
+		if ((versionByte & 0x08) != 0)
+			skipWaveExtensions(cursor);
+		uint8_t tpid = cursor.byte();
+		if (tpid > 3)
+			return(false);
+		if ((tpid & 0x02) != 0)
+			cursor.skip(4);  /// source and destination ports
+		else
+			cursor.skipPsid();
+		if ((tpid & 0x01) != 0)
+			skipWaveExtensions(cursor);
+		size_t length = cursor.varLength();
+		return(cursor.take(length, dataOut));
+	}
+	if (versionByte == 2)
+	{ /// 1609.3-2010: PSID, extension fields of one-byte length, then WSM data with a two-byte length
+		cursor.skipPsid();
+		while (cursor.ok)
+		{
+			uint8_t elementId = cursor.byte();
+			if ((elementId == 128) || (elementId == 129))
+			{
+				size_t length = cursor.be16();
+				return(cursor.take(length, dataOut));
+			}
+			cursor.skip(cursor.byte());
+		}
+	}
+	return(false);
+}
+
+/// payload of Ieee1609Dot2Data (COER): protocolVersion 3, then the content CHOICE. SignedData holds
+/// its payload as a nested Ieee1609Dot2Data, right after hashId and the preamble of SignedDataPayload
+static stripResult strip1609dot2(hdrCursor_t& cursor, AsnJ2735Lib::msgBuf_t& payloadOut, int depth)
+{
+	if ((cursor.byte() != 3) || (depth > 3))
+		return(stripResult::malformed);
+	uint8_t tag = cursor.byte();
+	switch(tag)
+	{
+	case 0x80:  /// unsecuredData
+	{
+		size_t length = cursor.oerLength();
+		return(cursor.take(length, payloadOut) ? stripResult::payload : stripResult::malformed);
+	}
+	case 0x81:  /// signedData
+	{
+		cursor.byte();
+		uint8_t preamble = cursor.byte();
+		if (!cursor.ok)
+			return(stripResult::malformed);
+		if ((preamble & 0x40) == 0)
+			return(stripResult::other);  /// external data hash only
+		return(strip1609dot2(cursor, payloadOut, depth + 1));
+	}
+	case 0x82:  /// encryptedData
+		return(stripResult::encrypted);
+	default:
+		return((cursor.ok) ? stripResult::other : stripResult::malformed);
+	}
+}
+
+bool AsnJ2735Lib::get_1609dot2Payload(const uint8_t* buf, size_t size, msgBuf_t& payloadOut)
+{
+	hdrCursor_t cursor(buf, size);
+	return(strip1609dot2(cursor, payloadOut, 0) == stripResult::payload);
+}
+
+/// WSM data that is IEEE 1609.2 data rather than a MessageFrame. The first byte of a MessageFrame is
+/// the top of a 15-bit messageId, never 3 for a J2735 message
+auto is1609dot2 = [](const AsnJ2735Lib::msgBuf_t& data)->bool
+	{return((data.size >= 2) && (data.buf[0] == 3) && ((data.buf[1] & 0xFC) == 0x80));};
+
+AsnJ2735Lib::CaptureReader::CaptureReader(void) : pFile(NULL), fileSize(0), pos(0), pcapng(false), swapped(false), linkType(0)
+	{stats.reset();}
+
+AsnJ2735Lib::CaptureReader::~CaptureReader(void)
+	{close();}
+
+bool AsnJ2735Lib::CaptureReader::open(const char* fname)
+{
+	close();
+	int fd = ::open(fname, O_RDONLY);
+	if (fd < 0)
+		return(false);
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size < static_cast<off_t>(pcapHeaderSize)))
+	{
+		::close(fd);
+		return(false);
+	}
+	size_t mapSize = static_cast<size_t>(st.st_size);
+	void* pMap = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (pMap == MAP_FAILED)
+		return(false);
+	madvise(pMap, mapSize, MADV_SEQUENTIAL);
+	pFile = static_cast<const uint8_t*>(pMap);
+	fileSize = mapSize;
+	uint32_t magic;
+	std::memcpy(&magic, pFile, sizeof(magic));
+	if (magic == blockType_section)
+		pcapng = true;
+	else if ((magic == pcapMagic_usec) || (magic == pcapMagic_nsec))
+		swapped = false;
+	else if ((__builtin_bswap32(magic) == pcapMagic_usec) || (__builtin_bswap32(magic) == pcapMagic_nsec))
+		swapped = true;
+	else
+	{
+		close();
+		return(false);
+	}
+	if (!pcapng)
+		linkType = get32(pFile + 20);
+	rewind();
+	return(true);
+}
+
+void AsnJ2735Lib::CaptureReader::close(void)
+{
+	if (pFile != NULL)
+		munmap(const_cast<uint8_t*>(pFile), fileSize);
+	pFile = NULL;
+	fileSize = 0;
+	pos = 0;
+	pcapng = false;
+	swapped = false;
+	linkType = 0;
+	ifLinkTypes.clear();
+	stats.reset();
+}
+
+void AsnJ2735Lib::CaptureReader::rewind(void)
+{
+	pos = (pcapng) ? 0 : pcapHeaderSize;
+	ifLinkTypes.clear();
+	stats.reset();
+}
+
+uint32_t AsnJ2735Lib::CaptureReader::get32(const uint8_t* p) const
+{
+	uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return((swapped) ? __builtin_bswap32(value) : value);
+}
+
+uint16_t AsnJ2735Lib::CaptureReader::get16(const uint8_t* p) const
+{
+	uint16_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return((swapped) ? __builtin_bswap16(value) : value);
+}
+
+bool AsnJ2735Lib::CaptureReader::nextPcapRecord(const uint8_t*& packet, size_t& size, uint32_t& recordLinkType)
+{
+	if ((pFile == NULL) || (fileSize - pos < pcapRecordHeaderSize))
+		return(false);
+	size_t capturedSize = get32(pFile + pos + 8);
+	if (capturedSize > fileSize - pos - pcapRecordHeaderSize)
+	{ /// capture cut short while being written
+		stats.numRecords++;
+		stats.numMalformed++;
+		pos = fileSize;
+		return(false);
+	}
+	packet = pFile + pos + pcapRecordHeaderSize;
+	size = capturedSize;
+	recordLinkType = linkType;
+	pos += pcapRecordHeaderSize + capturedSize;
+	return(true);
+}
+
+bool AsnJ2735Lib::CaptureReader::nextPcapngRecord(const uint8_t*& packet, size_t& size, uint32_t& recordLinkType)
+{
+	while ((pFile != NULL) && (fileSize - pos >= 12))
+	{
+		const uint8_t* pBlock = pFile + pos;
+		uint32_t blockType;
+		std::memcpy(&blockType, pBlock, sizeof(blockType));
+		if (blockType == blockType_section)
+		{ /// each section sets its own byte order and interfaces
+			uint32_t byteOrderMagic;
+			std::memcpy(&byteOrderMagic, pBlock + 8, sizeof(byteOrderMagic));
+			if (byteOrderMagic == pcapngByteOrderMagic)
+				swapped = false;
+			else if (__builtin_bswap32(byteOrderMagic) == pcapngByteOrderMagic)
+				swapped = true;
+			else
+				break;
+			ifLinkTypes.clear();
+		}
+		else
+			blockType = get32(pBlock);
+		size_t blockSize = get32(pBlock + 4);
+		if ((blockSize < 12) || ((blockSize & 0x03) != 0) || (blockSize > fileSize - pos))
+			break;
+		pos += blockSize;
+		const uint8_t* pBody = pBlock + 8;
+		size_t bodySize = blockSize - 12;
+		size_t capturedSize;
+		uint32_t ifId = 0;
+		switch(blockType)
+		{
+		case blockType_interface:
+			if (bodySize >= 2)
+				ifLinkTypes.push_back(get16(pBody));
+			continue;
+		case blockType_enhancedPacket:
+		case blockType_packet:
+			if (bodySize < 20)
+			{ /// no room for the interface, timestamp and lengths
+				stats.numRecords++;
+				stats.numMalformed++;
+				continue;
+			}
+			ifId = (blockType == blockType_packet) ? get16(pBody) : get32(pBody);
+			capturedSize = get32(pBody + 12);
+			pBody += 20;
+			bodySize -= 20;
+			break;
+		case blockType_simplePacket:
+			if (bodySize < 4)
+			{ /// no room for the original length
+				stats.numRecords++;
+				stats.numMalformed++;
+				continue;
+			}
+			capturedSize = std::min(static_cast<size_t>(get32(pBody)), bodySize - 4);
+			pBody += 4;
+			bodySize -= 4;
+			break;
+		default:
+			continue;
+		}
+		if ((capturedSize > bodySize) || (ifId >= ifLinkTypes.size()))
+		{
+			stats.numRecords++;
+			stats.numMalformed++;
+			continue;
+		}
+		packet = pBody;
+		size = capturedSize;
+		recordLinkType = ifLinkTypes[ifId];
+		return(true);
+	}
+	if ((pFile != NULL) && (pos < fileSize))
+	{ /// a block that cannot be walked over ends the capture
+		stats.numMalformed++;
+		pos = fileSize;
+	}
+	return(false);
+}
+
+bool AsnJ2735Lib::CaptureReader::next(msgBuf_t& msgOut)
+{
+	const uint8_t* packet;
+	size_t size;
+	uint32_t recordLinkType;
+	while ((pcapng) ? nextPcapngRecord(packet, size, recordLinkType) : nextPcapRecord(packet, size, recordLinkType))
+	{
+		stats.numRecords++;
+		msgBuf_t wsmp;
+		stripResult result = getWsmpFrame(recordLinkType, packet, size, wsmp);
+		if (result == stripResult::other)
+		{
+			stats.numOther++;
+			continue;
+		}
+		if (result != stripResult::payload)
+		{
+			stats.numMalformed++;
+			continue;
+		}
+		msgBuf_t data;
+		if (!get_wsmData(wsmp.buf, wsmp.size, data))
+		{
+			stats.numMalformed++;
+			continue;
+		}
+		stats.numWsm++;
+		if (is1609dot2(data))
+		{
+			hdrCursor_t cursor(data.buf, data.size);
+			result = strip1609dot2(cursor, data, 0);
+			if (result == stripResult::encrypted)
+				stats.numEncrypted++;
+			else if (result == stripResult::other)
+				stats.numOther++;
+			else if (result == stripResult::malformed)
+				stats.numMalformed++;
+			if (result != stripResult::payload)
+				continue;
+			stats.numSecured++;
+		}
+		if (data.size == 0)
+		{
+			stats.numMalformed++;
+			continue;
+		}
+		stats.payloadBytes += data.size;
+		msgOut = data;
+		return(true);
+	}
+	return(false);
+}
+
+size_t AsnJ2735Lib::CaptureReader::read(std::vector<msgBuf_t>& msgs, size_t maxMsgs)
+{
+	size_t numRead = 0;
+	msgBuf_t msg;
+	while ((numRead < maxMsgs) && next(msg))
+	{
+		msgs.push_back(msg);
+		numRead++;
+	}
+	return(numRead);
+}
@@ -0,0 +1,140 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* codecErrors.cpp
+ * Failure accounting of the codec. A failure costs a relaxed atomic increment of its reason counter and a
+ * thread-local store of the last reason. Only when a log sink is set is the clock read, to hold the sink
+ * to its rate: the first maxPerSecond failures of each second go to the sink, the rest are counted.
+ * Nothing here allocates or takes a lock, so a flood of malformed frames does not stall the receiving thread.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+// asn1j2735
+#include "codecErrors.h"
+
+static std::atomic<uint64_t> errorCounts[AsnJ2735Lib::numCodecErrors];
+static std::atomic<uint64_t> numLogged(0);
+static std::atomic<uint64_t> numSuppressed(0);
+static thread_local AsnJ2735Lib::codecError lastError = AsnJ2735Lib::codecError::none;
+
+static std::atomic<AsnJ2735Lib::codecLogSink_t> logSink(NULL);
+static std::atomic<uint32_t> logMaxPerSecond(10);
+static std::atomic<int64_t> logSecond(-1);        /// second of the current rate window
+static std::atomic<uint32_t> numLoggedInSecond(0);
+
+const char* AsnJ2735Lib::codecErrorName(codecError error)
+{
+	switch(error)
+	{
+	case codecError::none:
+		return("none");
+	case codecError::allocFailed:
+		return("allocFailed");
+	case codecError::encodeFailed:
+		return("encodeFailed");
+	case codecError::decodeFailed:
+		return("decodeFailed");
+	case codecError::wrongMsgType:
+		return("wrongMsgType");
+	case codecError::missingElement:
+		return("missingElement");
+	case codecError::invalidValue:
+		return("invalidValue");
+	default:
+		return("unknown");
+	}
+}
+
+AsnJ2735Lib::codecErrorStats_t AsnJ2735Lib::get_codecErrorStats(void)
+{
+	codecErrorStats_t stats;
+	for (size_t i = 0; i < numCodecErrors; i++)
+		stats.counts[i] = errorCounts[i].load(std::memory_order_relaxed);
+	stats.numLogged = numLogged.load(std::memory_order_relaxed);
+	stats.numSuppressed = numSuppressed.load(std::memory_order_relaxed);
+	return(stats);
+}
+
+void AsnJ2735Lib::reset_codecErrorStats(void)
+{
+	for (size_t i = 0; i < numCodecErrors; i++)
+		errorCounts[i].store(0, std::memory_order_relaxed);
+	numLogged.store(0, std::memory_order_relaxed);
+	numSuppressed.store(0, std::memory_order_relaxed);
+}
+
+AsnJ2735Lib::codecError AsnJ2735Lib::get_lastCodecError(void)
+	{return(lastError);}
+
+void AsnJ2735Lib::set_codecLogSink(codecLogSink_t sink, uint32_t maxPerSecond)
+{
+	logMaxPerSecond.store(maxPerSecond, std::memory_order_relaxed);
+	logSink.store(sink, std::memory_order_release);
+}
+
+void AsnJ2735Lib::codecLogSink_stderr(codecError error, const char* where, const char* what, const codecErrorDetail_t& detail)
+{
+	if (detail.numValues == 0)
+	{
+		std::fprintf(stderr, "%s: %s (%s)\n", where, what, codecErrorName(error));
+		return;
+	}
+	std::fprintf(stderr, "%s: %s =", where, what);
+	for (size_t i = 0; i < detail.numValues; i++)
+		std::fprintf(stderr, "%s %lld", (i == 0) ? "" : ",", static_cast<long long>(detail.values[i]));
+	std::fprintf(stderr, " (%s)\n", codecErrorName(error));
+}
+
+/// count the failure and tell whether it goes to the sink, within the log rate
+static AsnJ2735Lib::codecLogSink_t countFailure(AsnJ2735Lib::codecError error)
+{
+	size_t index = static_cast<size_t>(error);
+	if (index < AsnJ2735Lib::numCodecErrors)
+		errorCounts[index].fetch_add(1, std::memory_order_relaxed);
+	lastError = error;
+	AsnJ2735Lib::codecLogSink_t sink = logSink.load(std::memory_order_acquire);
+	if (sink == NULL)
+		return(NULL);
+	int64_t second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	int64_t windowSecond = logSecond.load(std::memory_order_relaxed);
+	if ((second != windowSecond) && logSecond.compare_exchange_strong(windowSecond, second, std::memory_order_relaxed))
+		numLoggedInSecond.store(0, std::memory_order_relaxed);
+	if (numLoggedInSecond.fetch_add(1, std::memory_order_relaxed) >= logMaxPerSecond.load(std::memory_order_relaxed))
+	{
+		numSuppressed.fetch_add(1, std::memory_order_relaxed);
+		return(NULL);
+	}
+	numLogged.fetch_add(1, std::memory_order_relaxed);
+	return(sink);
+}
+
+void AsnJ2735Lib::report_codecError(codecError error, const char* where, const char* what)
+{
+	codecLogSink_t sink = countFailure(error);
+	if (sink == NULL)
+		return;
+	codecErrorDetail_t detail;
+	detail.numValues = 0;
+	sink(error, where, what, detail);
+}
+
+void AsnJ2735Lib::report_codecError(codecError error, const char* where, const char* what, std::initializer_list<int64_t> values)
+{
+	codecLogSink_t sink = countFailure(error);
+	if (sink == NULL)
+		return;
+	codecErrorDetail_t detail;
+	detail.numValues = 0;
+	for (int64_t value : values)
+	{
+		if (detail.numValues == maxCodecErrorValues)
+			break;
+		detail.values[detail.numValues++] = value;
+	}
+	sink(error, where, what, detail);
+}
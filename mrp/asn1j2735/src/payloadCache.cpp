@@ -0,0 +1,67 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* payloadCache.cpp
+ * Hash of a payload for PayloadCache, and decoding through the cache.
+ * The hash takes 8 bytes per multiply-rotate-multiply step and ends with the splitmix64 finalizer. It is
+ * only used within the process, so the byte order of the host does not matter, and a collision costs
+ * no more than one memcmp, as PayloadCache compares the payload bytes of a matching entry.
+ */
+#include <cstring>
+
+// asn1j2735
+#include "AsnJ2735Lib.h"
+#include "payloadCache.h"
+
+uint64_t AsnJ2735Lib::payloadHash(const uint8_t* buf, size_t size)
+{
+	const uint64_t k0 = 0x9E3779B97F4A7C15ULL;
+	const uint64_t k1 = 0xBF58476D1CE4E5B9ULL;
+	const uint64_t k2 = 0x94D049BB133111EBULL;
+	uint64_t hash = static_cast<uint64_t>(size) * k0;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t word;
+		std::memcpy(&word, buf + i, sizeof(word));
+		hash ^= word * k1;
+		hash = ((hash << 31) | (hash >> 33)) * k2;
+	}
+	uint64_t tail = 0;
+	for (size_t j = 0; i + j < size; j++)
+		tail |= static_cast<uint64_t>(buf[i + j]) << (8 * j);
+	hash ^= tail * k1;
+	hash ^= hash >> 30;
+	hash *= k1;
+	hash ^= hash >> 27;
+	hash *= k2;
+	hash ^= hash >> 31;
+	return(hash);
+}
+
+size_t AsnJ2735Lib::CachedDecoder::decode(const uint8_t* buf, size_t size, const Frame_element_t*& pFrameOut, bool& isRepeat)
+{
+	pFrameOut = NULL;
+	isRepeat = false;
+	decodedFrame_t* pDecoded = cache.find(buf, size);
+	if (pDecoded != NULL)
+	{
+		isRepeat = true;
+		pFrameOut = &pDecoded->dsrcFrame;
+		return(pDecoded->consumed);
+	}
+	pDecoded = cache.insert(buf, size);
+	if (pDecoded == NULL)
+		return(0);
+	pDecoded->consumed = decode_msgFrame_direct(buf, size, pDecoded->dsrcFrame);
+	if (pDecoded->consumed == 0)
+	{
+		cache.erase(pDecoded);
+		return(0);
+	}
+	pFrameOut = &pDecoded->dsrcFrame;
+	return(pDecoded->consumed);
+}
@@ -0,0 +1,186 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* streamDecoder.cpp
+ * Decoding of a stream of length-prefixed message frames out of a caller-owned ring buffer.
+ * The bytes held always lie in one piece between readPos and writePos, so a complete frame is decoded
+ * where it was read to. When the free space at the end of the ring is too short for the rest of the
+ * unfinished frame, that frame is moved to the start of the ring; the frames before it have been
+ * handed out by then, so at most one frame is moved, and only after a full lap of the ring.
+ * A frame given up on (at the deadline, or longer than the ring) is dropped as it arrives: skipBytes
+ * counts its bytes yet to come, and isFlushed marks one whose length is not known yet.
+ */
+#include <cstring>
+
+// asn1j2735
+#include "streamDecoder.h"
+
+/// size of the length prefix
+static const size_t lengthSize = 2;
+
+/// the length prefix at p, in network byte order
+auto getFrameLength = [](const uint8_t* p)->size_t
+	{return(static_cast<size_t>((p[0] << 8) | p[1]));};
+
+const size_t AsnJ2735Lib::StreamDecoder::minCapacity;
+
+AsnJ2735Lib::StreamDecoder::StreamDecoder(uint8_t* ring, size_t size, std::chrono::milliseconds latency)
+	: pRing(ring), capacity(size), readPos(0), writePos(0), skipBytes(0), isFlushed(false), maxLatency(latency)
+{ // a ring too short to hold the length prefix and one more byte could never complete a frame
+	if ((ring == nullptr) || (size < minCapacity))
+		capacity = 0;
+	stats.reset();
+}
+
+uint8_t* AsnJ2735Lib::StreamDecoder::getWriteBuf(size_t& sizeOut)
+{
+	size_t held = writePos - readPos;
+	if (held == 0)
+	{ // nothing held, start over at the start of the ring
+		readPos = 0;
+		writePos = 0;
+	}
+	else if (readPos > 0)
+	{ // the rest of the frame at readPos has to fit after writePos
+		size_t needed = lengthSize - held;
+		if (held >= lengthSize)
+		{
+			size_t frameSize = lengthSize + getFrameLength(pRing + readPos);
+			needed = (frameSize > held) ? frameSize - held : 0;
+		}
+		if (needed > capacity - writePos)
+		{
+			std::memmove(pRing, pRing + readPos, held);
+			readPos = 0;
+			writePos = held;
+			stats.numCompactions++;
+			stats.bytesMoved += held;
+		}
+	}
+	sizeOut = capacity - writePos;
+	return(pRing + writePos);
+}
+
+void AsnJ2735Lib::StreamDecoder::commit(size_t numBytes)
+{
+	if (numBytes == 0)
+		return;
+	if (writePos + numBytes > capacity)
+		numBytes = capacity - writePos;
+	if (maxLatency.count() > 0)
+	{
+		lastCommit = std::chrono::steady_clock::now();
+		if ((writePos == readPos) && (skipBytes < numBytes))
+			frameStart = lastCommit;
+	}
+	writePos += numBytes;
+	if (skipBytes > 0)
+	{ // bytes of a dropped frame, nothing else is held when skipBytes > 0
+		size_t numSkipped = (skipBytes < numBytes) ? skipBytes : numBytes;
+		readPos += numSkipped;
+		skipBytes -= numSkipped;
+		stats.bytesSkipped += numSkipped;
+	}
+}
+
+bool AsnJ2735Lib::StreamDecoder::next(decodeResult_t& resultOut)
+{
+	if ((maxLatency.count() > 0) && (writePos > readPos))
+		return(next(resultOut, std::chrono::steady_clock::now()));
+	return(next(resultOut, std::chrono::steady_clock::time_point()));
+}
+
+bool AsnJ2735Lib::StreamDecoder::next(decodeResult_t& resultOut, std::chrono::steady_clock::time_point now)
+{
+	size_t held = writePos - readPos;
+	if ((held >= lengthSize) && isFlushed)
+	{ // the length of the frame flushed with its first byte only has arrived
+		dropFrame();
+		held = writePos - readPos;
+	}
+	if (held >= lengthSize)
+	{
+		size_t frameSize = lengthSize + getFrameLength(pRing + readPos);
+		if (frameSize > capacity)
+		{
+			report_codecError(codecError::decodeFailed, "StreamDecoder::next", "frame longer than the ring");
+			stats.numOversized++;
+			handOutFailed(resultOut);
+			dropFrame();
+			return(true);
+		}
+		if (frameSize <= held)
+		{
+			const uint8_t* payload = pRing + readPos + lengthSize;
+			if (frameSize == lengthSize)
+			{
+				resultOut.dsrcFrame.reset();
+				resultOut.status = decodeStatus::empty;
+				resultOut.consumed = 0;
+				resultOut.error = codecError::none;
+			}
+			else
+			{
+				resultOut.consumed = decode_msgFrame_direct(payload, frameSize - lengthSize, resultOut.dsrcFrame);
+				resultOut.status = (resultOut.consumed > 0) ? decodeStatus::decoded : decodeStatus::failed;
+				resultOut.error = (resultOut.consumed > 0) ? codecError::none : get_lastCodecError();
+			}
+			stats.numFrames++;
+			if (resultOut.status == decodeStatus::decoded)
+				stats.numDecoded++;
+			else if (resultOut.status == decodeStatus::failed)
+				stats.numFailed++;
+			readPos += frameSize;
+			// the bytes after the frame arrived with the last commit at the latest
+			frameStart = lastCommit;
+			return(true);
+		}
+	}
+	if ((held > 0) && !isFlushed && (maxLatency.count() > 0) && (now - frameStart >= maxLatency))
+	{
+		report_codecError(codecError::decodeFailed, "StreamDecoder::next", "frame unfinished at the deadline");
+		stats.numFlushed++;
+		handOutFailed(resultOut);
+		dropFrame();
+		return(true);
+	}
+	return(false);
+}
+
+void AsnJ2735Lib::StreamDecoder::reset(void)
+{
+	readPos = 0;
+	writePos = 0;
+	skipBytes = 0;
+	isFlushed = false;
+}
+
+void AsnJ2735Lib::StreamDecoder::handOutFailed(decodeResult_t& resultOut)
+{
+	resultOut.dsrcFrame.reset();
+	resultOut.status = decodeStatus::failed;
+	resultOut.consumed = 0;
+	resultOut.error = codecError::decodeFailed;
+	stats.numFrames++;
+	stats.numFailed++;
+}
+
+void AsnJ2735Lib::StreamDecoder::dropFrame(void)
+{
+	size_t held = writePos - readPos;
+	if (held < lengthSize)
+	{ // drop it once its length is known
+		isFlushed = true;
+		return;
+	}
+	size_t frameSize = lengthSize + getFrameLength(pRing + readPos);
+	size_t numDropped = (held < frameSize) ? held : frameSize;
+	readPos += numDropped;
+	skipBytes = frameSize - numDropped;
+	isFlushed = false;
+	stats.bytesSkipped += numDropped;
+	frameStart = lastCommit;
+}
@@ -0,0 +1,1369 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* uperDirect.cpp
+ * Hand-specialised UPER decoders that read the BSM, SPaT, SRM, SSM and RTCM bit streams straight into
+ * the dsrc element structures, and encoders that write BSM, SPaT and RTCM straight from them, without
+ * building the asn1c MessageFrame tree.
+ * The layouts follow SAE J2735_201603 as compiled in mrp/asn1. Whenever an encoding falls outside what
+ * these decoders handle (extension values of extensible types, out-of-range values, messages that the
+ * asn1c path would reject), decode_msgFrame_direct falls back to the asn1c path, so both paths always
+ * return the same result. Likewise encode_msgFrame_direct falls back to encode_msgFrame on values that
+ * violate a constraint, and writes the same optional members as encode_msgFrame does.
+ * BSM Part II contents are not kept, but vehicleSafetyExt is read through to be checked as the asn1c path
+ * checks it; the other Part II contents and regional extensions are passed on to the asn1c path, which
+ * validates the former and rejects the latter. decode_msgFrame_lazy
+ * instead skips them by their length determinants and notes where those of BSM are, so that a caller can
+ * take out the ones it needs with get_openTypeValue and decode them by their own type.
+ * SpatEncoder keeps the last SPaT it encoded, with the bit positions of its fields, and writes only those
+ * fields into it as long as the signal groups and optional members stay the same.
+ * decode_rtcm_view and encode_rtcm_view work on RTCMview_t, which refers to the RTCMmessage octets
+ * where they are, in the received MessageFrame or in the caller's buffer, instead of copying them.
+ * encode<T> and decode<T> are the same paths for a single message type, on its element structure alone
+ * instead of a Frame_element_t.
+ * peek_msgFrame reads the same layouts only as far as the message id, the first intersection reference
+ * and its revision (or the BSM temporary ID), for routing and filtering frames.
+ */
+#include <bitset>
+#include <cstring>
+
+// asn1j2735
+#include "AsnJ2735Lib.h"
+#include "dsrcConsts.h"
+#include "uperBits.h"
+
+using AsnJ2735Lib::codecError;
+using AsnJ2735Lib::report_codecError;
+using UperBits::Reader;
+using UperBits::Writer;
+
+/// reverse bit-order of the nbits least significant bits (BIT STRING to bitset)
+auto reverseBits = [](uint32_t value, unsigned int nbits)->unsigned long
+{
+	unsigned long ret = 0;
+	for (unsigned int i = 0; i < nbits; i++)
+		ret |= ((value >> (nbits - 1 - i)) & 1UL) << i;
+	return(ret);
+};
+
+/// IntersectionReferenceID
+auto uper2intersectionReferenceId = [](Reader& rd, uint16_t& regionalId, uint16_t& id)->void
+{
+	bool hasRegion = rd.getBit();
+	if (hasRegion)
+		regionalId = static_cast<uint16_t>(rd.get(16));
+	id = static_cast<uint16_t>(rd.get(16));
+};
+
+/// IntersectionAccessPoint CHOICE {lane, approach, connection, ...}
+auto uper2intersectionAccessPoint = [](Reader& rd, uint8_t& approachId, uint8_t& laneId)->void
+{
+	switch(rd.getExtRange(0, 2, 2))
+	{
+	case 0:
+		laneId = static_cast<uint8_t>(rd.get(8));
+		break;
+	case 1:
+		approachId = static_cast<uint8_t>(rd.get(4));
+		break;
+	default:
+		rd.get(8);
+		break;
+	}
+};
+
+/// VehicleID CHOICE {entityID, stationID}, only TemporaryID is accepted
+auto uper2vehicleId = [](Reader& rd, uint32_t& vehId)->void
+{
+	if (rd.getBit())
+	{ // asn1c path rejects stationID
+		rd.fail();
+		return;
+	}
+	vehId = rd.get(32);
+};
+
+/// RequestorType
+auto uper2requestorType = [](Reader& rd, MsgEnum::basicRole& role, MsgEnum::vehicleType& vehType, bool& hasVehType)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(5);
+	role = static_cast<MsgEnum::basicRole>(rd.getExtRange(0, 22, 5));
+	if (presence & 0x10)
+		rd.get(4);   // subrole
+	if (presence & 0x08)
+		rd.get(4);   // request
+	if (presence & 0x04)
+		rd.getRange(0, 100, 7);   // iso3883
+	hasVehType = ((presence & 0x02) != 0);
+	if (hasVehType)
+		vehType = static_cast<MsgEnum::vehicleType>(rd.getExtRange(0, 15, 4));
+	if (presence & 0x01)
+		rd.skipRegional();
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// PositionalAccuracy, read for validation only: semiMajor, semiMinor and orientation take their full ranges
+auto checkPositionalAccuracy = [](Reader& rd)->void
+	{rd.skip(8 + 8 + 16);};
+
+/// FullPositionVector, read for validation only
+auto checkFullPositionVector = [](Reader& rd)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(8);
+	if (presence & 0x80)
+	{ // utcTime DDateTime
+		uint32_t timePresence = rd.getPresence(7);
+		if (timePresence & 0x40)
+			rd.skip(12);                 // year
+		if (timePresence & 0x20)
+			rd.getRange(0, 12, 4);       // month
+		if (timePresence & 0x10)
+			rd.skip(5);                  // day
+		if (timePresence & 0x08)
+			rd.skip(5);                  // hour
+		if (timePresence & 0x04)
+			rd.getRange(0, 60, 6);       // minute
+		if (timePresence & 0x02)
+			rd.skip(16);                 // second
+		if (timePresence & 0x01)
+			rd.getRange(-840, 840, 11);  // offset
+	}
+	rd.getRange(-1799999999, 1800000001, 32);
+	rd.getRange(-900000000, 900000001, 31);
+	if (presence & 0x40)
+		rd.getRange(-4096, 61439, 16);   // elevation
+	if (presence & 0x20)
+		rd.getRange(0, 28800, 15);       // heading
+	if (presence & 0x10)
+		rd.skip(3 + 13);                 // speed TransmissionAndSpeed
+	if (presence & 0x08)
+		checkPositionalAccuracy(rd);
+	if (presence & 0x04)
+		rd.getRange(0, 39, 6);           // timeConfidence
+	if (presence & 0x02)
+		rd.skip(4 + 4);                  // posConfidence
+	if (presence & 0x01)
+		rd.skip(3 + 3 + 2);              // speedConfidence
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// PathHistory, read for validation only
+auto checkPathHistory = [](Reader& rd)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(2);
+	if (presence & 0x02)
+		checkFullPositionVector(rd);
+	if (presence & 0x01)
+		rd.skip(8);                      // currGNSSstatus
+	int64_t count = rd.getRange(1, 23, 5);
+	for (int64_t i = 0; (i < count) && rd.ok(); i++)
+	{ // PathHistoryPoint
+		bool hasPointExt = rd.getBit();
+		uint32_t pointPresence = rd.getPresence(3);
+		rd.skip(18 + 18 + 12);           // latOffset, lonOffset, elevationOffset
+		rd.getRange(1, 65535, 16);       // timeOffset
+		if (pointPresence & 0x04)
+			rd.skip(13);                 // speed
+		if (pointPresence & 0x02)
+			checkPositionalAccuracy(rd);
+		if (pointPresence & 0x01)
+			rd.getRange(0, 240, 8);      // heading
+		if (hasPointExt)
+			rd.skipExtensions();
+	}
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// VehicleSafetyExtensions, read for validation only. Extension values of events and lights
+/// fail, as the other extensible types do
+auto checkVehicleSafetyExt = [](Reader& rd)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(4);
+	if (presence & 0x08)
+	{ // events VehicleEventFlags (SIZE(13, ...))
+		if (rd.getBit())
+			rd.fail();
+		rd.skip(13);
+	}
+	if (presence & 0x04)
+		checkPathHistory(rd);
+	if (presence & 0x02)
+	{ // pathPrediction
+		bool hasPredictionExt = rd.getBit();
+		rd.getRange(-32767, 32767, 16);  // radiusOfCurve
+		rd.getRange(0, 200, 8);          // confidence
+		if (hasPredictionExt)
+			rd.skipExtensions();
+	}
+	if (presence & 0x01)
+	{ // lights ExteriorLights (SIZE(9, ...))
+		if (rd.getBit())
+			rd.fail();
+		rd.skip(9);
+	}
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// PartIIcontent value. vehicleSafetyExt, which nearly every BSM with Part II carries, is checked here
+/// as the asn1c path checks it: within its length, with less than 8 zero bits of padding.
+/// specialVehicleExt and supplementalVehicleExt fail to the asn1c path, as does an unknown PartII-Id,
+/// which the asn1c path rejects
+auto checkPartIIcontent = [](Reader& rd, uint8_t id)->void
+{
+	if (id != 0)
+	{
+		rd.fail();
+		return;
+	}
+	size_t end = rd.enterOpenType();
+	checkVehicleSafetyExt(rd);
+	rd.leaveOpenType(end);
+};
+
+/// skip an open type value, noting where it is in pRefs when not NULL
+auto uper2openTypeRef = [](Reader& rd, uint8_t id, std::vector<AsnJ2735Lib::openTypeRef_t>* pRefs)->void
+{
+	size_t numBytes = rd.getLength();
+	size_t bitPos = rd.position();
+	rd.skip(numBytes * 8);
+	if ((pRefs != NULL) && rd.ok())
+		pRefs->push_back({id, bitPos, numBytes});
+};
+
+/// BasicSafetyMessage to BSM_element_t. Part II contents are checked, and regional extensions fail to
+/// the asn1c path; in a lazy Reader both are skipped and noted in pExt when not NULL
+auto uper2bsm = [](Reader& rd, BSM_element_t& bsmOut, AsnJ2735Lib::bsmExtensions_t* pExt)->bool
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(2);
+	// BSMcoreData
+	bsmOut.msgCnt = static_cast<uint8_t>(rd.get(7));
+	bsmOut.id = rd.get(32);
+	bsmOut.timeStampSec = static_cast<uint16_t>(rd.get(16));
+	bsmOut.latitude = static_cast<int32_t>(rd.getRange(-900000000, 900000001, 31));
+	bsmOut.longitude = static_cast<int32_t>(rd.getRange(-1799999999, 1800000001, 32));
+	bsmOut.elevation = static_cast<int32_t>(rd.getRange(-4096, 61439, 16));
+	bsmOut.semiMajor = static_cast<uint8_t>(rd.get(8));
+	bsmOut.semiMinor = static_cast<uint8_t>(rd.get(8));
+	bsmOut.orientation = static_cast<uint16_t>(rd.get(16));
+	bsmOut.transState = static_cast<MsgEnum::transGear>(rd.get(3));
+	bsmOut.speed = static_cast<uint16_t>(rd.get(13));
+	bsmOut.heading = static_cast<uint16_t>(rd.getRange(0, 28800, 15));
+	bsmOut.steeringAngle = static_cast<int8_t>(rd.getRange(-126, 127, 8));
+	bsmOut.accelLon = static_cast<int16_t>(rd.getRange(-2000, 2001, 12));
+	bsmOut.accelLat = static_cast<int16_t>(rd.getRange(-2000, 2001, 12));
+	bsmOut.accelVert = static_cast<int8_t>(rd.getRange(-127, 127, 8));
+	bsmOut.yawRate = static_cast<int16_t>(rd.getRange(-32767, 32767, 16));
+	bsmOut.brakeAppliedStatus = std::bitset<5>(reverseBits(rd.get(5), 5));
+	bsmOut.tractionControlStatus = static_cast<MsgEnum::engageStatus>(rd.get(2));
+	bsmOut.absStatus = static_cast<MsgEnum::engageStatus>(rd.get(2));
+	bsmOut.stabilityControlStatus = static_cast<MsgEnum::engageStatus>(rd.get(2));
+	bsmOut.brakeBoostApplied = static_cast<MsgEnum::engageStatus>(rd.getRange(0, 2, 2));
+	bsmOut.auxiliaryBrakeStatus = static_cast<MsgEnum::engageStatus>(rd.get(2));
+	bsmOut.vehWidth = static_cast<uint16_t>(rd.get(10));
+	bsmOut.vehLen = static_cast<uint16_t>(rd.get(12));
+	// partII: SEQUENCE (SIZE(1..8)) OF PartIIcontent
+	if (presence & 0x02)
+	{
+		size_t count = rd.get(3) + 1;
+		for (size_t i = 0; i < count; i++)
+		{
+			uint8_t partIIid = static_cast<uint8_t>(rd.get(6));
+			if (rd.isLazy())
+				uper2openTypeRef(rd, partIIid, (pExt != NULL) ? &pExt->partII : NULL);
+			else
+				checkPartIIcontent(rd, partIIid);
+		}
+	}
+	// regional: SEQUENCE (SIZE(1..4)) OF RegionalExtension
+	if ((presence & 0x01) && !rd.isLazy())
+		rd.fail();
+	if (presence & 0x01)
+	{
+		size_t count = rd.get(2) + 1;
+		for (size_t i = 0; i < count; i++)
+		{
+			uint8_t regionId = static_cast<uint8_t>(rd.get(8));
+			uper2openTypeRef(rd, regionId, (pExt != NULL) ? &pExt->regional : NULL);
+		}
+	}
+	if (hasExt)
+		rd.skipExtensions();
+	return(rd.ok());
+};
+
+/// MovementEvent to MovementEvent_element_t
+auto uper2movementEvent = [](Reader& rd, MovementEvent_element_t& eventOut)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(3);
+	eventOut.currState = static_cast<MsgEnum::phaseState>(rd.getRange(0, 9, 4));
+	if (presence & 0x04)
+	{ // TimeChangeDetails
+		uint32_t timing = rd.getPresence(5);
+		if (timing & 0x10)
+			eventOut.startTime = static_cast<uint16_t>(rd.getRange(0, 36001, 16));
+		eventOut.minEndTime = static_cast<uint16_t>(rd.getRange(0, 36001, 16));
+		if (timing & 0x08)
+			eventOut.maxEndTime = static_cast<uint16_t>(rd.getRange(0, 36001, 16));
+		if (timing & 0x04)
+			rd.getRange(0, 36001, 16);  // likelyTime
+		if (timing & 0x02)
+			rd.get(4);                  // confidence
+		if (timing & 0x01)
+			rd.getRange(0, 36001, 16);  // nextTime
+	}
+	if (presence & 0x02)
+	{ // AdvisorySpeedList
+		size_t count = rd.get(4) + 1;
+		for (size_t i = 0; i < count; i++)
+		{
+			bool speedExt = rd.getBit();
+			uint32_t speedPresence = rd.getPresence(5);
+			rd.getExtRange(0, 3, 2);           // type
+			if (speedPresence & 0x10)
+				rd.getRange(0, 500, 9);          // speed
+			if (speedPresence & 0x08)
+				rd.get(3);                       // confidence
+			if (speedPresence & 0x04)
+				rd.getRange(0, 10000, 14);       // distance
+			if (speedPresence & 0x02)
+				rd.get(8);                       // class
+			if (speedPresence & 0x01)
+				rd.skipRegionalList();
+			if (speedExt)
+				rd.skipExtensions();
+		}
+	}
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// ManeuverAssistList
+auto skipManeuverAssistList = [](Reader& rd)->void
+{
+	size_t count = rd.get(4) + 1;
+	for (size_t i = 0; i < count; i++)
+	{
+		bool hasExt = rd.getBit();
+		uint32_t presence = rd.getPresence(5);
+		rd.get(8);                    // connectionID
+		if (presence & 0x10)
+			rd.getRange(0, 10000, 14);  // queueLength
+		if (presence & 0x08)
+			rd.getRange(0, 10000, 14);  // availableStorageLength
+		if (presence & 0x04)
+			rd.get(1);                  // waitOnStop
+		if (presence & 0x02)
+			rd.get(1);                  // pedBicycleDetect
+		if (presence & 0x01)
+			rd.skipRegionalList();
+		if (hasExt)
+			rd.skipExtensions();
+	}
+};
+
+/// IntersectionState to IntersectionState_element_t
+auto uper2intersectionState = [](Reader& rd, IntersectionState_element_t& spatOut)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(6);
+	if (presence & 0x20)
+		rd.skipDescriptiveName();
+	uper2intersectionReferenceId(rd, spatOut.regionalId, spatOut.id);
+	spatOut.msgCnt = static_cast<uint8_t>(rd.get(7));
+	spatOut.status = std::bitset<16>(reverseBits(rd.get(16), 16));
+	if (presence & 0x10)
+		spatOut.timeStampMinute = static_cast<uint32_t>(rd.getRange(0, 527040, 20));
+	if (presence & 0x08)
+		spatOut.timeStampSec = static_cast<uint16_t>(rd.get(16));
+	if (presence & 0x04)
+	{ // EnabledLaneList
+		size_t count = rd.get(4) + 1;
+		rd.skip(count * 8);
+	}
+	// MovementList
+	size_t numStates = rd.get(8) + 1;
+	for (size_t i = 0; (i < numStates) && rd.ok(); i++)
+	{
+		bool stateExt = rd.getBit();
+		uint32_t statePresence = rd.getPresence(3);
+		if (statePresence & 0x04)
+			rd.skipDescriptiveName();
+		uint32_t signalGroup = rd.get(8);
+		if ((signalGroup < 1) || (signalGroup > 2 * 8))
+		{ // asn1c path reports invalid SignalGroupID
+			rd.fail();
+			break;
+		}
+		size_t j = (signalGroup - 1) % 8;
+		PhaseState_element_t& phaseState = (signalGroup > 8) ? spatOut.pedPhaseState[j] : spatOut.phaseState[j];
+		if (signalGroup > 8)
+			spatOut.permittedPedPhases.set(j);
+		else
+			spatOut.permittedPhases.set(j);
+		// MovementEventList
+		size_t numEvents = rd.get(4) + 1;
+		spatOut.setNumNextEvents(phaseState, numEvents - 1);
+		for (size_t k = 0; (k < numEvents) && rd.ok(); k++)
+			uper2movementEvent(rd, spatOut.event(phaseState, k));
+		if (statePresence & 0x02)
+			skipManeuverAssistList(rd);
+		if (statePresence & 0x01)
+			rd.skipRegionalList();
+		if (stateExt)
+			rd.skipExtensions();
+	}
+	if (presence & 0x02)
+		skipManeuverAssistList(rd);
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// SPAT to SPAT_element_t
+auto uper2spat = [](Reader& rd, SPAT_element_t& spatOut)->bool
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(3);
+	if (presence & 0x04)
+		rd.getRange(0, 527040, 20);  // timeStamp
+	if (presence & 0x02)
+		rd.skipDescriptiveName();
+	size_t count = rd.get(5) + 1;
+	spatOut.moreIntersections.resize(count - 1);
+	for (size_t i = 0; (i < count) && rd.ok(); i++)
+	{
+		if (i > 0)
+			spatOut.intersection(i).reset();
+		uper2intersectionState(rd, spatOut.intersection(i));
+	}
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+	return(rd.ok());
+};
+
+/// SignalRequestPackage to SignalRequest_element_t
+auto uper2signalRequestPackage = [](Reader& rd, SignalRequest_element_t& srmOut)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(4);
+	// SignalRequest
+	bool reqExt = rd.getBit();
+	uint32_t reqPresence = rd.getPresence(2);
+	uper2intersectionReferenceId(rd, srmOut.regionalId, srmOut.intId);
+	srmOut.reqId = static_cast<uint8_t>(rd.get(8));
+	srmOut.reqType = static_cast<MsgEnum::requestType>(rd.getExtRange(0, 3, 2));
+	uper2intersectionAccessPoint(rd, srmOut.inApprochId, srmOut.inLaneId);
+	if (reqPresence & 0x02)
+		uper2intersectionAccessPoint(rd, srmOut.outApproachId, srmOut.outLaneId);
+	if (reqPresence & 0x01)
+		rd.skipRegionalList();
+	if (reqExt)
+		rd.skipExtensions();
+	if (presence & 0x08)
+		srmOut.ETAminute = static_cast<uint32_t>(rd.getRange(0, 527040, 20));
+	if (presence & 0x04)
+		srmOut.ETAsec = static_cast<uint16_t>(rd.get(16));
+	if (presence & 0x02)
+		srmOut.duration = static_cast<uint16_t>(rd.get(16));
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// SignalRequestMessage to SRM_element_t
+auto uper2srm = [](Reader& rd, SRM_element_t& srmOut)->bool
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(4);
+	if (presence & 0x08)
+		srmOut.timeStampMinute = static_cast<uint32_t>(rd.getRange(0, 527040, 20));
+	srmOut.timeStampSec = static_cast<uint16_t>(rd.get(16));
+	if (presence & 0x04)
+		srmOut.msgCnt = static_cast<uint8_t>(rd.get(7));
+	if ((presence & 0x02) == 0)
+	{ // asn1c path reports missing SignalRequestList
+		rd.fail();
+		return(false);
+	}
+	size_t count = rd.get(5) + 1;
+	srmOut.moreRequests.resize(count - 1);
+	for (size_t i = 0; (i < count) && rd.ok(); i++)
+	{
+		if (i > 0)
+			srmOut.request(i).reset();
+		uper2signalRequestPackage(rd, srmOut.request(i));
+	}
+	// RequestorDescription
+	bool descExt = rd.getBit();
+	uint32_t descPresence = rd.getPresence(8);
+	uper2vehicleId(rd, srmOut.vehId);
+	if ((descPresence & 0x80) == 0)
+	{ // asn1c path reports missing RequestorType
+		rd.fail();
+		return(false);
+	}
+	bool hasVehType = false;
+	uper2requestorType(rd, srmOut.vehRole, srmOut.vehType, hasVehType);
+	if (!hasVehType || ((descPresence & 0x40) == 0))
+	{ // asn1c path reports missing VehicleType or RequestorPositionVector
+		rd.fail();
+		return(false);
+	}
+	// RequestorPositionVector
+	bool posExt = rd.getBit();
+	uint32_t posPresence = rd.getPresence(2);
+	bool position3dExt = rd.getBit();
+	uint32_t position3dPresence = rd.getPresence(2);
+	srmOut.latitude = static_cast<int32_t>(rd.getRange(-900000000, 900000001, 31));
+	srmOut.longitude = static_cast<int32_t>(rd.getRange(-1799999999, 1800000001, 32));
+	if (position3dPresence & 0x02)
+		srmOut.elevation = static_cast<int32_t>(rd.getRange(-4096, 61439, 16));
+	if (position3dPresence & 0x01)
+		rd.skipRegionalList();
+	if (position3dExt)
+		rd.skipExtensions();
+	if ((posPresence & 0x03) != 0x03)
+	{ // asn1c path reports missing heading or TransmissionAndSpeed
+		rd.fail();
+		return(false);
+	}
+	srmOut.heading = static_cast<uint16_t>(rd.getRange(0, 28800, 15));
+	srmOut.transState = static_cast<MsgEnum::transGear>(rd.get(3));
+	srmOut.speed = static_cast<uint16_t>(rd.get(13));
+	if (posExt)
+		rd.skipExtensions();
+	if (descPresence & 0x20)
+		rd.skipDescriptiveName();     // name
+	if (descPresence & 0x10)
+		rd.skipDescriptiveName();     // routeName
+	if (descPresence & 0x08)
+		rd.get(8);                    // transitStatus
+	if (descPresence & 0x04)
+		rd.get(3);                    // transitOccupancy
+	if (descPresence & 0x02)
+		rd.getRange(-122, 121, 8);    // transitSchedule
+	if (descPresence & 0x01)
+		rd.skipRegionalList();
+	if (descExt)
+		rd.skipExtensions();
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+	return(rd.ok());
+};
+
+/// SignalStatusPackage to SignalRequetStatus_t
+auto uper2signalStatusPackage = [](Reader& rd, SignalRequetStatus_t& requestStatus)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(6);
+	if ((presence & 0x20) == 0)
+	{ // asn1c path reports missing SignalRequesterInfo
+		rd.fail();
+		return;
+	}
+	// SignalRequesterInfo
+	bool infoExt = rd.getBit();
+	uint32_t infoPresence = rd.getPresence(2);
+	uper2vehicleId(rd, requestStatus.vehId);
+	requestStatus.reqId = static_cast<uint8_t>(rd.get(8));
+	requestStatus.sequenceNumber = static_cast<uint8_t>(rd.get(7));
+	requestStatus.vehRole = (infoPresence & 0x02) ?
+		static_cast<MsgEnum::basicRole>(rd.getExtRange(0, 22, 5)) : MsgEnum::basicRole::unavailable;
+	if (infoPresence & 0x01)
+	{
+		MsgEnum::basicRole role;
+		MsgEnum::vehicleType vehType;
+		bool hasVehType;
+		uper2requestorType(rd, role, vehType, hasVehType);
+	}
+	if (infoExt)
+		rd.skipExtensions();
+	uper2intersectionAccessPoint(rd, requestStatus.inApprochId, requestStatus.inLaneId);
+	if (presence & 0x10)
+		uper2intersectionAccessPoint(rd, requestStatus.outApproachId, requestStatus.outLaneId);
+	if (presence & 0x08)
+		requestStatus.ETAminute = static_cast<uint32_t>(rd.getRange(0, 527040, 20));
+	if (presence & 0x04)
+		requestStatus.ETAsec = static_cast<uint16_t>(rd.get(16));
+	if (presence & 0x02)
+		requestStatus.duration = static_cast<uint16_t>(rd.get(16));
+	requestStatus.status = static_cast<MsgEnum::requestStatus>(rd.getExtRange(0, 7, 3));
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// SignalStatus to SSM_element_t
+auto uper2signalStatus = [](Reader& rd, SSM_element_t& ssmOut)->void
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(1);
+	ssmOut.updateCnt = static_cast<uint8_t>(rd.get(7));
+	uper2intersectionReferenceId(rd, ssmOut.regionalId, ssmOut.id);
+	size_t count = rd.get(5) + 1;
+	ssmOut.mpSignalRequetStatus.resize(count);
+	for (auto& requestStatus : ssmOut.mpSignalRequetStatus)
+	{
+		requestStatus.reset();
+		uper2signalStatusPackage(rd, requestStatus);
+	}
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+};
+
+/// SignalStatusMessage to SSM_element_t, only the first SignalStatus is kept
+auto uper2ssm = [](Reader& rd, SSM_element_t& ssmOut)->bool
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(3);
+	if (presence & 0x04)
+		ssmOut.timeStampMinute = static_cast<uint32_t>(rd.getRange(0, 527040, 20));
+	ssmOut.timeStampSec = static_cast<uint16_t>(rd.get(16));
+	if (presence & 0x02)
+		ssmOut.msgCnt = static_cast<uint8_t>(rd.get(7));
+	size_t count = rd.get(5) + 1;
+	uper2signalStatus(rd, ssmOut);
+	SSM_element_t ssmOther;
+	for (size_t i = 1; (i < count) && rd.ok(); i++)
+		uper2signalStatus(rd, ssmOther);
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+	return(rd.ok());
+};
+
+/// RTCMcorrections to RTCMview_t, referring to the first RTCMmessage and skipping the others.
+/// anchorPoint (FullPositionVector) is not read here
+auto uper2rtcm = [](Reader& rd, RTCMview_t& rtcmOut)->bool
+{
+	bool hasExt = rd.getBit();
+	uint32_t presence = rd.getPresence(4);
+	if (presence & 0x04)
+		return(false);
+	rtcmOut.msgCnt = static_cast<uint8_t>(rd.get(7));
+	rtcmOut.rev = static_cast<uint8_t>(rd.getExtRange(0, 3, 2));
+	if (presence & 0x08)
+		rtcmOut.timeStampMinute = static_cast<uint32_t>(rd.getRange(0, 527040, 20));
+	if (presence & 0x02)
+		rd.skip(39);  // RTCMheader: GNSSstatus and AntennaOffsetSet
+	size_t count = static_cast<size_t>(rd.getRange(1, 5, 3));
+	for (size_t i = 0; (i < count) && rd.ok(); i++)
+	{
+		size_t numBytes = static_cast<size_t>(rd.getRange(1, 1023, 10));
+		if (i == 0)
+		{
+			rtcmOut.buf = rd.data();
+			rtcmOut.bitPos = rd.position();
+			rtcmOut.payloadSize = numBytes;
+		}
+		rd.skip(numBytes * 8);
+	}
+	if (presence & 0x01)
+		rd.skipRegionalList();
+	if (hasExt)
+		rd.skipExtensions();
+	return(rd.ok());
+};
+
+/// decode RTCMcorrections into RTCM_element_t. The octets are copied into the payload vector,
+/// which keeps its capacity across resets
+auto uper2rtcmElement = [](Reader& rd, RTCM_element_t& rtcmOut)->bool
+{
+	RTCMview_t rtcmView;
+	rtcmView.reset();
+	if (!uper2rtcm(rd, rtcmView))
+		return(false);
+	rtcmOut.msgCnt = rtcmView.msgCnt;
+	rtcmOut.rev = rtcmView.rev;
+	rtcmOut.timeStampMinute = rtcmView.timeStampMinute;
+	rtcmOut.payload.resize(rtcmView.payloadSize);
+	AsnJ2735Lib::get_rtcmPayload(rtcmView, &rtcmOut.payload[0], rtcmOut.payload.size());
+	return(true);
+};
+
+/// decode MessageFrame of BSM, SPaT, SRM, SSM or RTCM, returns false when the encoding should go to the asn1c path
+auto uper2dsrcFrame = [](Reader& rd, Frame_element_t& dsrcFrameOut, AsnJ2735Lib::bsmExtensions_t* pBsmExt)->bool
+{
+	bool hasExt = rd.getBit();
+	uint16_t dsrcMsgId = static_cast<uint16_t>(rd.get(15));
+	size_t end = rd.enterOpenType();
+	dsrcFrameOut.dsrcMsgId = dsrcMsgId;  // the member being filled, for reset() by the asn1c path on failure
+	bool tf2out;
+	switch(dsrcMsgId)
+	{
+	case MsgEnum::DSRCmsgID_bsm:
+		tf2out = uper2bsm(rd, dsrcFrameOut.bsm, pBsmExt);
+		break;
+	case MsgEnum::DSRCmsgID_spat:
+		tf2out = uper2spat(rd, dsrcFrameOut.spat);
+		break;
+	case MsgEnum::DSRCmsgID_srm:
+		tf2out = uper2srm(rd, dsrcFrameOut.srm);
+		break;
+	case MsgEnum::DSRCmsgID_ssm:
+		tf2out = uper2ssm(rd, dsrcFrameOut.ssm);
+		break;
+	case MsgEnum::DSRCmsgID_rtcm:
+		tf2out = uper2rtcmElement(rd, dsrcFrameOut.rtcm);
+		break;
+	default:
+		tf2out = false;
+		break;
+	}
+	if (!tf2out)
+		return(false);
+	rd.leaveOpenType(end);
+	if (hasExt)
+		rd.skipExtensions();
+	return(rd.ok());
+};
+
+/// SAE J2735 UPER decoding function, reading BSM, SPaT, SRM, SSM and RTCM straight into dsrcFrameOut
+size_t AsnJ2735Lib::decode_msgFrame_direct(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut)
+{
+	dsrcFrameOut.reset();
+	Reader rd(buf, size);
+	if (uper2dsrcFrame(rd, dsrcFrameOut, NULL))
+		return((rd.position() + 7) >> 3);
+	/// MAP, or encodings not handled here
+	return(decode_msgFrame_arena(buf, size, dsrcFrameOut));
+}
+
+/// direct decoder of the value of each dsrc element type, for decode<T>. MAP has none
+template<typename T> struct uperDecoder_t
+{
+	static bool decode(Reader&, T&)
+		{return(false);};
+};
+template<> struct uperDecoder_t<BSM_element_t>
+{
+	static bool decode(Reader& rd, BSM_element_t& bsmOut)
+		{return(uper2bsm(rd, bsmOut, NULL));};
+};
+template<> struct uperDecoder_t<SPAT_element_t>
+{
+	static bool decode(Reader& rd, SPAT_element_t& spatOut)
+		{return(uper2spat(rd, spatOut));};
+};
+template<> struct uperDecoder_t<SRM_element_t>
+{
+	static bool decode(Reader& rd, SRM_element_t& srmOut)
+		{return(uper2srm(rd, srmOut));};
+};
+template<> struct uperDecoder_t<SSM_element_t>
+{
+	static bool decode(Reader& rd, SSM_element_t& ssmOut)
+		{return(uper2ssm(rd, ssmOut));};
+};
+template<> struct uperDecoder_t<RTCM_element_t>
+{
+	static bool decode(Reader& rd, RTCM_element_t& rtcmOut)
+		{return(uper2rtcmElement(rd, rtcmOut));};
+};
+
+/// SAE J2735 UPER decoding function of a single message type, reading the value straight into msgOut
+template<typename T>
+size_t AsnJ2735Lib::decode(const uint8_t* buf, size_t size, T& msgOut)
+{
+	msgOut.reset();
+	Reader rd(buf, size);
+	bool hasExt = rd.getBit();
+	uint16_t dsrcMsgId = static_cast<uint16_t>(rd.get(15));
+	if (rd.ok() && (dsrcMsgId != msgId<T>::value))
+	{
+		report_codecError(codecError::wrongMsgType, "decode", "MessageFrame of another message type");
+		return(0);
+	}
+	size_t end = rd.enterOpenType();
+	if (uperDecoder_t<T>::decode(rd, msgOut))
+	{
+		rd.leaveOpenType(end);
+		if (hasExt)
+			rd.skipExtensions();
+		if (rd.ok())
+			return((rd.position() + 7) >> 3);
+	}
+	/// MAP, or encodings not handled here
+	return(decode_asn1c(buf, size, msgOut));
+}
+
+template size_t AsnJ2735Lib::decode<MapData_element_t>(const uint8_t*, size_t, MapData_element_t&);
+template size_t AsnJ2735Lib::decode<SPAT_element_t>(const uint8_t*, size_t, SPAT_element_t&);
+template size_t AsnJ2735Lib::decode<BSM_element_t>(const uint8_t*, size_t, BSM_element_t&);
+template size_t AsnJ2735Lib::decode<RTCM_element_t>(const uint8_t*, size_t, RTCM_element_t&);
+template size_t AsnJ2735Lib::decode<SRM_element_t>(const uint8_t*, size_t, SRM_element_t&);
+template size_t AsnJ2735Lib::decode<SSM_element_t>(const uint8_t*, size_t, SSM_element_t&);
+
+/// SAE J2735 UPER decoding function as decode_msgFrame_direct, except that BSM Part II contents and
+/// regional extensions are skipped without being decoded, and those of BSM are noted in bsmExtOut
+size_t AsnJ2735Lib::decode_msgFrame_lazy(const uint8_t* buf, size_t size, Frame_element_t& dsrcFrameOut, bsmExtensions_t& bsmExtOut)
+{
+	dsrcFrameOut.reset();
+	bsmExtOut.reset();
+	Reader rd(buf, size, true);
+	if (uper2dsrcFrame(rd, dsrcFrameOut, &bsmExtOut))
+		return((rd.position() + 7) >> 3);
+	bsmExtOut.reset();
+	return(decode_msgFrame_arena(buf, size, dsrcFrameOut));
+}
+
+/// copy an open type value noted by decode_msgFrame_lazy into valueBuf, aligned to the first byte
+size_t AsnJ2735Lib::get_openTypeValue(const uint8_t* buf, size_t size, const openTypeRef_t& ref, uint8_t* valueBuf, size_t valueSize)
+{
+	if (ref.numBytes > valueSize)
+		return(0);
+	Reader rd(buf, size);
+	rd.skip(ref.bitPos);
+	for (size_t i = 0; i < ref.numBytes; i++)
+		valueBuf[i] = static_cast<uint8_t>(rd.get(8));
+	return(rd.ok() ? ref.numBytes : 0);
+}
+
+/// SAE J2735 UPER decoding function of RTCM, leaving the RTCMmessage octets in buf.
+/// Fails where decode_msgFrame_direct would go to the asn1c path
+size_t AsnJ2735Lib::decode_rtcm_view(const uint8_t* buf, size_t size, RTCMview_t& rtcmOut)
+{
+	rtcmOut.reset();
+	Reader rd(buf, size);
+	bool hasExt = rd.getBit();
+	uint16_t dsrcMsgId = static_cast<uint16_t>(rd.get(15));
+	size_t end = rd.enterOpenType();
+	if ((dsrcMsgId == MsgEnum::DSRCmsgID_rtcm) && uper2rtcm(rd, rtcmOut))
+	{
+		rd.leaveOpenType(end);
+		if (hasExt)
+			rd.skipExtensions();
+		if (rd.ok())
+			return((rd.position() + 7) >> 3);
+	}
+	rtcmOut.reset();
+	return(0);
+}
+
+/// copy the RTCMmessage octets of a view into payloadBuf
+size_t AsnJ2735Lib::get_rtcmPayload(const RTCMview_t& rtcm, uint8_t* payloadBuf, size_t payloadSize)
+{
+	if ((rtcm.buf == NULL) || (rtcm.payloadSize == 0) || (rtcm.payloadSize > payloadSize))
+		return(0);
+	Reader rd(rtcm.buf, ((rtcm.bitPos + 7) >> 3) + rtcm.payloadSize);
+	rd.skip(rtcm.bitPos);
+	rd.getOctets(payloadBuf, rtcm.payloadSize);
+	return(rd.ok() ? rtcm.payloadSize : 0);
+}
+
+/// leading fields of a MessageFrame, reading as far as the last field wanted
+auto uper2msgHeader = [](Reader& rd, AsnJ2735Lib::msgHeader_t& headerOut)->bool
+{
+	rd.getBit();
+	uint16_t dsrcMsgId = static_cast<uint16_t>(rd.get(15));
+	rd.enterOpenType();
+	if (!rd.ok())
+		return(false);
+	headerOut.dsrcMsgId = dsrcMsgId;
+	switch(dsrcMsgId)
+	{
+	case MsgEnum::DSRCmsgID_map:
+		{
+			rd.getBit();
+			uint32_t presence = rd.getPresence(8);
+			if (presence & 0x80)
+				rd.getRange(0, 527040, 20);  // timeStamp
+			headerOut.revision = static_cast<uint8_t>(rd.get(7));
+			if (presence & 0x40)
+				rd.getExtRange(0, 7, 3);     // layerType
+			if (presence & 0x20)
+				rd.getRange(0, 100, 7);      // layerID
+			if (presence & 0x10)
+			{ // first IntersectionGeometry
+				rd.get(5);
+				rd.getBit();
+				if (rd.getPresence(5) & 0x10)
+					rd.skipDescriptiveName();
+				uper2intersectionReferenceId(rd, headerOut.regionalId, headerOut.intersectionId);
+			}
+		}
+		break;
+	case MsgEnum::DSRCmsgID_spat:
+		{
+			rd.getBit();
+			uint32_t presence = rd.getPresence(3);
+			if (presence & 0x04)
+				rd.getRange(0, 527040, 20);  // timeStamp
+			if (presence & 0x02)
+				rd.skipDescriptiveName();
+			// first IntersectionState
+			rd.get(5);
+			rd.getBit();
+			if (rd.getPresence(6) & 0x20)
+				rd.skipDescriptiveName();
+			uper2intersectionReferenceId(rd, headerOut.regionalId, headerOut.intersectionId);
+			headerOut.revision = static_cast<uint8_t>(rd.get(7));
+		}
+		break;
+	case MsgEnum::DSRCmsgID_bsm:
+		rd.get(3);
+		rd.get(7);
+		headerOut.vehId = rd.get(32);
+		break;
+	case MsgEnum::DSRCmsgID_srm:
+		{
+			rd.getBit();
+			uint32_t presence = rd.getPresence(4);
+			if (presence & 0x08)
+				rd.getRange(0, 527040, 20);  // timeStamp
+			rd.get(16);
+			if (presence & 0x04)
+				rd.get(7);
+			if (presence & 0x02)
+			{ // SignalRequest of the first SignalRequestPackage
+				rd.get(5);
+				rd.get(5);
+				rd.get(3);
+				uper2intersectionReferenceId(rd, headerOut.regionalId, headerOut.intersectionId);
+			}
+		}
+		break;
+	case MsgEnum::DSRCmsgID_ssm:
+		{
+			rd.getBit();
+			uint32_t presence = rd.getPresence(3);
+			if (presence & 0x04)
+				rd.getRange(0, 527040, 20);  // timeStamp
+			rd.get(16);
+			if (presence & 0x02)
+				rd.get(7);
+			// first SignalStatus
+			rd.get(5);
+			rd.get(2);
+			rd.get(7);
+			uper2intersectionReferenceId(rd, headerOut.regionalId, headerOut.intersectionId);
+		}
+		break;
+	default:
+		break;
+	}
+	return(rd.ok());
+};
+
+/// read the leading fields of a MessageFrame without decoding the rest of it
+bool AsnJ2735Lib::peek_msgFrame(const uint8_t* buf, size_t size, msgHeader_t& headerOut)
+{
+	headerOut.reset();
+	Reader rd(buf, size);
+	if (uper2msgHeader(rd, headerOut))
+		return(true);
+	headerOut.reset();
+	return(false);
+}
+
+/// BSM_element_t to BasicSafetyMessage, same members as bsm2msgFrame
+auto bsm2uper = [](const BSM_element_t& bsmIn, Writer& wr)->bool
+{
+	wr.putBit(false);      // extension
+	wr.put(0, 2);          // partII, regional
+	// BSMcoreData
+	wr.putRange(bsmIn.msgCnt, 0, 127, 7);
+	wr.put(bsmIn.id, 32);
+	wr.put(bsmIn.timeStampSec, 16);
+	wr.putRange(bsmIn.latitude, -900000000, 900000001, 31);
+	wr.putRange(bsmIn.longitude, -1799999999, 1800000001, 32);
+	wr.putRange(bsmIn.elevation, -4096, 61439, 16);
+	wr.put(bsmIn.semiMajor, 8);
+	wr.put(bsmIn.semiMinor, 8);
+	wr.put(bsmIn.orientation, 16);
+	wr.putRange(static_cast<int64_t>(bsmIn.transState), 0, 7, 3);
+	wr.putRange(bsmIn.speed, 0, 8191, 13);
+	wr.putRange(bsmIn.heading, 0, 28800, 15);
+	wr.putRange(bsmIn.steeringAngle, -126, 127, 8);
+	wr.putRange(bsmIn.accelLon, -2000, 2001, 12);
+	wr.putRange(bsmIn.accelLat, -2000, 2001, 12);
+	wr.putRange(bsmIn.accelVert, -127, 127, 8);
+	wr.putRange(bsmIn.yawRate, -32767, 32767, 16);
+	wr.put(static_cast<uint32_t>(reverseBits(static_cast<uint32_t>(bsmIn.brakeAppliedStatus.to_ulong()), 5)), 5);
+	wr.putRange(static_cast<int64_t>(bsmIn.tractionControlStatus), 0, 3, 2);
+	wr.putRange(static_cast<int64_t>(bsmIn.absStatus), 0, 3, 2);
+	wr.putRange(static_cast<int64_t>(bsmIn.stabilityControlStatus), 0, 3, 2);
+	wr.putRange(static_cast<int64_t>(bsmIn.brakeBoostApplied), 0, 2, 2);
+	wr.putRange(static_cast<int64_t>(bsmIn.auxiliaryBrakeStatus), 0, 3, 2);
+	wr.putRange(bsmIn.vehWidth, 0, 1023, 10);
+	wr.putRange(bsmIn.vehLen, 0, 4095, 12);
+	return(wr.ok());
+};
+
+/// MovementEvent_element_t to MovementEvent, the same members as movementEvent2msgFrame.
+/// Bit positions of its fields are noted in the last four arguments
+auto movementEvent2uper = [](const MovementEvent_element_t& eventIn, Writer& wr,
+	uint32_t& currStatePos, uint32_t& startTimePos, uint32_t& minEndTimePos, uint32_t& maxEndTimePos)->void
+{
+	bool hasTiming = (eventIn.minEndTime < MsgEnum::unknown_timeDetail);
+	bool hasStart = hasTiming && (eventIn.startTime < MsgEnum::unknown_timeDetail);
+	bool hasMaxEnd = hasTiming && (eventIn.maxEndTime < MsgEnum::unknown_timeDetail);
+	wr.putBit(false);    // extension
+	wr.put(hasTiming ? 0x04 : 0, 3);
+	currStatePos = static_cast<uint32_t>(wr.position());
+	wr.putRange(static_cast<int64_t>(eventIn.currState), 0, 9, 4);
+	if (hasTiming)
+	{ // TimeChangeDetails
+		wr.put((hasStart ? 0x10 : 0) | (hasMaxEnd ? 0x08 : 0), 5);
+		startTimePos = static_cast<uint32_t>(wr.position());
+		if (hasStart)
+			wr.put(eventIn.startTime, 16);
+		minEndTimePos = static_cast<uint32_t>(wr.position());
+		wr.put(eventIn.minEndTime, 16);
+		maxEndTimePos = static_cast<uint32_t>(wr.position());
+		if (hasMaxEnd)
+			wr.put(eventIn.maxEndTime, 16);
+	}
+};
+
+/// IntersectionState_element_t to IntersectionState, the same members as intersectionState2msgFrame.
+/// Bit positions of the fields that SpatEncoder patches are noted in layout
+auto intersectionState2uper = [](const IntersectionState_element_t& spatIn, Writer& wr, AsnJ2735Lib::spatLayout_t& layout)->bool
+{ // signalGroupID of permitted vehicular and pedestrian phases
+	uint8_t signalGroups[16];
+	size_t numGroups = 0;
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		if (spatIn.permittedPhases.test(i))
+			signalGroups[numGroups++] = static_cast<uint8_t>(i + 1);
+	}
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		if (spatIn.permittedPedPhases.test(i))
+			signalGroups[numGroups++] = static_cast<uint8_t>(i + 9);
+	}
+	if (numGroups == 0)
+		return(false);  // nothing to encode
+	bool hasMinute = (spatIn.timeStampMinute < MsgEnum::invalid_timeStampMinute);
+	bool hasSec = (spatIn.timeStampSec < 0xFFFF);
+	// IntersectionState
+	wr.putBit(false);      // extension
+	wr.put((hasMinute ? 0x10 : 0) | (hasSec ? 0x08 : 0), 6);
+	wr.putBit(true);       // IntersectionReferenceID.region
+	layout.regionalIdPos = static_cast<uint32_t>(wr.position());
+	wr.put(spatIn.regionalId, 16);
+	layout.idPos = static_cast<uint32_t>(wr.position());
+	wr.put(spatIn.id, 16);
+	layout.msgCntPos = static_cast<uint32_t>(wr.position());
+	wr.putRange(spatIn.msgCnt, 0, 127, 7);
+	layout.statusPos = static_cast<uint32_t>(wr.position());
+	wr.put(static_cast<uint32_t>(reverseBits(static_cast<uint32_t>(spatIn.status.to_ulong()), 16)), 16);
+	layout.minutePos = static_cast<uint32_t>(wr.position());
+	if (hasMinute)
+		wr.putRange(spatIn.timeStampMinute, 0, 527040, 20);
+	layout.secPos = static_cast<uint32_t>(wr.position());
+	if (hasSec)
+		wr.put(spatIn.timeStampSec, 16);
+	// MovementList SIZE(1..255)
+	wr.put(static_cast<uint32_t>(numGroups - 1), 8);
+	for (size_t i = 0; i < numGroups; i++)
+	{
+		const PhaseState_element_t& phaseState = (signalGroups[i] <= 8) ?
+			spatIn.phaseState[signalGroups[i] - 1] : spatIn.pedPhaseState[signalGroups[i] - 9];
+		size_t numEvents = spatIn.numEvents(phaseState);
+		// MovementState
+		wr.putBit(false);    // extension
+		wr.put(0, 3);        // name, maneuverAssistList, regional
+		wr.put(signalGroups[i], 8);
+		wr.put(static_cast<uint32_t>(numEvents - 1), 4);  // MovementEventList SIZE(1..16)
+		size_t j = signalGroups[i] - 1;
+		movementEvent2uper(phaseState, wr, layout.currStatePos[j], layout.startTimePos[j], layout.minEndTimePos[j], layout.maxEndTimePos[j]);
+		uint32_t eventPos[4];
+		for (size_t k = 1; k < numEvents; k++)
+			movementEvent2uper(spatIn.event(phaseState, k), wr, eventPos[0], eventPos[1], eventPos[2], eventPos[3]);
+	}
+	return(wr.ok());
+};
+
+/// SPAT_element_t to SPAT, one IntersectionState per intersection.
+/// Bit positions of the first intersection's fields are noted in pLayout when not NULL
+auto spat2uper = [](const SPAT_element_t& spatIn, Writer& wr, AsnJ2735Lib::spatLayout_t* pLayout)->bool
+{
+	size_t numIntersections = spatIn.numIntersections();
+	// SPAT
+	wr.putBit(false);      // extension
+	wr.put(0, 3);          // timeStamp, name, regional
+	wr.put(static_cast<uint32_t>(numIntersections - 1), 5);  // IntersectionStateList SIZE(1..32)
+	AsnJ2735Lib::spatLayout_t scratch;
+	for (size_t i = 0; i < numIntersections; i++)
+	{
+		if (!intersectionState2uper(spatIn.intersection(i), wr, ((i == 0) && (pLayout != NULL)) ? *pLayout : scratch))
+			return(false);
+	}
+	return(wr.ok());
+};
+
+/// layout keys of the SPaT encoding of spatIn, as in spatLayout_t. Returns false when a signal group has
+/// MovementEvents after the current one, which the layout does not cover
+auto spatLayoutKeys = [](const IntersectionState_element_t& spatIn, uint32_t& groupKey, uint64_t& timingKey)->bool
+{
+	groupKey = static_cast<uint32_t>(spatIn.permittedPhases.to_ulong() | (spatIn.permittedPedPhases.to_ulong() << 8));
+	if (spatIn.timeStampMinute < MsgEnum::invalid_timeStampMinute)
+		groupKey |= 0x10000;
+	if (spatIn.timeStampSec < 0xFFFF)
+		groupKey |= 0x20000;
+	timingKey = 0;
+	for (size_t i = 0; i < 16; i++)
+	{
+		if (((groupKey >> i) & 1) == 0)
+			continue;
+		const PhaseState_element_t& phaseState = (i < 8) ? spatIn.phaseState[i] : spatIn.pedPhaseState[i - 8];
+		if (phaseState.numNextEvents > 0)
+			return(false);
+		if (phaseState.minEndTime >= MsgEnum::unknown_timeDetail)
+			continue;
+		uint64_t flags = 0x01;
+		if (phaseState.startTime < MsgEnum::unknown_timeDetail)
+			flags |= 0x02;
+		if (phaseState.maxEndTime < MsgEnum::unknown_timeDetail)
+			flags |= 0x04;
+		timingKey |= flags << (i * 3);
+	}
+	return(true);
+};
+
+/// write the fields of spatIn into a MessageFrame encoded with the same layout
+auto spat2patch = [](const IntersectionState_element_t& spatIn, const AsnJ2735Lib::spatLayout_t& layout, Writer& wr)->bool
+{
+	size_t pos = layout.valuePos;
+	wr.patch(pos + layout.regionalIdPos, spatIn.regionalId, 16);
+	wr.patch(pos + layout.idPos, spatIn.id, 16);
+	wr.patchRange(pos + layout.msgCntPos, spatIn.msgCnt, 0, 127, 7);
+	wr.patch(pos + layout.statusPos, static_cast<uint32_t>(reverseBits(static_cast<uint32_t>(spatIn.status.to_ulong()), 16)), 16);
+	if (layout.groupKey & 0x10000)
+		wr.patchRange(pos + layout.minutePos, spatIn.timeStampMinute, 0, 527040, 20);
+	if (layout.groupKey & 0x20000)
+		wr.patch(pos + layout.secPos, spatIn.timeStampSec, 16);
+	for (size_t i = 0; i < 16; i++)
+	{
+		if (((layout.groupKey >> i) & 1) == 0)
+			continue;
+		const PhaseState_element_t& phaseState = (i < 8) ? spatIn.phaseState[i] : spatIn.pedPhaseState[i - 8];
+		uint64_t flags = (layout.timingKey >> (i * 3)) & 0x07;
+		wr.patchRange(pos + layout.currStatePos[i], static_cast<int64_t>(phaseState.currState), 0, 9, 4);
+		if (flags & 0x02)
+			wr.patch(pos + layout.startTimePos[i], phaseState.startTime, 16);
+		if (flags & 0x01)
+			wr.patch(pos + layout.minEndTimePos[i], phaseState.minEndTime, 16);
+		if (flags & 0x04)
+			wr.patch(pos + layout.maxEndTimePos[i], phaseState.maxEndTime, 16);
+	}
+	return(wr.ok());
+};
+
+/// RTCMview_t to RTCMcorrections, same members as rtcm2msgFrame
+auto rtcm2uper = [](const RTCMview_t& rtcmIn, Writer& wr)->bool
+{
+	if ((rtcmIn.buf == NULL) || (rtcmIn.payloadSize == 0))
+		return(false);
+	bool hasTimeStamp = (rtcmIn.timeStampMinute < MsgEnum::invalid_timeStampMinute);
+	wr.putBit(false);      // extension
+	wr.put(hasTimeStamp ? 0x08 : 0x00, 4);
+	wr.putRange(rtcmIn.msgCnt, 0, 127, 7);
+	wr.putExtRange(rtcmIn.rev, 0, 3, 2);
+	if (hasTimeStamp)
+		wr.putRange(rtcmIn.timeStampMinute, 0, 527040, 20);
+	wr.put(0, 3);          // one RTCMmessage
+	wr.putRange(static_cast<int64_t>(rtcmIn.payloadSize), 1, 1023, 10);
+	const uint8_t* payload = rtcmIn.data();
+	if (payload != NULL)
+		wr.putOctets(payload, rtcmIn.payloadSize);
+	else
+	{ // octets of a decoded view that are not byte-aligned
+		Reader rd(rtcmIn.buf, ((rtcmIn.bitPos + 7) >> 3) + rtcmIn.payloadSize);
+		rd.skip(rtcmIn.bitPos);
+		for (size_t i = 0; (i < rtcmIn.payloadSize) && rd.ok(); i++)
+			wr.put(rd.get(8), 8);
+		if (!rd.ok())
+			wr.fail();
+	}
+	return(wr.ok());
+};
+
+/// MessageFrame header ahead of a value of numBytes written at buf + 4: extension bit and 15-bit
+/// messageId take two bytes, followed by the open type length determinant of one or two bytes.
+/// The value is moved forward when the shorter length suffices. Returns the size of the MessageFrame
+auto setMsgFrameHeader = [](uint16_t dsrcMsgId, uint8_t* buf, size_t numBytes)->size_t
+{
+	const size_t headerBytes = 4;
+	if (numBytes >= 0x4000)
+		return(0);
+	buf[0] = static_cast<uint8_t>((dsrcMsgId >> 8) & 0x7F);
+	buf[1] = static_cast<uint8_t>(dsrcMsgId & 0xFF);
+	if (numBytes < 0x80)
+	{
+		buf[2] = static_cast<uint8_t>(numBytes);
+		std::memmove(buf + 3, buf + headerBytes, numBytes);
+		return(numBytes + 3);
+	}
+	buf[2] = static_cast<uint8_t>(0x80 | (numBytes >> 8));
+	buf[3] = static_cast<uint8_t>(numBytes & 0xFF);
+	return(numBytes + headerBytes);
+};
+
+/// SAE J2735 UPER encoding function of RTCM, writing the RTCMmessage octets straight from rtcmIn.
+/// The size of the value is known ahead, so the MessageFrame header goes first and nothing is moved
+size_t AsnJ2735Lib::encode_rtcm_view(const RTCMview_t& rtcmIn, uint8_t* buf, size_t size)
+{
+	size_t valueBits = 28 + rtcmIn.payloadSize * 8;
+	if (rtcmIn.timeStampMinute < MsgEnum::invalid_timeStampMinute)
+		valueBits += 20;
+	Writer wr(buf, size);
+	wr.put(MsgEnum::DSRCmsgID_rtcm, 16);
+	wr.putLength((valueBits + 7) >> 3);
+	if (!wr.ok() || !rtcm2uper(rtcmIn, wr))
+		return(0);
+	return(wr.bytes());
+}
+
+/// direct encoder of the value of each dsrc element type, for encode<T>. MAP, SRM and SSM have none
+template<typename T> struct uperEncoder_t
+{
+	static bool encode(const T&, Writer&)
+		{return(false);};
+};
+template<> struct uperEncoder_t<BSM_element_t>
+{
+	static bool encode(const BSM_element_t& bsmIn, Writer& wr)
+		{return(bsm2uper(bsmIn, wr));};
+};
+template<> struct uperEncoder_t<SPAT_element_t>
+{
+	static bool encode(const SPAT_element_t& spatIn, Writer& wr)
+		{return(spat2uper(spatIn, wr, NULL));};
+};
+
+/// SAE J2735 UPER encoding function of a single message type, writing the value straight from msgIn
+template<typename T>
+size_t AsnJ2735Lib::encode(const T& msgIn, uint8_t* buf, size_t size)
+{ // the value is written after room for the longer MessageFrame header
+	const size_t headerBytes = 4;
+	if (size > headerBytes)
+	{
+		Writer wr(buf + headerBytes, size - headerBytes);
+		size_t numBytes = uperEncoder_t<T>::encode(msgIn, wr) ? setMsgFrameHeader(msgId<T>::value, buf, wr.bytes()) : 0;
+		if (numBytes > 0)
+			return(numBytes);
+	}
+	/// other messages, or values that encode_asn1c would reject
+	return(encode_asn1c(msgIn, buf, size));
+}
+
+/// RTCM goes through encode_rtcm_view, which writes the MessageFrame header first
+template<>
+size_t AsnJ2735Lib::encode<RTCM_element_t>(const RTCM_element_t& rtcmIn, uint8_t* buf, size_t size)
+{
+	if (!rtcmIn.payload.empty())
+	{
+		RTCMview_t rtcmView;
+		rtcmView.msgCnt = rtcmIn.msgCnt;
+		rtcmView.rev = rtcmIn.rev;
+		rtcmView.timeStampMinute = rtcmIn.timeStampMinute;
+		rtcmView.buf = &rtcmIn.payload[0];
+		rtcmView.bitPos = 0;
+		rtcmView.payloadSize = rtcmIn.payload.size();
+		size_t numBytes = encode_rtcm_view(rtcmView, buf, size);
+		if (numBytes > 0)
+			return(numBytes);
+	}
+	return(encode_asn1c(rtcmIn, buf, size));
+}
+
+template size_t AsnJ2735Lib::encode<MapData_element_t>(const MapData_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode<SPAT_element_t>(const SPAT_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode<BSM_element_t>(const BSM_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode<SRM_element_t>(const SRM_element_t&, uint8_t*, size_t);
+template size_t AsnJ2735Lib::encode<SSM_element_t>(const SSM_element_t&, uint8_t*, size_t);
+
+/// SAE J2735 UPER encoding function, writing BSM, SPaT and RTCM straight from dsrcFrameIn
+size_t AsnJ2735Lib::encode_msgFrame_direct(const Frame_element_t& dsrcFrameIn, uint8_t* buf, size_t size)
+{
+	switch(dsrcFrameIn.dsrcMsgId)
+	{
+	case MsgEnum::DSRCmsgID_map:
+		return(encode(dsrcFrameIn.mapData, buf, size));
+	case MsgEnum::DSRCmsgID_spat:
+		return(encode(dsrcFrameIn.spat, buf, size));
+	case MsgEnum::DSRCmsgID_bsm:
+		return(encode(dsrcFrameIn.bsm, buf, size));
+	case MsgEnum::DSRCmsgID_rtcm:
+		return(encode(dsrcFrameIn.rtcm, buf, size));
+	case MsgEnum::DSRCmsgID_srm:
+		return(encode(dsrcFrameIn.srm, buf, size));
+	case MsgEnum::DSRCmsgID_ssm:
+		return(encode(dsrcFrameIn.ssm, buf, size));
+	default:
+		return(encode_msgFrame(dsrcFrameIn, buf, size));
+	}
+}
+
+/// SPaT UPER encoding that patches the MessageFrame kept from the last encoding when the layout is the same
+size_t AsnJ2735Lib::SpatEncoder::encode(const SPAT_element_t& spatIn, uint8_t* buf, size_t size)
+{
+	uint32_t groupKey;
+	uint64_t timingKey;
+	if (!spatIn.moreIntersections.empty() || !spatLayoutKeys(spatIn, groupKey, timingKey))
+	{ /// the layout is kept for single intersection SPaTs with only the current MovementEvents
+		numFullEncodes++;
+		hasLayout = false;
+		return(AsnJ2735Lib::encode(spatIn, buf, size));
+	}
+	if (hasLayout && (groupKey == layout.groupKey) && (timingKey == layout.timingKey) && (layout.numBytes <= size))
+	{
+		Writer wr(&msgFrame[0], layout.numBytes);
+		if (spat2patch(spatIn, layout, wr))
+		{
+			std::memcpy(buf, &msgFrame[0], layout.numBytes);
+			numPatches++;
+			return(layout.numBytes);
+		}
+	}
+	/// full encoding, keeping the layout
+	const size_t headerBytes = 4;
+	numFullEncodes++;
+	hasLayout = false;
+	msgFrame.resize(DsrcConstants::maxMsgSize);
+	Writer wr(&msgFrame[headerBytes], msgFrame.size() - headerBytes);
+	layout.groupKey = groupKey;
+	layout.timingKey = timingKey;
+	size_t numBytes = spat2uper(spatIn, wr, &layout) ? setMsgFrameHeader(MsgEnum::DSRCmsgID_spat, &msgFrame[0], wr.bytes()) : 0;
+	if (numBytes == 0)
+	{ /// values that encode_msgFrame would reject
+		Frame_element_t dsrcFrameIn;
+		dsrcFrameIn.dsrcMsgId = MsgEnum::DSRCmsgID_spat;
+		dsrcFrameIn.spat = spatIn;
+		return(encode_msgFrame(dsrcFrameIn, buf, size));
+	}
+	layout.numBytes = numBytes;
+	layout.valuePos = (numBytes - wr.bytes()) * 8;
+	hasLayout = true;
+	if (numBytes > size)
+		return(0);
+	std::memcpy(buf, &msgFrame[0], numBytes);
+	return(numBytes);
+}
@@ -56,6 +56,21 @@ namespace GeoUtils
 		GeoUtils::transMatrix_t transMatrix;
 	};
 
+	struct localProj_t
+	{ // 3rd order expansion of lla2enu about the ENU origin, for points at the elevation of the origin
+		double latitude;          // origin, in degree
+		double longitude;         // origin, in degree
+		double eastPerLong;       // meters east per degree of longitude at the origin latitude
+		double eastPerLatLong;    // change of eastPerLong per degree of latitude
+		double eastPerLat2Long;   // half of the 2nd derivative of eastPerLong by latitude
+		double eastPerLong3;      // from the sine of the longitude difference
+		double northPerLat;       // meters north per degree of latitude
+		double northPerLat2;      // half of the change of northPerLat per degree of latitude
+		double northPerLat3;      // from the cosine of the latitude difference
+		double northPerLong2;     // meters north per squared degree of longitude, from the convergence of meridians
+		double northPerLatLong2;  // change of northPerLong2 per degree of latitude
+	};
+
 	struct point2D_t
 	{ // unit of centimeters
 		int32_t x;
@@ -133,7 +148,7 @@ namespace GeoUtils
 	struct intersectionTracking_t
 	{
 		MsgEnum::mapLocType vehicleIntersectionStatus;
-		uint8_t  intersectionIndex;  // meaningful when vehicleIntersectionStatus != outside
+		uint32_t intersectionIndex;  // meaningful when vehicleIntersectionStatus != outside
 		uint8_t  approachIndex;      // meaningful when vehicleIntersectionStatus != outside & insideIntersectionBox
 		uint8_t  laneIndex;          // meaningful when vehicleIntersectionStatus != outside & insideIntersectionBox
 		bool operator==(const GeoUtils::intersectionTracking_t& p) const
@@ -265,6 +280,11 @@ namespace GeoUtils
 	void lla2enu(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::geoPoint_t& geoPoint, GeoUtils::point3D_t& ptENU);
 	void lla2enu(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::geoPoint_t& geoPoint, GeoUtils::point2D_t& ptENU);
 	void lla2enu(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::geoRefPoint_t& geoRef, GeoUtils::point2D_t& ptENU);
+	void setLocalProj(const GeoUtils::geoPoint_t& geoPoint, GeoUtils::localProj_t& localProj);
+	void setLocalProj(const GeoUtils::geoRefPoint_t& geoRef, GeoUtils::localProj_t& localProj);
+	// horizontal ENU of a point taken at the elevation of the origin, ptENU.z is set to 0
+	void lla2enu(const GeoUtils::localProj_t& localProj, const GeoUtils::geoPoint_t& geoPoint, GeoUtils::point3D_t& ptENU);
+	void lla2enu(const GeoUtils::localProj_t& localProj, const GeoUtils::geoPoint_t& geoPoint, GeoUtils::point2D_t& ptENU);
 	void enu2ecef(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::point3D_t& ptENU, GeoUtils::point3D_t& ptECEF);
 	void enu2ecef(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::point2D_t& ptENU, GeoUtils::point3D_t& ptECEF);
 	void ecef2lla(const GeoUtils::point3D_t& ptECEF, GeoUtils::geoPoint_t& geoPoint);
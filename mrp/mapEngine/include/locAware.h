@@ -9,10 +9,27 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "dsrcMapData.h"
 #include "mapDataStruct.h"
+#include "payloadCache.h"
+
+// scratch vectors of locateVehicleInMap, owned by the caller and kept from call to call. They are cleared
+// before use and keep their capacity, so once they have grown to what the intersections in memory need
+// (see reserveWorkspace), locating a vehicle allocates nothing. One per thread
+struct locateWorkspace_t
+{
+	std::vector<uint32_t> intersectionList;
+	std::vector<GeoUtils::vehicleTracking_t> aVehicleTrackingState;
+	std::vector<uint8_t> approachList;
+	std::vector<GeoUtils::vehicleTracking_t> aApproachTrackingState;
+	std::vector<GeoUtils::laneTracking_t> aLaneTrackingState;
+	std::vector<size_t> aIndex;
+	std::vector<GeoUtils::laneProjection_t> aProj2Lane;
+	std::vector<uint8_t> connAppIndex;
+};
 
 class LocAware
 {
@@ -26,14 +43,26 @@ class LocAware
 		// indexes (start from 0) in mpIntersection.
 		// key:   (regionalId << 24) | (intersectionId << 8) | laneId
 		// value: (intIndx << 16) | (appIndx << 8) | laneIndx
-		std::map<uint64_t, uint32_t> IndexMap;
+		std::map<uint64_t, uint64_t> IndexMap;
+		// map between intersection referenceId, (regionalId << 16) | intersectionId, and its index in mpIntersection
+		std::unordered_map<uint32_t, uint32_t> IdIndexMap;
 		// for saving updated MapData into file
 		std::string mapFilePath;
+		// result of checkMapUpdate for the MAP payloads seen last, cleared when mpIntersection changes
+		AsnJ2735Lib::PayloadCache<uint32_t> mapCache;
+		// uniform latitude/longitude grid over the bounding circles of intersections, for nearedIntersections
+		// key:   (latitude cell << 32) | longitude cell
+		// value: indexes in mpIntersection of the intersections whose circle overlaps the cell, in order
+		std::unordered_map<uint64_t, std::vector<uint32_t>> intersectionGrid;
 
+		// drop all intersections, after a failed load
+		void clearIntersections(void);
 		// processing intersection MAP file
 		bool readNmap(const std::string& fname);
 		// processing intersection encodeed MAP payload file
 		bool readPayload(const std::string& fname);
+		// processing binary MAP payload store file
+		bool readMapStore(const std::string& fname);
 		void setIntersectionName(const std::string& name, const uint16_t& regionalId, const uint16_t& intersectionId);
 		void saveNmap(const NmapData::IntersectionStruct& intObj) const;
 		void setOutbond2InboundWaypoints(void);
@@ -43,21 +72,29 @@ class LocAware
 		void setLocalOffsetAndHeading(NmapData::IntersectionStruct& intObj);
 		void buildPolygons(void);
 		void buildPolygons(NmapData::IntersectionStruct& intObj);
+		void buildIntersectionGrid(void);
+		void addToIntersectionGrid(const uint32_t& intIndx);
+		void removeFromIntersectionGrid(const uint32_t& intIndx);
+		// decode MAP payload and add it when it is new or updated
+		uint32_t checkMapPayload(const uint8_t* buf, size_t size);
 		// UPER encoding MapData
 		size_t encode_mapdata_payload(void);
 		// add new MAP
 		void addIntersection(const NmapData::IntersectionStruct& intObj);
 		// get static map data elements
 		uint8_t getMapVersion(const uint16_t& regionalId, const uint16_t& intersectionId) const;
-		std::vector<uint8_t> getIndexesByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const;
+		std::vector<uint32_t> getIndexesByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const;
+		bool getIndexesByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId,
+			uint32_t& intIndx, uint8_t& appIndx, uint8_t& laneIndx) const;
 		uint8_t getControlPhaseByLaneId(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const;
 		uint8_t getControlPhaseByAprochId(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& approachId) const;
-		uint8_t getIndexByApproachId(const uint8_t& intersectionIndx, const uint8_t& approachId) const;
-		uint8_t getLaneIdByIndexes(const uint8_t& intersectionIndx, const uint8_t& approachIndx, const uint8_t& laneIndx) const;
+		uint8_t getIndexByApproachId(const uint32_t& intersectionIndx, const uint8_t& approachId) const;
+		uint8_t getLaneIdByIndexes(const uint32_t& intersectionIndx, const uint8_t& approachIndx, const uint8_t& laneIndx) const;
 		// locating vehicle BSM on intersection Map
-		std::vector<uint8_t> nearedIntersections(const GeoUtils::geoPoint_t& geoPoint) const;
+		std::vector<uint32_t> nearedIntersections(const GeoUtils::geoPoint_t& geoPoint) const;
+		void nearedIntersections(const GeoUtils::geoPoint_t& geoPoint, std::vector<uint32_t>& intersectionList) const;
 		bool isOutboundConnect2Inbound(const NmapData::ConnectStruct& connObj, const GeoUtils::geoPoint_t& geoPoint,
-			const GeoUtils::motion_t& motionState, GeoUtils::vehicleTracking_t& vehicleTrackingState) const;
+			const GeoUtils::motion_t& motionState, GeoUtils::vehicleTracking_t& vehicleTrackingState, locateWorkspace_t& workspace) const;
 
 	public:
 		LocAware(const std::string& fname, bool isSingleFrame=false);
@@ -69,21 +106,28 @@ class LocAware
 		void saveNmap(const uint16_t& regionalId, const uint16_t& intersectionId) const;
 		// check MAP update based on encoded MAP payload
 		uint32_t checkMapUpdate(const uint8_t* buf, size_t size);
+		const AsnJ2735Lib::payloadCacheStats_t& getMapCacheStats(void) const;
 		// get static map data elements
 		bool isInitiated(void) const;
 		std::vector<uint32_t> getIntersectionIds(void) const;
 		std::string getIntersectionNameById(const uint16_t& regionalId, const uint16_t& intersectionId) const;
 		uint32_t getIntersectionIdByName(const std::string& name) const;
-		uint8_t  getIndexByIntersectionId(const uint16_t& regionalId, const uint16_t& intersectionId) const;
+		// index in mpIntersection, 0xFFFFFFFF when the intersection is not in memory
+		uint32_t getIndexByIntersectionId(const uint16_t& regionalId, const uint16_t& intersectionId) const;
 		uint8_t  getControlPhaseByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& approachId, const uint8_t& laneId) const;
 		uint8_t  getApproachIdByLaneId(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const;
 		uint32_t getLaneLength(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const;
-		GeoUtils::geoRefPoint_t getIntersectionRefPoint(const uint8_t& intersectionIndx) const;
-		std::string getIntersectionNameByIndex(const uint8_t& intersectionIndex) const;
+		GeoUtils::geoRefPoint_t getIntersectionRefPoint(const uint32_t& intersectionIndx) const;
+		std::string getIntersectionNameByIndex(const uint32_t& intersectionIndex) const;
 		std::vector<uint8_t> getMapdataPayload(const uint16_t& regionalId, const uint16_t& intersectionId) const;
 		bool getSpeedLimits(std::vector<uint8_t>& speedLimits, const uint16_t& regionalId, const uint16_t& intersectionId) const;
 		// locating vehicle BSM on intersection Map
 		bool locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUtils::vehicleTracking_t& cvTrackingState) const;
+		// as above, with the scratch vectors of the caller
+		bool locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUtils::vehicleTracking_t& cvTrackingState,
+			locateWorkspace_t& workspace) const;
+		// reserve the vectors of workspace for the intersections in memory, so that no call allocates
+		void reserveWorkspace(locateWorkspace_t& workspace) const;
 		void updateLocationAware(const GeoUtils::vehicleTracking_t& vehicleTrackingState, GeoUtils::locationAware_t& vehicleLocationAware) const;
 		void getPtDist2D(const GeoUtils::vehicleTracking_t& vehicleTrackingState, GeoUtils::point2D_t& pt) const;
 };
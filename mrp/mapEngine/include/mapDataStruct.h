@@ -39,6 +39,19 @@ namespace NmapData
 		uint16_t heading;            // in decidegree
 	};
 
+	struct SegmentStruct
+	{ // A lane segment between adjacent nodes, in the direction of travel along the lane as projectPt2Lane walks it
+		// (towards the stop-bar on inbound lanes, away from the intersection box otherwise), compiled from mpNodes
+		// once the local offsets and headings are set.
+		GeoUtils::point2D_t  ptStart;    // in centimeter, the node the segment starts from
+		GeoUtils::vector2D_t direction;  // in centimeter, from the start node to the end node
+		double   length2;                // in square centimeter
+		double   length;                 // in centimeter
+		double   headingX;               // east component of the unit vector of the start node heading
+		double   headingY;               // north component of the unit vector of the start node heading
+		uint8_t  nodeIndex;              // index of the start node in mpNodes
+	};
+
 	struct LaneStruct
 	{ // An approach consists of multiple lane objectives, including traffic lanes and crosswalks.
 		// Order of lane array starts at the curb lane and moves towards the center of the road.
@@ -86,6 +99,7 @@ namespace NmapData
 		size_t   numpoints;          // sizeof(mpNodes)
 		std::vector<NmapData::ConnectStruct> mpConnectTo;
 		std::vector<NmapData::NodeStruct> mpNodes;
+		std::vector<NmapData::SegmentStruct> mpSegments;
 	};
 
 	struct ApproachStruct
@@ -116,6 +130,7 @@ namespace NmapData
 			 */
 		GeoUtils::geoRefPoint_t geoRef;
 		GeoUtils::enuCoord_t    enuCoord;
+		GeoUtils::localProj_t   localProj;  // fast lla2enu within radius, in the locate path
 		uint32_t  radius;             // in centimeter
 		std::vector<uint8_t>  speeds; // in mph
 		std::vector<NmapData::ApproachStruct> mpApproaches;
@@ -0,0 +1,79 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+#ifndef _MAP_STORE_H
+#define _MAP_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Encoded MAP payloads of many intersections, kept either as a hex .payload file, one line
+/// "payload <name> <hex>" per intersection, or as a binary .mapstore file that is memory-mapped.
+/// A .mapstore file, all numbers little-endian:
+///   header (16 bytes): magic "MRPMAPS\0", version (uint32), number of entries (uint32)
+///   index (16 bytes per entry, sorted by regionalId then intersectionId): regionalId (uint16),
+///     intersectionId (uint16), payload offset (uint32), payload size (uint16), name length (uint8),
+///     reserved (uint8), name offset (uint32)
+///   names and payloads, at the offsets from the start of the file given in the index
+namespace MapStore
+{
+	/// an intersection MAP held in memory, as read from or to be written to a file
+	struct mapEntry_t
+	{
+		uint16_t regionalId;
+		uint16_t intersectionId;
+		std::string name;
+		std::vector<uint8_t> payload;
+	};
+	/// an intersection MAP of a mapped .mapstore file, valid while the MapStoreReader is open
+	struct mapView_t
+	{
+		uint16_t regionalId;
+		uint16_t intersectionId;
+		const char* name;        /// not null-terminated
+		size_t nameLength;
+		const uint8_t* payload;
+		size_t payloadSize;
+	};
+
+	/// convert numChars hex digits to numChars / 2 bytes in buf. Returns the number of bytes,
+	/// or 0 when numChars is odd, buf is too small or a character is not a hex digit
+	size_t hex2bytes(const char* hex, size_t numChars, uint8_t* buf, size_t size);
+
+	/// read a .payload file. The IDs of each intersection come from its MAP payload
+	bool readPayloadFile(const std::string& fname, std::vector<mapEntry_t>& entries);
+	bool writePayloadFile(const std::string& fname, const std::vector<mapEntry_t>& entries);
+	/// write a .mapstore file, failing on two entries of the same regionalId and intersectionId
+	bool writeMapStore(const std::string& fname, const std::vector<mapEntry_t>& entries);
+
+	/// memory-mapped .mapstore file
+	class MapStoreReader
+	{
+		public:
+			MapStoreReader(void);
+			~MapStoreReader(void);
+			MapStoreReader(const MapStoreReader&) = delete;
+			MapStoreReader& operator=(const MapStoreReader&) = delete;
+
+			/// map the file and check its header and index, false when it is not a valid .mapstore file
+			bool open(const std::string& fname);
+			void close(void);
+			size_t size(void) const
+				{return(numEntries);};
+			mapView_t at(size_t i) const;
+			/// binary search of the index
+			bool find(uint16_t regionalId, uint16_t intersectionId, mapView_t& viewOut) const;
+
+		private:
+			const uint8_t* pFile;
+			size_t fileSize;
+			size_t numEntries;
+	};
+};
+
+#endif
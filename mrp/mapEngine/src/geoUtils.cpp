@@ -88,6 +88,65 @@ void GeoUtils::lla2enu(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::geo
 	GeoUtils::lla2enu(enuCoord,geoPoint,ptENU);
 }
 
+void GeoUtils::setLocalProj(const GeoUtils::geoPoint_t& geoPoint, GeoUtils::localProj_t& localProj)
+{ // east = (N+h)cos(lat)sin(dLong) and north = g(lat) - g(lat0) + (N+h)cos(lat)sin(lat0)(1-cos(dLong)) for a point at
+	// the elevation h of the origin, with g'(lat) = (M+h)cos(lat-lat0), expanded to 3rd order in dLat and dLong
+	// but for the change of dM/dlat. The terms left out are below 1 micrometer within 2 km of the origin, up to
+	// 80 degree latitude
+	double latitude_r = DsrcConstants::deg2rad(geoPoint.latitude);
+	double sinLat = std::sin(latitude_r);
+	double cosLat = std::cos(latitude_r);
+	double e2 = DsrcConstants::ellipsoid_e * DsrcConstants::ellipsoid_e;
+	double w2 = 1.0 - e2 * sinLat * sinLat;
+	// radii of curvature in the prime vertical (N) and in the meridian (M), and dM/dlat
+	double N = DsrcConstants::ellipsoid_a / std::sqrt(w2);
+	double M = N * (1.0 - e2) / w2;
+	double dM = 3.0 * M * e2 * sinLat * cosLat / w2;
+	double h = geoPoint.elevation;
+	double r = DsrcConstants::deg2rad(1.0);
+	localProj.latitude  = geoPoint.latitude;
+	localProj.longitude = geoPoint.longitude;
+	localProj.eastPerLong     = (N + h) * cosLat * r;
+	localProj.eastPerLatLong  = -(M + h) * sinLat * r * r;
+	localProj.eastPerLat2Long = -(dM * sinLat + (M + h) * cosLat) * r * r * r / 2.0;
+	localProj.eastPerLong3    = -(N + h) * cosLat * r * r * r / 6.0;
+	localProj.northPerLat     = (M + h) * r;
+	localProj.northPerLat2    = dM * r * r / 2.0;
+	localProj.northPerLat3    = -(M + h) * r * r * r / 6.0;
+	localProj.northPerLong2   = (N + h) * cosLat * sinLat * r * r / 2.0;
+	localProj.northPerLatLong2 = -(M + h) * sinLat * sinLat * r * r * r / 2.0;
+}
+
+void GeoUtils::setLocalProj(const GeoUtils::geoRefPoint_t& geoRef, GeoUtils::localProj_t& localProj)
+{
+	GeoUtils::geoPoint_t geoPoint;
+	GeoUtils::geoRefPoint2geoPoint(geoRef, geoPoint);
+	GeoUtils::setLocalProj(geoPoint, localProj);
+}
+
+void GeoUtils::lla2enu(const GeoUtils::localProj_t& localProj, const GeoUtils::geoPoint_t& geoPoint, GeoUtils::point3D_t& ptENU)
+{
+	double dLat = geoPoint.latitude - localProj.latitude;
+	double dLong = geoPoint.longitude - localProj.longitude;
+	if (dLong > 180.0)
+		dLong -= 360.0;
+	else if (dLong < -180.0)
+		dLong += 360.0;
+	ptENU.x = (localProj.eastPerLong + (localProj.eastPerLatLong + localProj.eastPerLat2Long * dLat) * dLat
+		+ localProj.eastPerLong3 * dLong * dLong) * dLong;
+	ptENU.y = (localProj.northPerLat + (localProj.northPerLat2 + localProj.northPerLat3 * dLat) * dLat) * dLat
+		+ (localProj.northPerLong2 + localProj.northPerLatLong2 * dLat) * dLong * dLong;
+	ptENU.z = 0.0;
+}
+
+void GeoUtils::lla2enu(const GeoUtils::localProj_t& localProj, const GeoUtils::geoPoint_t& geoPoint, GeoUtils::point2D_t& ptENU)
+{
+	GeoUtils::point3D_t pt3DENU;
+	GeoUtils::lla2enu(localProj, geoPoint, pt3DENU);
+	ptENU.x = DsrcConstants::unit2hecto<int32_t>(pt3DENU.x);
+	ptENU.y = DsrcConstants::unit2hecto<int32_t>(pt3DENU.y);
+}
+
 void GeoUtils::enu2ecef(const GeoUtils::enuCoord_t& enuCoord, const GeoUtils::point3D_t& ptENU, GeoUtils::point3D_t& ptECEF)
 {
 	ptECEF.x = enuCoord.pointECEF.x + (-enuCoord.transMatrix.dSinLong) * ptENU.x
@@ -17,6 +17,7 @@
 #include "AsnJ2735Lib.h"
 #include "dsrcConsts.h"
 #include "locAware.h"
+#include "mapStore.h"
 
 auto getFilePath = [](const std::string& str)->std::string
 {
@@ -38,7 +39,8 @@ LocAware::LocAware(const std::string& fname, bool isSingleFrame /*=false*/)
 	speedLimitInLane = isSingleFrame;
 	mapFilePath = getFilePath(fname);
 	std::string fileExtension = getFileExtension(fname);
-	if ((fileExtension.compare("nmap") != 0) && (fileExtension.compare("payload") != 0))
+	bool isPayload = ((fileExtension.compare("payload") == 0) || (fileExtension.compare("mapstore") == 0));
+	if ((fileExtension.compare("nmap") != 0) && !isPayload)
 	{
 		initiated = true;
 		std::cout << "Start without nmap file. nmap save to " << mapFilePath << std::endl;
@@ -48,14 +50,19 @@ LocAware::LocAware(const std::string& fname, bool isSingleFrame /*=false*/)
 		initiated = false;
 		if ((fileExtension.compare("nmap") == 0) && !LocAware::readNmap(fname))
 		{ // read nmap file
-			mpIntersection.clear();
+			LocAware::clearIntersections();
 			std::cerr << "Failed reading nmap file " << fname << std::endl;
 		}
 		else if ((fileExtension.compare("payload") == 0) && !LocAware::readPayload(fname))
 		{ // read encoded MAP payload
-			mpIntersection.clear();
+			LocAware::clearIntersections();
 			std::cerr << "Failed reading payload file " << fname << std::endl;
 		}
+		else if ((fileExtension.compare("mapstore") == 0) && !LocAware::readMapStore(fname))
+		{ // read binary MAP payload store
+			LocAware::clearIntersections();
+			std::cerr << "Failed reading mapstore file " << fname << std::endl;
+		}
 		else
 		{ // link way-points of outbound lane to way-points of inbound lane of its downstream intersection
 			LocAware::setOutbond2InboundWaypoints();
@@ -63,6 +70,8 @@ LocAware::LocAware(const std::string& fname, bool isSingleFrame /*=false*/)
 			LocAware::setLocalOffsetAndHeading();
 			// build approach boxes
 			LocAware::buildPolygons();
+			// index intersections by location
+			LocAware::buildIntersectionGrid();
 			if (fileExtension.compare("nmap") == 0)
 			{ // encode MAP payload
 				std::cout << "Read " << mpIntersection.size() << " intersections" << std::endl;
@@ -70,7 +79,7 @@ LocAware::LocAware(const std::string& fname, bool isSingleFrame /*=false*/)
 				if (encoded_interections != mpIntersection.size())
 				{
 					std::cerr << "Encoded " << encoded_interections << " out of " << mpIntersection.size() << " intersections" << std::endl;
-					mpIntersection.clear();
+					LocAware::clearIntersections();
 				}
 				else
 				{
@@ -78,7 +87,7 @@ LocAware::LocAware(const std::string& fname, bool isSingleFrame /*=false*/)
 					initiated = true;
 				}
 			}
-			else if (fileExtension.compare("payload") == 0)
+			else if (isPayload)
 			{
 				std::cout << "Loaded MAP payload for " << mpIntersection.size() << " intersections" << std::endl;
 				initiated = true;
@@ -90,14 +99,23 @@ LocAware::LocAware(const std::string& fname, bool isSingleFrame /*=false*/)
 LocAware::~LocAware(void)
 	{mpIntersection.clear();}
 
+void LocAware::clearIntersections(void)
+{ // drop the intersections and everything that refers to them
+	mpIntersection.clear();
+	IndexMap.clear();
+	IdIndexMap.clear();
+	intersectionGrid.clear();
+	mapCache.clear();
+}
+
 auto ids2id = [](const uint16_t& regionalId, const uint16_t& intersectionId)->uint32_t
 	{return((uint32_t)(regionalId << 16) | intersectionId);};
 
 auto getIndexMapKey = [](const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId)->uint64_t
-	{return((uint64_t)((regionalId << 24) | (intersectionId << 8) | laneId));};
+	{return(((uint64_t)regionalId << 24) | ((uint64_t)intersectionId << 8) | laneId);};
 
-auto getIndexMapValue = [](const uint32_t& intIndx, const uint32_t& appIndx, const uint32_t& laneIndx)->uint32_t
-	{return((uint32_t)((intIndx << 16) | (appIndx << 8) | laneIndx));};
+auto getIndexMapValue = [](const uint32_t& intIndx, const uint32_t& appIndx, const uint32_t& laneIndx)->uint64_t
+	{return(((uint64_t)intIndx << 16) | (appIndx << 8) | laneIndx);};
 
 auto isEmptyStr = [](const std::string& str)->bool
 	{return(str.empty() || std::all_of(str.begin(), str.end(), isspace));};
@@ -350,20 +368,33 @@ auto getLaneRule = [](const std::bitset<20>& attributes)->std::vector<std::strin
 };
 
 /// --- start of functions to process the intersection nmap file --- ///
-std::vector<uint8_t> LocAware::getIndexesByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const
+std::vector<uint32_t> LocAware::getIndexesByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId) const
 {
-	std::vector<uint8_t> ret;
-	auto it = IndexMap.find(getIndexMapKey(regionalId, intersectionId, laneId));
-	if (it != IndexMap.end())
+	std::vector<uint32_t> ret;
+	uint32_t intIndx;
+	uint8_t appIndx, laneIndx;
+	if (LocAware::getIndexesByIds(regionalId, intersectionId, laneId, intIndx, appIndx, laneIndx))
 	{
-		uint32_t value = it->second;
-		ret.push_back(((value >> 16) & 0xFF));
-		ret.push_back(((value >> 8) & 0xFF));
-		ret.push_back((value & 0xFF));
+		ret.push_back(intIndx);
+		ret.push_back(appIndx);
+		ret.push_back(laneIndx);
 	}
 	return(ret);
 }
 
+bool LocAware::getIndexesByIds(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& laneId,
+	uint32_t& intIndx, uint8_t& appIndx, uint8_t& laneIndx) const
+{
+	auto it = IndexMap.find(getIndexMapKey(regionalId, intersectionId, laneId));
+	if (it == IndexMap.end())
+		return(false);
+	uint64_t value = it->second;
+	intIndx  = (uint32_t)((value >> 16) & 0xFFFFFFFF);
+	appIndx  = (uint8_t)((value >> 8) & 0xFF);
+	laneIndx = (uint8_t)(value & 0xFF);
+	return(true);
+}
+
 bool LocAware::readPayload(const std::string& fname)
 { // open payload file
 	std::ifstream IS_PAYLOAD(fname);
@@ -387,11 +418,12 @@ bool LocAware::readPayload(const std::string& fname)
 			iss >> std::skipws >> s >> intersectionName >> payload;
 			iss.clear();
 			// convert payload hex string to buffer
-			std::vector<uint8_t> buf;
-			for (size_t i = 0, j = payload.length(); i < j; i += 2)
+			std::vector<uint8_t> buf(payload.length() / 2);
+			if (buf.empty() || (MapStore::hex2bytes(payload.data(), payload.length(), &buf[0], buf.size()) == 0))
 			{
-				std::string byteString = payload.substr(i, 2);
-				buf.push_back(static_cast<uint8_t>(std::strtol(byteString.c_str(), NULL, 16)));
+				std::cerr << "readPayload: invalid hex MAP payload for " << intersectionName << std::endl;
+				has_error = true;
+				break;
 			}
 			uint32_t referenceId = LocAware::checkMapUpdate(&buf[0], buf.size());
 			if (referenceId == 0)
@@ -412,6 +444,28 @@ bool LocAware::readPayload(const std::string& fname)
 	return(!has_error);
 }
 
+bool LocAware::readMapStore(const std::string& fname)
+{ // map the store file, the payloads are decoded from the mapping
+	MapStore::MapStoreReader reader;
+	if (!reader.open(fname))
+	{
+		std::cerr << "readMapStore: failed open " << fname << std::endl;
+		return(false);
+	}
+	for (size_t i = 0; i < reader.size(); i++)
+	{
+		MapStore::mapView_t view = reader.at(i);
+		std::string intersectionName(view.name, view.nameLength);
+		if (LocAware::checkMapUpdate(view.payload, view.payloadSize) == 0)
+		{
+			std::cerr << "readMapStore: failed decoding MAP payload for " << intersectionName << std::endl;
+			return(false);
+		}
+		LocAware::setIntersectionName(intersectionName, view.regionalId, view.intersectionId);
+	}
+	return(true);
+}
+
 bool LocAware::readNmap(const std::string& fname)
 { // open nmap file
 	std::ifstream IS_NMAP(fname);
@@ -493,6 +547,7 @@ bool LocAware::readNmap(const std::string& fname)
 			iss.clear();
 			GeoUtils::geoPoint2geoRefPoint(geoPoint, pIntersection->geoRef);
 			GeoUtils::setEnuCoord(geoPoint, pIntersection->enuCoord);
+			GeoUtils::setLocalProj(geoPoint, pIntersection->localProj);
 		}
 		else if (line.find("ApproachID") != std::string::npos)
 		{ // beginning of a new approach
@@ -775,6 +830,7 @@ bool LocAware::readNmap(const std::string& fname)
 				std::cerr << "readNmap: missing speed limit for intersection " << pIntersection->name << std::endl;
 				has_error = true;
 			}
+			IdIndexMap[ids2id(pIntersection->regionalId, pIntersection->id)] = (uint32_t)mpIntersection.size();
 			mpIntersection.push_back(*pIntersection);
 			delete pIntersection;
 			pIntersection = nullptr;
@@ -810,10 +866,10 @@ bool LocAware::readNmap(const std::string& fname)
 				{
 					uint8_t conn2approachId = (conn2obj.laneId >> 4) & 0x0F;
 					uint8_t conn2laneIndx = conn2obj.laneId & 0x0F;
-					uint8_t conn2intersectionIndx = LocAware::getIndexByIntersectionId(conn2obj.regionalId, conn2obj.intersectionId);
-					uint8_t conn2approachIndx = (conn2intersectionIndx == 0xFF) ? 0xFF : LocAware::getIndexByApproachId(conn2intersectionIndx, conn2approachId);
+					uint32_t conn2intersectionIndx = LocAware::getIndexByIntersectionId(conn2obj.regionalId, conn2obj.intersectionId);
+					uint8_t conn2approachIndx = (conn2intersectionIndx == 0xFFFFFFFF) ? 0xFF : LocAware::getIndexByApproachId(conn2intersectionIndx, conn2approachId);
 					uint8_t conn2LaneId = (conn2approachIndx == 0xFF) ? 0 : LocAware::getLaneIdByIndexes(conn2intersectionIndx, conn2approachIndx, conn2laneIndx);
-					if ((conn2intersectionIndx == 0xFF) || (conn2approachIndx == 0xFF) || (conn2LaneId == 0))
+					if ((conn2intersectionIndx == 0xFFFFFFFF) || (conn2approachIndx == 0xFF) || (conn2LaneId == 0))
 					{
 						std::cerr << "readNmap: invalid Lane_ConnectsTo " << conn2obj.regionalId << "." << conn2obj.intersectionId << ".";
 						std::cerr << static_cast<unsigned int>(conn2approachId) << static_cast<unsigned int>(conn2laneIndx);
@@ -831,8 +887,8 @@ bool LocAware::readNmap(const std::string& fname)
 
 void LocAware::saveNmap(const uint16_t& regionalId, const uint16_t& intersectionId) const
 {
-	uint8_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
-	if (intIndex == 0xFF)
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	if (intIndex == 0xFFFFFFFF)
 		std::cerr << "saveNmap: intersection map object not exist for " << regionalId << "." << intersectionId << std::endl;
 	else
 		LocAware::saveNmap(mpIntersection[intIndex]);
@@ -1015,6 +1071,28 @@ void LocAware::getOutbond2InboundWaypoints(NmapData::IntersectionStruct& intObj)
 	}
 }
 
+auto compileLaneSegments = [](NmapData::LaneStruct& laneObj, const MsgEnum::approachType& type)->void
+{ // segments in the order projectPt2Lane walks the lane, each with the heading of its start node
+	laneObj.mpSegments.clear();
+	size_t numNodes = laneObj.mpNodes.size();
+	for (size_t k = 1; k < numNodes; k++)
+	{
+		size_t i = (type == MsgEnum::approachType::inbound) ? numNodes - k : k - 1;
+		size_t j = (type == MsgEnum::approachType::inbound) ? i - 1 : i + 1;
+		const auto& fromNodeObj = laneObj.mpNodes[i];
+		NmapData::SegmentStruct segObj;
+		segObj.ptStart = fromNodeObj.ptNode;
+		segObj.direction.set(fromNodeObj.ptNode, laneObj.mpNodes[j].ptNode);
+		segObj.length2 = std::abs((double)GeoUtils::dotProduct(segObj.direction, segObj.direction));
+		segObj.length = std::sqrt(segObj.length2);
+		double heading = DsrcConstants::deg2rad(DsrcConstants::deca2unit<uint16_t>(fromNodeObj.heading));
+		segObj.headingX = std::sin(heading);
+		segObj.headingY = std::cos(heading);
+		segObj.nodeIndex = static_cast<uint8_t>(i);
+		laneObj.mpSegments.push_back(segObj);
+	}
+};
+
 void LocAware::setLocalOffsetAndHeading(void)
 {
 	for (auto& intObj : mpIntersection)
@@ -1106,6 +1184,12 @@ void LocAware::setLocalOffsetAndHeading(NmapData::IntersectionStruct& intObj)
 			}
 		}
 	}
+	// compile mpSegments
+	for (auto& appObj : intObj.mpApproaches)
+	{
+		for (auto& laneObj : appObj.mpLanes)
+			compileLaneSegments(laneObj, appObj.type);
+	}
 }
 
 auto getBoundaryWaypoint = [](const GeoUtils::point2D_t& ptNode, const uint16_t& heading, const double& width, const bool& inbound)->GeoUtils::point2D_t
@@ -1172,10 +1256,11 @@ auto speed_mps2mph = [](const uint16_t& speed_limit)->uint8_t
 		((speed_limit == 0) ? 0 : static_cast<uint8_t>(round(DsrcConstants::unit2mph<uint16_t>(speed_limit)))));
 };
 
-auto IntObj2MapData = [](const NmapData::IntersectionStruct& intObj, MapData_element_t& mapData)->void
+/// returns false when intObj has more distinct speed limits or connecting lanes than J2735 allows
+auto IntObj2MapData = [](const NmapData::IntersectionStruct& intObj, MapData_element_t& mapData)->bool
 {
 	if (intObj.mpApproaches.empty())
-		return;
+		return(false);
 	mapData.reset();
 	mapData.regionalId       = intObj.regionalId;
 	mapData.id               = intObj.id;
@@ -1194,8 +1279,9 @@ auto IntObj2MapData = [](const NmapData::IntersectionStruct& intObj, MapData_ele
 		appData.id          = appObj.id;
 		appData.type        = appObj.type;
 		appData.speed_limit = speed_mph2mps(appObj.speed_limit);
-		if (std::find(mapData.speeds.begin(), mapData.speeds.end(),	appData.speed_limit) == mapData.speeds.end())
-			mapData.speeds.push_back(appData.speed_limit);
+		if ((std::find(mapData.speeds.begin(), mapData.speeds.end(),	appData.speed_limit) == mapData.speeds.end())
+				&& !mapData.speeds.push_back(appData.speed_limit))
+			return(false);
 		appData.mpLanes.resize(appObj.mpLanes.size());
 		size_t laneCnt = 0;
 		for (const auto& laneObj : appObj.mpLanes)
@@ -1208,7 +1294,8 @@ auto IntObj2MapData = [](const NmapData::IntersectionStruct& intObj, MapData_ele
 			laneData.controlPhase = laneObj.controlPhase;
 			if (!laneObj.mpConnectTo.empty())
 			{
-				laneData.mpConnectTo.resize(laneObj.mpConnectTo.size());
+				if (!laneData.mpConnectTo.resize(laneObj.mpConnectTo.size()))
+					return(false);
 				size_t connCnt = 0;
 				for (const auto& connObj : laneObj.mpConnectTo)
 				{
@@ -1237,6 +1324,7 @@ auto IntObj2MapData = [](const NmapData::IntersectionStruct& intObj, MapData_ele
 			}
 		}
 	}
+	return(true);
 };
 
 size_t LocAware::encode_mapdata_payload(void)
@@ -1247,9 +1335,9 @@ size_t LocAware::encode_mapdata_payload(void)
 	for (auto& intObj : mpIntersection)
 	{
 		intObj.mapPayload.resize(DsrcConstants::maxMsgSize);
-		IntObj2MapData(intObj, dsrcFrameIn.mapData);
 		dsrcFrameIn.mapData.isSingleFrame = speedLimitInLane;
-		size_t payload_size = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &intObj.mapPayload[0], intObj.mapPayload.size());
+		size_t payload_size = IntObj2MapData(intObj, dsrcFrameIn.mapData)
+			? AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &intObj.mapPayload[0], intObj.mapPayload.size()) : 0;
 		if (payload_size > 0)
 		{
 			intObj.mapPayload.resize(payload_size);
@@ -1263,7 +1351,32 @@ size_t LocAware::encode_mapdata_payload(void)
 }
 
 uint32_t LocAware::checkMapUpdate(const uint8_t* buf, size_t size)
-{ // decode MAP
+{ // a payload seen before, byte for byte, gets the same result, failures included
+	const uint32_t* pReferenceId = mapCache.find(buf, size);
+	if (pReferenceId != NULL)
+		return(*pReferenceId);
+	uint32_t referenceId = LocAware::checkMapPayload(buf, size);
+	uint32_t* pEntry = mapCache.insert(buf, size);
+	if (pEntry != NULL)
+		*pEntry = referenceId;
+	return(referenceId);
+}
+
+const AsnJ2735Lib::payloadCacheStats_t& LocAware::getMapCacheStats(void) const
+	{return(mapCache.getStats());}
+
+uint32_t LocAware::checkMapPayload(const uint8_t* buf, size_t size)
+{ // peek the leading fields, an unchanged MAP needs no decoding
+	AsnJ2735Lib::msgHeader_t header;
+	if (AsnJ2735Lib::peek_msgFrame(buf, size, header))
+	{
+		if (header.dsrcMsgId != MsgEnum::DSRCmsgID_map)
+			return(0);
+		uint32_t intIndx = LocAware::getIndexByIntersectionId(header.regionalId, header.intersectionId);
+		if ((intIndx < mpIntersection.size()) && (mpIntersection[intIndx].mapVersion == header.revision))
+			return(ids2id(header.regionalId, header.intersectionId));
+	}
+	// decode MAP
 	Frame_element_t dsrcFrameOut;
 	if ((AsnJ2735Lib::decode_msgFrame(buf, size, dsrcFrameOut) == 0) || (dsrcFrameOut.dsrcMsgId != MsgEnum::DSRCmsgID_map))
 		return(0);
@@ -1292,6 +1405,7 @@ uint32_t LocAware::checkMapUpdate(const uint8_t* buf, size_t size)
 	pIntObj->geoRef.longitude = mapIn.geoRef.longitude;
 	pIntObj->geoRef.elevation = mapIn.geoRef.elevation;
 	GeoUtils::setEnuCoord(pIntObj->geoRef, pIntObj->enuCoord);
+	GeoUtils::setLocalProj(pIntObj->geoRef, pIntObj->localProj);
 	pIntObj->mapPayload.assign(buf, buf + size);
 	pIntObj->radius = 0;
 	pIntObj->mpApproaches.resize(mapIn.mpApproaches.size());
@@ -1368,12 +1482,14 @@ uint32_t LocAware::checkMapUpdate(const uint8_t* buf, size_t size)
 		{
 			uint16_t regionalId = (uint16_t)((connId >> 16) & 0xFFFF);
 			uint16_t intersectionId = (uint16_t)(connId & 0xFFFF);
-			uint8_t  intIndex = getIndexByIntersectionId(regionalId, intersectionId);
-			if (intIndex == 0xFF)
+			uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+			if (intIndex == 0xFFFFFFFF)
 				continue;
 			auto& intObj = mpIntersection[intIndex];
+			LocAware::removeFromIntersectionGrid(intIndex);
 			LocAware::setLocalOffsetAndHeading(intObj);
 			LocAware::buildPolygons(intObj);
+			LocAware::addToIntersectionGrid(intIndex);
 		}
 		// link inbound lane way-points of this intersection to its upstream connected outbound lane
 		LocAware::getOutbond2InboundWaypoints(*pIntObj);
@@ -1394,21 +1510,23 @@ void LocAware::addIntersection(const NmapData::IntersectionStruct& intObj)
 {
 	uint16_t regionalId = intObj.regionalId;
 	uint16_t intersectionId = intObj.id;
-	auto it = std::find_if(mpIntersection.begin(), mpIntersection.end(),
-		[&regionalId, &intersectionId](const NmapData::IntersectionStruct& obj)
-		{return((obj.id == intersectionId) && (obj.regionalId == regionalId));});
-	if (it != mpIntersection.end())
-		it = mpIntersection.erase(it);
-	it = mpIntersection.insert(it, intObj);
-	// update IndexMap
-	uint8_t intIndx = (uint8_t)(it - mpIntersection.begin());
-	for (auto itMap = IndexMap.begin(); itMap != IndexMap.end();)
+	uint32_t intIndx = LocAware::getIndexByIntersectionId(regionalId, intersectionId);
+	if (intIndx != 0xFFFFFFFF)
+	{ // replace the MAP in place
+		LocAware::removeFromIntersectionGrid(intIndx);
+		mpIntersection[intIndx] = intObj;
+	}
+	else
 	{
-		if (((uint16_t)(((itMap->first) >> 8) & 0xFFFF) == intersectionId) && (((uint16_t)(((itMap->first) >> 24) & 0xFFFF) == regionalId)))
-			itMap = IndexMap.erase(itMap);
-		else
-			++itMap;
+		intIndx = (uint32_t)mpIntersection.size();
+		mpIntersection.push_back(intObj);
+		IdIndexMap[ids2id(regionalId, intersectionId)] = intIndx;
 	}
+	mapCache.clear();
+	// update intersectionGrid & IndexMap
+	LocAware::addToIntersectionGrid(intIndx);
+	IndexMap.erase(IndexMap.lower_bound(getIndexMapKey(regionalId, intersectionId, 0)),
+		IndexMap.upper_bound(getIndexMapKey(regionalId, intersectionId, 0xFF)));
 	uint8_t appIndx = 0;
 	for (const auto& appObj : intObj.mpApproaches)
 	{
@@ -1431,10 +1549,8 @@ bool LocAware::isInitiated(void) const
 
 uint8_t LocAware::getMapVersion(const uint16_t& regionalId, const uint16_t& intersectionId) const
 {
-	auto it = std::find_if(mpIntersection.begin(), mpIntersection.end(),
-		[&regionalId, &intersectionId](const NmapData::IntersectionStruct& obj)
-		{return((obj.id == intersectionId) && (obj.regionalId == regionalId));});
-	return((it != mpIntersection.end()) ? (it->mapVersion) : 0);
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	return((intIndex != 0xFFFFFFFF) ? mpIntersection[intIndex].mapVersion : 0);
 }
 
 std::vector<uint32_t> LocAware::getIntersectionIds(void) const
@@ -1447,17 +1563,15 @@ std::vector<uint32_t> LocAware::getIntersectionIds(void) const
 
 void LocAware::setIntersectionName(const std::string& name, const uint16_t& regionalId, const uint16_t& intersectionId)
 {
-	uint8_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
-	if (intIndex != 0xFF)
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	if (intIndex != 0xFFFFFFFF)
 		mpIntersection[intIndex].name = name;
 }
 
 std::string LocAware::getIntersectionNameById(const uint16_t& regionalId, const uint16_t& intersectionId) const
 {
-	auto it = std::find_if(mpIntersection.begin(), mpIntersection.end(),
-		[&regionalId, &intersectionId](const NmapData::IntersectionStruct& obj)
-		{return((obj.id == intersectionId) && (obj.regionalId == regionalId));});
-	return ((it != mpIntersection.end())	? (it->name) : std::string());
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	return((intIndex != 0xFFFFFFFF) ? mpIntersection[intIndex].name : std::string());
 }
 
 uint32_t LocAware::getIntersectionIdByName(const std::string& name) const
@@ -1467,20 +1581,18 @@ uint32_t LocAware::getIntersectionIdByName(const std::string& name) const
 	return((it != mpIntersection.end()) ? ids2id(it->regionalId, it->id) : 0);
 }
 
-uint8_t LocAware::getIndexByIntersectionId(const uint16_t& regionalId, const uint16_t& intersectionId) const
+uint32_t LocAware::getIndexByIntersectionId(const uint16_t& regionalId, const uint16_t& intersectionId) const
 {
-	auto it = std::find_if(mpIntersection.begin(), mpIntersection.end(),
-		[&regionalId, &intersectionId](const NmapData::IntersectionStruct& obj)
-		{return((obj.id == intersectionId) && (obj.regionalId == regionalId));});
-	return((uint8_t)((it != mpIntersection.end()) ? (it - mpIntersection.begin()) : 0xFF));
+	auto it = IdIndexMap.find(ids2id(regionalId, intersectionId));
+	return((it != IdIndexMap.end()) ? it->second : 0xFFFFFFFF);
 }
 
-std::string LocAware::getIntersectionNameByIndex(const uint8_t& intersectionIndex) const
+std::string LocAware::getIntersectionNameByIndex(const uint32_t& intersectionIndex) const
 {
 	return((intersectionIndex < mpIntersection.size()) ? mpIntersection[intersectionIndex].name : std::string());
 }
 
-uint8_t LocAware::getIndexByApproachId(const uint8_t& intersectionIndx, const uint8_t& approachId) const
+uint8_t LocAware::getIndexByApproachId(const uint32_t& intersectionIndx, const uint8_t& approachId) const
 {
 	const auto& approaches = mpIntersection[intersectionIndx].mpApproaches;
 	auto it = std::find_if(approaches.begin(), approaches.end(),
@@ -1496,8 +1608,8 @@ uint8_t LocAware::getControlPhaseByLaneId(const uint16_t& regionalId, const uint
 
 uint8_t LocAware::getControlPhaseByAprochId(const uint16_t& regionalId, const uint16_t& intersectionId, const uint8_t& approachId) const
 {
-	uint8_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
-	if ((intIndex == 0xFF) || (size_t)approachId > mpIntersection[intIndex].mpApproaches.size())
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	if ((intIndex == 0xFFFFFFFF) || (size_t)approachId > mpIntersection[intIndex].mpApproaches.size())
 		return(0);
 	auto& lanes = mpIntersection[intIndex].mpApproaches[approachId - 1].mpLanes;
 	auto it = std::find_if(lanes.begin(), lanes.end(),
@@ -1525,12 +1637,12 @@ uint32_t LocAware::getLaneLength(const uint16_t& regionalId, const uint16_t& int
 	return ((!inds.empty()) ? mpIntersection[inds[0]].mpApproaches[inds[1]].mpLanes[inds[2]].mpNodes.back().dTo1stNode : 0);
 }
 
-GeoUtils::geoRefPoint_t LocAware::getIntersectionRefPoint(const uint8_t& intersectionIndx) const
+GeoUtils::geoRefPoint_t LocAware::getIntersectionRefPoint(const uint32_t& intersectionIndx) const
 {
 	return(mpIntersection[intersectionIndx].geoRef);
 }
 
-uint8_t LocAware::getLaneIdByIndexes(const uint8_t& intersectionIndx, const uint8_t& approachIndx, const uint8_t& laneIndx) const
+uint8_t LocAware::getLaneIdByIndexes(const uint32_t& intersectionIndx, const uint8_t& approachIndx, const uint8_t& laneIndx) const
 {
 	return(((intersectionIndx < mpIntersection.size())
 		&& (approachIndx < mpIntersection[intersectionIndx].mpApproaches.size())
@@ -1540,20 +1652,16 @@ uint8_t LocAware::getLaneIdByIndexes(const uint8_t& intersectionIndx, const uint
 
 std::vector<uint8_t> LocAware::getMapdataPayload(const uint16_t& regionalId, const uint16_t& intersectionId) const
 {
-	auto it = std::find_if(mpIntersection.begin(), mpIntersection.end(),
-		[&regionalId, &intersectionId](const NmapData::IntersectionStruct& obj)
-		{return((obj.id == intersectionId) && (obj.regionalId == regionalId));});
-	return((it != mpIntersection.end()) ? it->mapPayload : std::vector<uint8_t>());
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	return((intIndex != 0xFFFFFFFF) ? mpIntersection[intIndex].mapPayload : std::vector<uint8_t>());
 }
 
 bool LocAware::getSpeedLimits(std::vector<uint8_t>& speedLimits, const uint16_t& regionalId, const uint16_t& intersectionId) const
 {
-	auto it = std::find_if(mpIntersection.begin(), mpIntersection.end(),
-		[&regionalId, &intersectionId](const NmapData::IntersectionStruct& obj)
-		{return((obj.id == intersectionId) && (obj.regionalId == regionalId));});
-	if (it == mpIntersection.end())
+	uint32_t intIndex = getIndexByIntersectionId(regionalId, intersectionId);
+	if (intIndex == 0xFFFFFFFF)
 		return(false);
-	for (auto& appObj : it->mpApproaches)
+	for (auto& appObj : mpIntersection[intIndex].mpApproaches)
 	{ /// one inbound approach could have multiple control phases (e.g., straight through & protected left-turn)
 		std::vector<uint8_t> controlPhases;
 		if ((appObj.type == MsgEnum::approachType::inbound) && !appObj.mpLanes.empty())
@@ -1577,7 +1685,7 @@ bool LocAware::getSpeedLimits(std::vector<uint8_t>& speedLimits, const uint16_t&
 auto isPointNearIntersection = [](const NmapData::IntersectionStruct& intObj, const GeoUtils::geoPoint_t& geoPoint)->bool
 { // check whether geoPt is inside radius of an intersection
 	GeoUtils::point3D_t ptENU;
-	GeoUtils::lla2enu(intObj.enuCoord, geoPoint, ptENU);
+	GeoUtils::lla2enu(intObj.localProj, geoPoint, ptENU);
 	return(sqrt(ptENU.x * ptENU.x + ptENU.y * ptENU.y) <= DsrcConstants::hecto2unit<int32_t>(intObj.radius));
 };
 
@@ -1587,35 +1695,38 @@ auto isPointInsideIntersectionBox = [](const NmapData::IntersectionStruct& intOb
 auto isPointOnApproach = [](const NmapData::ApproachStruct& appObj, const GeoUtils::point2D_t& ptENU)->bool
 	{return (GeoUtils::isPointInsidePolygon(appObj.mpPolygon, ptENU));};
 
-auto onApproaches = [](const NmapData::IntersectionStruct& intObj, const GeoUtils::point2D_t& ptENU)->std::vector<uint8_t>
+auto onApproaches = [](const NmapData::IntersectionStruct& intObj, const GeoUtils::point2D_t& ptENU, std::vector<uint8_t>& approachList)->void
 { // also do this when geoPoint is near the intersection (check first with isPointNearIntersection)
-	std::vector<uint8_t> ret;
+	approachList.clear();
 	for (auto it = intObj.mpApproaches.begin(); it != intObj.mpApproaches.end(); ++it)
 	{
 		if (!it->mpPolygon.empty() && isPointOnApproach(*it, ptENU))
-			ret.push_back(static_cast<uint8_t>(it - intObj.mpApproaches.begin()));
+			approachList.push_back(static_cast<uint8_t>(it - intObj.mpApproaches.begin()));
 	}
-	return(ret);
 };
 
-auto getHeadingDifference = [](const uint16_t& nodeHeading, const double& ptHeading)->double
-{ // headingDiff in [-180..180];
-	double d = ptHeading - DsrcConstants::deca2unit<uint16_t>(nodeHeading);
-	if (d > 180.0)
-		d -= 360.0;
-	else if (d < -180.0)
-		d += 360.0;
-	return(d);
+/// vehicle heading as a unit vector (east, north), and the bound of its dot product with the unit vector of
+/// a node heading, below which the node heading is off the vehicle heading by more than headingErrorBound
+struct headingTest_t
+{
+	double x;
+	double y;
+	double cosBound;
 };
 
-auto getHeadingErrorBound = [](const double& ptSpeed)->double
-{
-	return((ptSpeed < NmapData::lowSpeedThreshold) ? NmapData::headingErrorBoundLowSpeed : NmapData::headingErrorBoundNormal);
+auto getHeadingTest = [](const GeoUtils::motion_t& motionState)->headingTest_t
+{ // the cosine bound is taken 1e-9 short, so that a difference of exactly headingErrorBound passes despite rounding
+	static const double cosBoundNormal = std::cos(DsrcConstants::deg2rad(NmapData::headingErrorBoundNormal)) - 1e-9;
+	static const double cosBoundLowSpeed = (NmapData::headingErrorBoundLowSpeed >= 180.0) ? -2.0
+		: std::cos(DsrcConstants::deg2rad(NmapData::headingErrorBoundLowSpeed)) - 1e-9;
+	double heading = DsrcConstants::deg2rad(motionState.heading);
+	return(headingTest_t{std::sin(heading), std::cos(heading),
+		(motionState.speed < NmapData::lowSpeedThreshold) ? cosBoundLowSpeed : cosBoundNormal});
 };
 
 auto getIdxByLocationType = [](const std::vector<GeoUtils::vehicleTracking_t>& aVehicleTrackingState)->int
 {
-	std::vector<int> indexes(3, -1);
+	int indexes[3] = {-1, -1, -1};
 	for (int i = 0, j = (int)aVehicleTrackingState.size(); i < j; i++)
 	{
 		const auto& item = aVehicleTrackingState[i];
@@ -1683,7 +1794,9 @@ auto getIdx4minLatNode = [](const std::vector<GeoUtils::laneProjection_t>& aProj
 auto getIdx4specicalCase = [](const std::vector<GeoUtils::laneProjection_t>& aProj2Lane, const uint16_t& laneWidth)->int
 {
 	double dwidth = (double)laneWidth;
-	std::vector< std::pair<size_t, double> > candidates;
+	// the candidate with the minimum distance, the first one among equals
+	int idx = -1;
+	double dmin = 0.0;
 	for (size_t i = 0, j = aProj2Lane.size() - 1; i < j; i++)
 	{
 		const auto& item = aProj2Lane[i];
@@ -1692,51 +1805,35 @@ auto getIdx4specicalCase = [](const std::vector<GeoUtils::laneProjection_t>& aPr
 		double d2 = std::abs(nextItem.proj2segment.d);
 		if ((item.proj2segment.t > 1.0) && (d1 < dwidth) && (nextItem.proj2segment.t < 0.0) && (d2 < dwidth))
 		{
-			if (d1 < d2)
-				candidates.push_back(std::make_pair(i, d1));
-			else
-				candidates.push_back(std::make_pair(i+1, d2));
+			size_t candidate = (d1 < d2) ? i : i+1;
+			double d = (d1 < d2) ? d1 : d2;
+			if ((idx < 0) || (d < dmin))
+			{
+				idx = static_cast<int>(candidate);
+				dmin = d;
+			}
 		}
 	}
-	if (candidates.empty())
-		return(-1);
-	auto it = std::min_element(candidates.begin(), candidates.end(),
-		[](const std::pair<size_t, double>& s1, const std::pair<size_t, double>& s2){return(s1.second < s2.second);});
-	return((it != candidates.end()) ? (int)(it->first) : -1);
+	return(idx);
 };
 
-auto projectPt2Lane = [](const NmapData::LaneStruct& laneObj, const MsgEnum::approachType& type,
-	const GeoUtils::point2D_t& ptENU, const GeoUtils::motion_t& motionState)->GeoUtils::laneTracking_t
-{
-	double headingErrorBound = getHeadingErrorBound(motionState.speed);
-	std::vector<GeoUtils::laneProjection_t> aProj2Lane;
+auto projectPt2Lane = [](const NmapData::LaneStruct& laneObj, const GeoUtils::point2D_t& ptENU,
+	const headingTest_t& headingTest, std::vector<GeoUtils::laneProjection_t>& aProj2Lane)->GeoUtils::laneTracking_t
+{ // walk the compiled lane segments, skipping those with a start node heading too far from the vehicle heading
+	aProj2Lane.clear();
 	GeoUtils::laneProjection_t proj2lane;
 
-	if (type == MsgEnum::approachType::inbound)
+	for (const auto& segObj : laneObj.mpSegments)
 	{
-		for (uint8_t i = (uint8_t)(laneObj.mpNodes.size() - 1); i > 0; i--)
-		{
-			const auto& fromNodeObj = laneObj.mpNodes[i];
-			const auto& toNodeObj   = laneObj.mpNodes[i-1];
-			if (std::abs(getHeadingDifference(fromNodeObj.heading, motionState.heading)) > headingErrorBound)
-				continue;
-			proj2lane.nodeIndex = i;
-			GeoUtils::projectPt2Line(fromNodeObj.ptNode, toNodeObj.ptNode, ptENU, proj2lane.proj2segment);
-			aProj2Lane.push_back(proj2lane);
-		}
-	}
-	else
-	{ // outbound
-		for (uint8_t i = 0, j = (uint8_t)(laneObj.mpNodes.size() - 1); i < j; i++)
-		{
-			const auto& fromNodeObj = laneObj.mpNodes[i];
-			const auto& toNodeObj   = laneObj.mpNodes[i+1];
-			if (std::abs(getHeadingDifference(fromNodeObj.heading, motionState.heading)) > headingErrorBound)
-				continue;
-			proj2lane.nodeIndex = i;
-			GeoUtils::projectPt2Line(fromNodeObj.ptNode, toNodeObj.ptNode, ptENU, proj2lane.proj2segment);
-			aProj2Lane.push_back(proj2lane);
-		}
+		if (segObj.headingX * headingTest.x + segObj.headingY * headingTest.y < headingTest.cosBound)
+			continue;
+		GeoUtils::vector2D_t vb;
+		vb.set(segObj.ptStart, ptENU);
+		proj2lane.nodeIndex = segObj.nodeIndex;
+		proj2lane.proj2segment.t = (double)GeoUtils::dotProduct(vb, segObj.direction) / segObj.length2;
+		proj2lane.proj2segment.d = (double)GeoUtils::crossProduct(vb, segObj.direction) / segObj.length;
+		proj2lane.proj2segment.length = segObj.length;
+		aProj2Lane.push_back(proj2lane);
 	}
 
 	GeoUtils::laneTracking_t laneTrackingState{MsgEnum::laneLocType::outside,{0, {0.0, 0.0, 0.0}}};
@@ -1776,15 +1873,18 @@ auto projectPt2Lane = [](const NmapData::LaneStruct& laneObj, const MsgEnum::app
 };
 
 auto locateVehicleOnApproach = [](const NmapData::ApproachStruct& appObj, const GeoUtils::point2D_t& ptENU,
-	const GeoUtils::motion_t& motionState, GeoUtils::vehicleTracking_t& vehicleTrackingState)->bool
+	const GeoUtils::motion_t& motionState, GeoUtils::vehicleTracking_t& vehicleTrackingState, locateWorkspace_t& workspace)->bool
 {
 	vehicleTrackingState.reset();
-	std::vector<GeoUtils::laneTracking_t> aLaneTrackingState;
-	std::vector<size_t> aIndex;
+	headingTest_t headingTest = getHeadingTest(motionState);
+	auto& aLaneTrackingState = workspace.aLaneTrackingState;
+	auto& aIndex = workspace.aIndex;
+	aLaneTrackingState.clear();
+	aIndex.clear();
 	// one record per lane regardless whether the vehicle is on the lane or not
 	for (auto it =  appObj.mpLanes.begin(); it != appObj.mpLanes.end(); ++it)
 	{
-		auto laneTrackingState = projectPt2Lane(*it, appObj.type, ptENU, motionState);
+		auto laneTrackingState = projectPt2Lane(*it, ptENU, headingTest, workspace.aProj2Lane);
 		if (laneTrackingState.vehicleLaneStatus != MsgEnum::laneLocType::outside)
 		{
 			aLaneTrackingState.push_back(laneTrackingState);
@@ -1806,36 +1906,110 @@ auto locateVehicleOnApproach = [](const NmapData::ApproachStruct& appObj, const
 	return(false);
 };
 
-std::vector<uint8_t> LocAware::nearedIntersections(const GeoUtils::geoPoint_t& geoPoint) const
+/// size of a cell of intersectionGrid, in degrees (about 1.1 km north-south)
+static const double gridCellSize = 0.01;
+
+auto getGridCell = [](const double& degree)->int32_t
+	{return(static_cast<int32_t>(std::floor(degree / gridCellSize)));};
+
+auto getGridKey = [](const int32_t& latCell, const int32_t& lonCell)->uint64_t
+	{return(((uint64_t)((uint32_t)latCell) << 32) | (uint32_t)lonCell);};
+
+auto getGridCells = [](const NmapData::IntersectionStruct& intObj)->std::vector<int32_t>
+{ // cells covered by the bounding box of the intersection circle: latitude min & max, longitude min & max.
+	// the box is widened by 1% plus 1 meter, and degrees are taken short, so that it holds the circle
+	// as isPointNearIntersection measures it
+	double latitude  = DsrcConstants::damega2unit<int32_t>(intObj.geoRef.latitude);
+	double longitude = DsrcConstants::damega2unit<int32_t>(intObj.geoRef.longitude);
+	double radius = DsrcConstants::hecto2unit<uint32_t>(intObj.radius) * 1.01 + 1.0;
+	double dLat = radius / 110000.0;
+	double edgeLat = std::min(std::abs(latitude) + dLat, 89.0);
+	double dLon = radius / (111000.0 * std::cos(DsrcConstants::deg2rad(edgeLat)));
+	return(std::vector<int32_t>{getGridCell(latitude - dLat), getGridCell(latitude + dLat),
+		getGridCell(longitude - dLon), getGridCell(longitude + dLon)});
+};
+
+void LocAware::buildIntersectionGrid(void)
 {
-	std::vector<uint8_t> ret;
-	for (auto it = mpIntersection.begin(); it != mpIntersection.end(); ++it)
+	intersectionGrid.clear();
+	for (size_t i = 0; i < mpIntersection.size(); i++)
+		LocAware::addToIntersectionGrid(static_cast<uint32_t>(i));
+}
+
+void LocAware::addToIntersectionGrid(const uint32_t& intIndx)
+{
+	std::vector<int32_t> cells = getGridCells(mpIntersection[intIndx]);
+	for (int32_t latCell = cells[0]; latCell <= cells[1]; latCell++)
 	{
-		GeoUtils::geoPoint_t pt{geoPoint.latitude, geoPoint.longitude, DsrcConstants::deca2unit<int32_t>(it->geoRef.elevation)};
-		if (isPointNearIntersection(*it, pt))
-			ret.push_back(static_cast<uint8_t>(it - mpIntersection.begin()));
+		for (int32_t lonCell = cells[2]; lonCell <= cells[3]; lonCell++)
+		{
+			auto& indexes = intersectionGrid[getGridKey(latCell, lonCell)];
+			auto it = std::lower_bound(indexes.begin(), indexes.end(), intIndx);
+			if ((it == indexes.end()) || (*it != intIndx))
+				indexes.insert(it, intIndx);
+		}
 	}
+}
+
+void LocAware::removeFromIntersectionGrid(const uint32_t& intIndx)
+{ // call before the geoRef or radius of the intersection changes
+	std::vector<int32_t> cells = getGridCells(mpIntersection[intIndx]);
+	for (int32_t latCell = cells[0]; latCell <= cells[1]; latCell++)
+	{
+		for (int32_t lonCell = cells[2]; lonCell <= cells[3]; lonCell++)
+		{
+			auto itCell = intersectionGrid.find(getGridKey(latCell, lonCell));
+			if (itCell == intersectionGrid.end())
+				continue;
+			auto& indexes = itCell->second;
+			indexes.erase(std::remove(indexes.begin(), indexes.end(), intIndx), indexes.end());
+			if (indexes.empty())
+				intersectionGrid.erase(itCell);
+		}
+	}
+}
+
+std::vector<uint32_t> LocAware::nearedIntersections(const GeoUtils::geoPoint_t& geoPoint) const
+{
+	std::vector<uint32_t> ret;
+	LocAware::nearedIntersections(geoPoint, ret);
 	return(ret);
 }
 
+void LocAware::nearedIntersections(const GeoUtils::geoPoint_t& geoPoint, std::vector<uint32_t>& intersectionList) const
+{ // candidates are the intersections whose bounding box overlaps the grid cell of geoPoint
+	intersectionList.clear();
+	auto itCell = intersectionGrid.find(getGridKey(getGridCell(geoPoint.latitude), getGridCell(geoPoint.longitude)));
+	if (itCell == intersectionGrid.end())
+		return;
+	for (const auto& intIndx : itCell->second)
+	{
+		const auto& intObj = mpIntersection[intIndx];
+		GeoUtils::geoPoint_t pt{geoPoint.latitude, geoPoint.longitude, DsrcConstants::deca2unit<int32_t>(intObj.geoRef.elevation)};
+		if (isPointNearIntersection(intObj, pt))
+			intersectionList.push_back(intIndx);
+	}
+}
+
 bool LocAware::isOutboundConnect2Inbound(const NmapData::ConnectStruct& connObj, const GeoUtils::geoPoint_t& geoPoint,
-	const GeoUtils::motion_t& motionState, GeoUtils::vehicleTracking_t& vehicleTrackingState) const
+	const GeoUtils::motion_t& motionState, GeoUtils::vehicleTracking_t& vehicleTrackingState, locateWorkspace_t& workspace) const
 {
-	std::vector<uint8_t> connectToindex = LocAware::getIndexesByIds(connObj.regionalId, connObj.intersectionId, connObj.laneId);
-	if (!connectToindex.empty())
+	uint32_t intIndx;
+	uint8_t appIndx, laneIndx;
+	if (LocAware::getIndexesByIds(connObj.regionalId, connObj.intersectionId, connObj.laneId, intIndx, appIndx, laneIndx))
 	{
-		const auto& intObj = mpIntersection[connectToindex[0]];
-		const auto& appObj = intObj.mpApproaches[connectToindex[1]];
+		const auto& intObj = mpIntersection[intIndx];
+		const auto& appObj = intObj.mpApproaches[appIndx];
 		if (appObj.type == MsgEnum::approachType::inbound)
 		{	// convert geoPoint to ptENU at connectTo intersection
 			GeoUtils::geoPoint_t pt{geoPoint.latitude, geoPoint.longitude, DsrcConstants::deca2unit<int32_t>(intObj.geoRef.elevation)};
 			GeoUtils::point2D_t ptENU;
-			GeoUtils::lla2enu(intObj.enuCoord, pt, ptENU);
+			GeoUtils::lla2enu(intObj.localProj, pt, ptENU);
 			// check whether ptENU is onInbound
-			if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, motionState, vehicleTrackingState))
+			if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, motionState, vehicleTrackingState, workspace))
 			{
-				vehicleTrackingState.intsectionTrackingState.intersectionIndex = connectToindex[0];
-				vehicleTrackingState.intsectionTrackingState.approachIndex = connectToindex[1];
+				vehicleTrackingState.intsectionTrackingState.intersectionIndex = intIndx;
+				vehicleTrackingState.intsectionTrackingState.approachIndex = appIndx;
 				return(true);
 			}
 		}
@@ -1860,19 +2034,28 @@ auto getPtDist2egress = [](const NmapData::ApproachStruct& appObj, const GeoUtil
 
 bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUtils::vehicleTracking_t& cvTrackingState) const
 {
+	locateWorkspace_t workspace;
+	return(LocAware::locateVehicleInMap(cv, cvTrackingState, workspace));
+}
+
+bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUtils::vehicleTracking_t& cvTrackingState,
+	locateWorkspace_t& workspace) const
+{ // the vectors are those of workspace, cleared before use
 	cvTrackingState.reset();
 	if (!cv.isVehicleInMap)
 	{ // find target intersections that geoPoint is on
-		auto intersectionList = LocAware::nearedIntersections(cv.geoPoint);
+		auto& intersectionList = workspace.intersectionList;
+		LocAware::nearedIntersections(cv.geoPoint, intersectionList);
 		if (intersectionList.empty())
 			return(false);
-		std::vector<GeoUtils::vehicleTracking_t> aVehicleTrackingState; // at most one record per intersection
+		auto& aVehicleTrackingState = workspace.aVehicleTrackingState; // at most one record per intersection
+		aVehicleTrackingState.clear();
 		for (const auto& intIndx : intersectionList)
 		{ // convert cv.geoPoint to ptENU
 			const auto& intObj = mpIntersection[intIndx];
 			GeoUtils::geoPoint_t pt{cv.geoPoint.latitude, cv.geoPoint.longitude, DsrcConstants::deca2unit<int32_t>(intObj.geoRef.elevation)};
 			GeoUtils::point2D_t ptENU;
-			GeoUtils::lla2enu(intObj.enuCoord, pt, ptENU);
+			GeoUtils::lla2enu(intObj.localProj, pt, ptENU);
 			GeoUtils::vehicleTracking_t vehicleTrackingState;
 			vehicleTrackingState.reset();
 			// check whether ptENU is inside intersection box first
@@ -1884,15 +2067,17 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 				continue;
 			}
 			// find target approaches that ptENU is on
-			auto approachList = onApproaches(intObj, ptENU);
+			auto& approachList = workspace.approachList;
+			onApproaches(intObj, ptENU, approachList);
 			if (approachList.empty())
 				continue;
-			std::vector<GeoUtils::vehicleTracking_t> aApproachTrackingState; // at most one record per approach
+			auto& aApproachTrackingState = workspace.aApproachTrackingState; // at most one record per approach
+			aApproachTrackingState.clear();
 			// find target lanes that ptENU is on
 			for (const auto& appIndx : approachList)
 			{
 				const auto& appObj = intObj.mpApproaches[appIndx];
-				if (!appObj.mpLanes.empty() && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState))
+				if (!appObj.mpLanes.empty() && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 				{
 					vehicleTrackingState.intsectionTrackingState.intersectionIndex = intIndx;
 					vehicleTrackingState.intsectionTrackingState.approachIndex = appIndx;
@@ -1925,7 +2110,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 	// convert cv.geoPoint to ptENU
 	GeoUtils::geoPoint_t pt{cv.geoPoint.latitude, cv.geoPoint.longitude, DsrcConstants::deca2unit<int32_t>(intObj.geoRef.elevation)};
 	GeoUtils::point2D_t ptENU;
-	GeoUtils::lla2enu(intObj.enuCoord, pt, ptENU);
+	GeoUtils::lla2enu(intObj.localProj, pt, ptENU);
 	// action based on the previous vehicleIntersectionStatus
 	if (prevIntTrackingState.vehicleIntersectionStatus == MsgEnum::mapLocType::insideIntersectionBox)
 	{ // vehicle was initiated inside the intersection box, so approachIndex & laneIndex are unknown.
@@ -1941,8 +2126,10 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 			return(true);
 		}
 		// vehicle is not insideIntersectionBox, check whether it is on an outbound lane (onOutbound)
-		std::vector<GeoUtils::vehicleTracking_t> aApproachTrackingState;
-		auto approachList = onApproaches(intObj, ptENU);
+		auto& aApproachTrackingState = workspace.aApproachTrackingState;
+		aApproachTrackingState.clear();
+		auto& approachList = workspace.approachList;
+		onApproaches(intObj, ptENU, approachList);
 		if (!approachList.empty())
 		{
 			for (const auto& appIndx: approachList)
@@ -1950,7 +2137,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 				const auto& appObj = intObj.mpApproaches[appIndx];
 				GeoUtils::vehicleTracking_t vehicleTrackingState;
 				vehicleTrackingState.reset();
-				if ((appObj.type == MsgEnum::approachType::outbound) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState))
+				if ((appObj.type == MsgEnum::approachType::outbound) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 				{
 					vehicleTrackingState.intsectionTrackingState.intersectionIndex = intersectionIndex;
 					vehicleTrackingState.intsectionTrackingState.approachIndex = appIndx;
@@ -1970,7 +2157,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 		{
 			GeoUtils::vehicleTracking_t inboundTrackingState;
 			inboundTrackingState.reset();
-			if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState))
+			if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState, workspace))
 			{
 				cvTrackingState = inboundTrackingState;
 				return(true);
@@ -1994,7 +2181,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 		// check whether vehicle remains onInbound
 		GeoUtils::vehicleTracking_t vehicleTrackingState;
 		vehicleTrackingState.reset();
-		if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState))
+		if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 		{
 			vehicleTrackingState.intsectionTrackingState.intersectionIndex = intersectionIndex;
 			vehicleTrackingState.intsectionTrackingState.approachIndex = approachIndex;
@@ -2011,7 +2198,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 				}
 				else if (std::abs(vehicleTrackingState.laneProj.proj2segment.d) >= std::abs(cv.vehicleTrackingState.laneProj.proj2segment.d) / 2.0)
 				{
-					auto laneTrackingState = projectPt2Lane(laneObj, appObj.type, ptENU, cv.motionState);
+					auto laneTrackingState = projectPt2Lane(laneObj, ptENU, getHeadingTest(cv.motionState), workspace.aProj2Lane);
 					if (laneTrackingState.vehicleLaneStatus == MsgEnum::laneLocType::inside)
 					{ // maintain the lane
 						cvTrackingState.intsectionTrackingState = prevIntTrackingState;
@@ -2022,15 +2209,19 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 			return(true);
 		}
 		// vehicle is not onInbound, check whether it is on its connecting outbound lane (onOutbound) at the same intersection
-		std::vector<uint8_t> connAppIndex;
+		auto& connAppIndex = workspace.connAppIndex;
+		connAppIndex.clear();
 		for (const auto& connObj : laneObj.mpConnectTo)
 		{
-			auto connectToindex = LocAware::getIndexesByIds(connObj.regionalId, connObj.intersectionId, connObj.laneId);
-			if (!connectToindex.empty())
-				connAppIndex.push_back(connectToindex[1]);
-		}
-		std::vector<GeoUtils::vehicleTracking_t> aApproachTrackingState;
-		auto approachList = onApproaches(intObj, ptENU);
+			uint32_t connIntIndx;
+			uint8_t connAppIndx, connLaneIndx;
+			if (LocAware::getIndexesByIds(connObj.regionalId, connObj.intersectionId, connObj.laneId, connIntIndx, connAppIndx, connLaneIndx))
+				connAppIndex.push_back(connAppIndx);
+		}
+		auto& aApproachTrackingState = workspace.aApproachTrackingState;
+		aApproachTrackingState.clear();
+		auto& approachList = workspace.approachList;
+		onApproaches(intObj, ptENU, approachList);
 		if (!approachList.empty())
 		{
 			for (const auto& appIndx : approachList)
@@ -2038,7 +2229,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 				const auto& connAppObj = intObj.mpApproaches[appIndx];
 				if ((connAppObj.type == MsgEnum::approachType::outbound)
 						&& (std::find(connAppIndex.begin(), connAppIndex.end(), appIndx) != connAppIndex.end())
-						&& locateVehicleOnApproach(connAppObj, ptENU, cv.motionState, vehicleTrackingState))
+						&& locateVehicleOnApproach(connAppObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 				{
 					vehicleTrackingState.intsectionTrackingState.intersectionIndex = intersectionIndex;
 					vehicleTrackingState.intsectionTrackingState.approachIndex = appIndx;
@@ -2057,7 +2248,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 			{
 				GeoUtils::vehicleTracking_t inboundTrackingState;
 				inboundTrackingState.reset();
-				if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState))
+				if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState, workspace))
 				{
 					cvTrackingState = inboundTrackingState;
 					return(true);
@@ -2098,7 +2289,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 		{
 			GeoUtils::vehicleTracking_t inboundTrackingState;
 			inboundTrackingState.reset();
-			if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState))
+			if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState, workspace))
 			{
 				cvTrackingState = inboundTrackingState;
 				return(true);
@@ -2107,7 +2298,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 		// vehicle not entered onInbound, check whether it remains onOutbound
 		GeoUtils::vehicleTracking_t vehicleTrackingState;
 		vehicleTrackingState.reset();
-		if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState))
+		if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 		{ // remains onOutbound
 			vehicleTrackingState.intsectionTrackingState.intersectionIndex = intersectionIndex;
 			vehicleTrackingState.intsectionTrackingState.approachIndex = approachIndex;
@@ -2128,16 +2319,20 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 		const auto& appObj  = intObj.mpApproaches[approachIndex];
 		const auto& laneObj = appObj.mpLanes[laneIndex];
 		// check whether vehicle is on connecting outbound lane (onOutbound)
-		std::vector<uint8_t> connAppIndex;
+		auto& connAppIndex = workspace.connAppIndex;
+		connAppIndex.clear();
 		for (const auto& connObj : laneObj.mpConnectTo)
 		{
-			auto connectToindex = LocAware::getIndexesByIds(connObj.regionalId, connObj.intersectionId, connObj.laneId);
-			if (!connectToindex.empty())
-				connAppIndex.push_back(connectToindex[1]);
-		}
-		std::vector<GeoUtils::vehicleTracking_t> aApproachTrackingState;
-		std::vector<double> dist2egress;
-		auto approachList = onApproaches(intObj, ptENU);
+			uint32_t connIntIndx;
+			uint8_t connAppIndx, connLaneIndx;
+			if (LocAware::getIndexesByIds(connObj.regionalId, connObj.intersectionId, connObj.laneId, connIntIndx, connAppIndx, connLaneIndx))
+				connAppIndex.push_back(connAppIndx);
+		}
+		auto& aApproachTrackingState = workspace.aApproachTrackingState;
+		aApproachTrackingState.clear();
+		bool isNearEgress = false;
+		auto& approachList = workspace.approachList;
+		onApproaches(intObj, ptENU, approachList);
 		if (!approachList.empty())
 		{
 			for (const auto& appIndx : approachList)
@@ -2148,7 +2343,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 				{
 					GeoUtils::vehicleTracking_t vehicleTrackingState;
 					vehicleTrackingState.reset();
-					if (locateVehicleOnApproach(connAppObj, ptENU, cv.motionState, vehicleTrackingState))
+					if (locateVehicleOnApproach(connAppObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 					{
 						vehicleTrackingState.intsectionTrackingState.intersectionIndex = intersectionIndex;
 						vehicleTrackingState.intsectionTrackingState.approachIndex = appIndx;
@@ -2156,7 +2351,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 					}
 					double d = getPtDist2egress(connAppObj, ptENU);
 					if (d < intObj.mpApproaches[appIndx].mindist2intsectionCentralLine / 2.0)
-					 dist2egress.push_back(d);
+						isNearEgress = true;
 				}
 			}
 		}
@@ -2171,7 +2366,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 			{
 				GeoUtils::vehicleTracking_t inboundTrackingState;
 				inboundTrackingState.reset();
-				if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState))
+				if (LocAware::isOutboundConnect2Inbound(connectTo[0], cv.geoPoint, cv.motionState, inboundTrackingState, workspace))
 				{
 					cvTrackingState = inboundTrackingState;
 					return(true);
@@ -2184,7 +2379,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 		// vehicle is not onOutbound, check whether ptENU is on the approach it entered the intersection box (onInbound)
 		GeoUtils::vehicleTracking_t vehicleTrackingState;
 		vehicleTrackingState.reset();
-		if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState))
+		if (isPointOnApproach(appObj, ptENU) && locateVehicleOnApproach(appObj, ptENU, cv.motionState, vehicleTrackingState, workspace))
 		{
 			vehicleTrackingState.intsectionTrackingState.intersectionIndex = intersectionIndex;
 			vehicleTrackingState.intsectionTrackingState.approachIndex = approachIndex;
@@ -2206,7 +2401,7 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 			return(true);
 		}
 		// vehicle is not near onInbound, check whether it's near onOutbound
-		if (!dist2egress.empty())
+		if (isNearEgress)
 		{ // set vehicleIntersectionStatus to atIntersectionBox
 			cvTrackingState.intsectionTrackingState = prevIntTrackingState;
 			cvTrackingState.intsectionTrackingState.vehicleIntersectionStatus = MsgEnum::mapLocType::atIntersectionBox;
@@ -2219,6 +2414,39 @@ bool LocAware::locateVehicleInMap(const GeoUtils::connectedVehicle_t& cv, GeoUti
 	}
 }
 
+void LocAware::reserveWorkspace(locateWorkspace_t& workspace) const
+{ // the largest number of intersections in a grid cell, of approaches at an intersection,
+	// of lanes on an approach, of segments on a lane and of connections of a lane
+	size_t numIntersections = 0;
+	size_t numApproaches = 0;
+	size_t numLanes = 0;
+	size_t numSegments = 0;
+	size_t numConnects = 0;
+	for (const auto& cell : intersectionGrid)
+		numIntersections = std::max(numIntersections, cell.second.size());
+	for (const auto& intObj : mpIntersection)
+	{
+		numApproaches = std::max(numApproaches, intObj.mpApproaches.size());
+		for (const auto& appObj : intObj.mpApproaches)
+		{
+			numLanes = std::max(numLanes, appObj.mpLanes.size());
+			for (const auto& laneObj : appObj.mpLanes)
+			{
+				numSegments = std::max(numSegments, laneObj.mpSegments.size());
+				numConnects = std::max(numConnects, laneObj.mpConnectTo.size());
+			}
+		}
+	}
+	workspace.intersectionList.reserve(numIntersections);
+	workspace.aVehicleTrackingState.reserve(numIntersections);
+	workspace.approachList.reserve(numApproaches);
+	workspace.aApproachTrackingState.reserve(numApproaches);
+	workspace.aLaneTrackingState.reserve(numLanes);
+	workspace.aIndex.reserve(numLanes);
+	workspace.aProj2Lane.reserve(numSegments);
+	workspace.connAppIndex.reserve(numConnects);
+}
+
 void LocAware::updateLocationAware(const GeoUtils::vehicleTracking_t& vehicleTrackingState, GeoUtils::locationAware_t& vehicleLocationAware) const
 {
 	vehicleLocationAware.reset();
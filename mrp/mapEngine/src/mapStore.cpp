@@ -0,0 +1,307 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* mapStore.cpp
+ * Hex and binary files of encoded MAP payloads.
+ * hex2bytes converts 16 hex digits at a time with SSE2 where the compiler targets it, and one digit
+ * pair at a time otherwise and for the tail. A .mapstore file is mapped read-only; its index is
+ * checked once in open(), after which lookups and payload views only do pointer arithmetic.
+ */
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "AsnJ2735Lib.h"
+#include "mapStore.h"
+
+static const char storeMagic[8] = {'M', 'R', 'P', 'M', 'A', 'P', 'S', '\0'};
+static const uint32_t storeVersion = 1;
+static const size_t storeHeaderSize = 16;
+static const size_t storeEntrySize = 16;
+
+auto get16 = [](const uint8_t* p)->uint16_t
+	{return(static_cast<uint16_t>(p[0] | (p[1] << 8)));};
+
+auto get32 = [](const uint8_t* p)->uint32_t
+	{return(static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16)) | (static_cast<uint32_t>(p[3]) << 24));};
+
+auto put16 = [](std::vector<uint8_t>& buf, uint16_t value)->void
+{
+	buf.push_back(static_cast<uint8_t>(value & 0xFF));
+	buf.push_back(static_cast<uint8_t>(value >> 8));
+};
+
+auto put32 = [](std::vector<uint8_t>& buf, uint32_t value)->void
+{
+	for (int shift = 0; shift < 32; shift += 8)
+		buf.push_back(static_cast<uint8_t>((value >> shift) & 0xFF));
+};
+
+/// value of a hex digit, -1 for any other character
+auto hexNibble = [](uint8_t c)->int
+{
+	if ((c >= '0') && (c <= '9'))
+		return(c - '0');
+	c = static_cast<uint8_t>(c | 0x20);
+	if ((c >= 'a') && (c <= 'f'))
+		return(c - 'a' + 10);
+	return(-1);
+};
+
+size_t MapStore::hex2bytes(const char* hex, size_t numChars, uint8_t* buf, size_t size)
+{
+	if (((numChars & 0x01) != 0) || (numChars / 2 > size))
+		return(0);
+	size_t i = 0;
+#if defined(__SSE2__)
+	/// 16 digits to 8 bytes: the value of each digit, selected from the digit and the letter ranges,
+	/// then each pair of values combined in a 16-bit lane and packed down to bytes
+	const __m128i zero9Lo = _mm_set1_epi8('0' - 1);
+	const __m128i zero9Hi = _mm_set1_epi8('9' + 1);
+	const __m128i afLo = _mm_set1_epi8('a' - 1);
+	const __m128i afHi = _mm_set1_epi8('f' + 1);
+	const __m128i lowerCase = _mm_set1_epi8(0x20);
+	const __m128i digitBase = _mm_set1_epi8('0');
+	const __m128i letterBase = _mm_set1_epi8('a' - 10);
+	const __m128i lowByte = _mm_set1_epi16(0x00FF);
+	for (; i + 16 <= numChars; i += 16)
+	{
+		__m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i));
+		__m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, zero9Lo), _mm_cmplt_epi8(chars, zero9Hi));
+		__m128i lower = _mm_or_si128(chars, lowerCase);
+		__m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, afLo), _mm_cmplt_epi8(lower, afHi));
+		if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF)
+			return(0);
+		__m128i values = _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(chars, digitBase)),
+			_mm_andnot_si128(isDigit, _mm_sub_epi8(lower, letterBase)));
+		__m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, lowByte), 4), _mm_srli_epi16(values, 8));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(buf + i / 2), _mm_packus_epi16(pairs, pairs));
+	}
+#endif
+	for (; i < numChars; i += 2)
+	{
+		int hi = hexNibble(static_cast<uint8_t>(hex[i]));
+		int lo = hexNibble(static_cast<uint8_t>(hex[i + 1]));
+		if ((hi < 0) || (lo < 0))
+			return(0);
+		buf[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+	}
+	return(numChars / 2);
+}
+
+bool MapStore::readPayloadFile(const std::string& fname, std::vector<mapEntry_t>& entries)
+{
+	std::ifstream IS_PAYLOAD(fname);
+	if (!IS_PAYLOAD.is_open())
+	{
+		std::cerr << "readPayloadFile: failed open " << fname << std::endl;
+		return(false);
+	}
+	std::istringstream iss;
+	std::string line, s, payload;
+	while (std::getline(IS_PAYLOAD, line))
+	{
+		if (line.find("payload") == std::string::npos)
+			continue;
+		mapEntry_t entry;
+		iss.str(line);
+		iss >> std::skipws >> s >> entry.name >> payload;
+		iss.clear();
+		entry.payload.resize(payload.length() / 2);
+		AsnJ2735Lib::msgHeader_t header;
+		if (entry.payload.empty()
+			|| (hex2bytes(payload.data(), payload.length(), &entry.payload[0], entry.payload.size()) == 0)
+			|| !AsnJ2735Lib::peek_msgFrame(&entry.payload[0], entry.payload.size(), header)
+			|| (header.dsrcMsgId != MsgEnum::DSRCmsgID_map))
+		{
+			std::cerr << "readPayloadFile: invalid MAP payload for " << entry.name << std::endl;
+			return(false);
+		}
+		entry.regionalId = header.regionalId;
+		entry.intersectionId = header.intersectionId;
+		entries.push_back(entry);
+	}
+	return(true);
+}
+
+bool MapStore::writePayloadFile(const std::string& fname, const std::vector<mapEntry_t>& entries)
+{
+	std::ofstream OS_PAYLOAD(fname);
+	if (!OS_PAYLOAD.is_open())
+	{
+		std::cerr << "writePayloadFile: failed open " << fname << std::endl;
+		return(false);
+	}
+	for (const auto& entry : entries)
+	{
+		OS_PAYLOAD << "payload " << entry.name << " " << std::hex << std::uppercase << std::setfill('0');
+		for (const auto& byte : entry.payload)
+			OS_PAYLOAD << std::setw(2) << static_cast<unsigned int>(byte);
+		OS_PAYLOAD << std::dec << std::endl;
+	}
+	return(OS_PAYLOAD.good());
+}
+
+bool MapStore::writeMapStore(const std::string& fname, const std::vector<mapEntry_t>& entries)
+{
+	auto getKey = [](const mapEntry_t& entry)->uint32_t
+		{return((static_cast<uint32_t>(entry.regionalId) << 16) | entry.intersectionId);};
+	std::vector<const mapEntry_t*> sorted;
+	for (const auto& entry : entries)
+	{
+		if ((entry.name.length() > 0xFF) || entry.payload.empty() || (entry.payload.size() > 0xFFFF))
+		{
+			std::cerr << "writeMapStore: invalid name or payload size for " << entry.name << std::endl;
+			return(false);
+		}
+		sorted.push_back(&entry);
+	}
+	std::sort(sorted.begin(), sorted.end(), [&getKey](const mapEntry_t* a, const mapEntry_t* b)->bool
+		{return(getKey(*a) < getKey(*b));});
+	for (size_t i = 1; i < sorted.size(); i++)
+	{
+		if (getKey(*sorted[i]) == getKey(*sorted[i - 1]))
+		{
+			std::cerr << "writeMapStore: " << sorted[i - 1]->name << " and " << sorted[i]->name
+				<< " have the same intersection ID" << std::endl;
+			return(false);
+		}
+	}
+	std::vector<uint8_t> buf(storeMagic, storeMagic + sizeof(storeMagic));
+	put32(buf, storeVersion);
+	put32(buf, static_cast<uint32_t>(sorted.size()));
+	size_t offset = storeHeaderSize + sorted.size() * storeEntrySize;
+	for (const auto pEntry : sorted)
+	{
+		put16(buf, pEntry->regionalId);
+		put16(buf, pEntry->intersectionId);
+		put32(buf, static_cast<uint32_t>(offset + pEntry->name.length()));
+		put16(buf, static_cast<uint16_t>(pEntry->payload.size()));
+		buf.push_back(static_cast<uint8_t>(pEntry->name.length()));
+		buf.push_back(0);
+		put32(buf, static_cast<uint32_t>(offset));
+		offset += pEntry->name.length() + pEntry->payload.size();
+	}
+	for (const auto pEntry : sorted)
+	{
+		buf.insert(buf.end(), pEntry->name.begin(), pEntry->name.end());
+		buf.insert(buf.end(), pEntry->payload.begin(), pEntry->payload.end());
+	}
+	std::ofstream OS_STORE(fname, std::ios::binary);
+	if (!OS_STORE.is_open())
+	{
+		std::cerr << "writeMapStore: failed open " << fname << std::endl;
+		return(false);
+	}
+	OS_STORE.write(reinterpret_cast<const char*>(&buf[0]), static_cast<std::streamsize>(buf.size()));
+	return(OS_STORE.good());
+}
+
+MapStore::MapStoreReader::MapStoreReader(void) : pFile(NULL), fileSize(0), numEntries(0)
+	{}
+
+MapStore::MapStoreReader::~MapStoreReader(void)
+	{close();}
+
+bool MapStore::MapStoreReader::open(const std::string& fname)
+{
+	close();
+	int fd = ::open(fname.c_str(), O_RDONLY);
+	if (fd < 0)
+		return(false);
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size < static_cast<off_t>(storeHeaderSize)))
+	{
+		::close(fd);
+		return(false);
+	}
+	size_t mapSize = static_cast<size_t>(st.st_size);
+	void* pMap = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (pMap == MAP_FAILED)
+		return(false);
+	pFile = static_cast<const uint8_t*>(pMap);
+	fileSize = mapSize;
+	size_t count = get32(pFile + 12);
+	bool isValid = (std::memcmp(pFile, storeMagic, sizeof(storeMagic)) == 0) && (get32(pFile + 8) == storeVersion)
+		&& (count <= (fileSize - storeHeaderSize) / storeEntrySize);
+	uint32_t lastKey = 0;
+	for (size_t i = 0; isValid && (i < count); i++)
+	{
+		const uint8_t* pEntry = pFile + storeHeaderSize + i * storeEntrySize;
+		uint32_t key = (static_cast<uint32_t>(get16(pEntry)) << 16) | get16(pEntry + 2);
+		size_t payloadOffset = get32(pEntry + 4);
+		size_t payloadSize = get16(pEntry + 8);
+		size_t nameLength = pEntry[10];
+		size_t nameOffset = get32(pEntry + 12);
+		isValid = ((i == 0) || (key > lastKey)) && (payloadSize > 0)
+			&& (payloadOffset <= fileSize) && (payloadSize <= fileSize - payloadOffset)
+			&& (nameOffset <= fileSize) && (nameLength <= fileSize - nameOffset);
+		lastKey = key;
+	}
+	if (!isValid)
+	{
+		close();
+		return(false);
+	}
+	numEntries = count;
+	return(true);
+}
+
+void MapStore::MapStoreReader::close(void)
+{
+	if (pFile != NULL)
+		munmap(const_cast<uint8_t*>(pFile), fileSize);
+	pFile = NULL;
+	fileSize = 0;
+	numEntries = 0;
+}
+
+MapStore::mapView_t MapStore::MapStoreReader::at(size_t i) const
+{
+	const uint8_t* pEntry = pFile + storeHeaderSize + i * storeEntrySize;
+	mapView_t view;
+	view.regionalId = get16(pEntry);
+	view.intersectionId = get16(pEntry + 2);
+	view.payload = pFile + get32(pEntry + 4);
+	view.payloadSize = get16(pEntry + 8);
+	view.nameLength = pEntry[10];
+	view.name = reinterpret_cast<const char*>(pFile + get32(pEntry + 12));
+	return(view);
+}
+
+bool MapStore::MapStoreReader::find(uint16_t regionalId, uint16_t intersectionId, mapView_t& viewOut) const
+{
+	uint32_t key = (static_cast<uint32_t>(regionalId) << 16) | intersectionId;
+	size_t lb = 0;
+	size_t ub = numEntries;
+	while (lb < ub)
+	{
+		size_t mid = lb + (ub - lb) / 2;
+		const uint8_t* pEntry = pFile + storeHeaderSize + mid * storeEntrySize;
+		uint32_t midKey = (static_cast<uint32_t>(get16(pEntry)) << 16) | get16(pEntry + 2);
+		if (midKey == key)
+		{
+			viewOut = at(mid);
+			return(true);
+		}
+		if (midKey < key)
+			lb = mid + 1;
+		else
+			ub = mid;
+	}
+	return(false);
+}
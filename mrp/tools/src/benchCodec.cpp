@@ -0,0 +1,1962 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* benchCodec.cpp
+ * benchCodec measures the throughput of the DSRC message encoder and decoder.
+ * It encodes BSM, SRM, SPaT, SSM and RTCM with hard-coded data elements, a BSM with Part II content (and MAP
+ * from a .payload file when given), then repeatedly decodes each payload and reports the time and the
+ * number of heap allocations per message.
+ * Before timing, it checks that decode_msgFrame_direct agrees with decode_msgFrame on the samples, on
+ * randomly generated BSM, SRM, SPaT, SSM and RTCM, and on bit-flipped copies of those payloads, and that
+ * encode_msgFrame_direct produces the same bytes as encode_msgFrame for the BSM, SPaT and RTCM among them,
+ * that decode_rtcm_view and encode_rtcm_view agree with the asn1c path on RTCM,
+ * that peek_msgFrame reads the same leading fields as the full decoding, that Part II contents and
+ * regional extensions of a BSM are noted and taken out as written, and that a BSM with Part II is decoded
+ * without the asn1c path.
+ * It also checks SpatEncoder against encode_msgFrame over a corridor of ticking SPaTs, and that a message
+ * taken through encode_msgFrame_oer and decode_msgFrame_oer encodes to the same UPER bytes as before,
+ * that decode_msgFrame_oer fails on an SSM with more SignalStatusPackages than SSM_element_t holds,
+ * that CachedDecoder decodes as decode_msgFrame_direct does and finds a payload repeated, and that
+ * StreamDecoder hands out the frames of a length-prefixed stream read in pieces of random size, in order,
+ * and gives up on an unfinished frame at its deadline without losing the frames after it, and that
+ * CaptureReader walks synthetic pcap and pcapng captures (Ethernet and radiotap, WSMP versions 2 and 3
+ * with TPIDs 0 to 2, unsecured, signed and encrypted 1609.2 data, truncated records) to the payload
+ * offsets and counts expected.
+ * Encoding of BSM, SPaT, RTCM, SPaT ticks with SpatEncoder, a corridor as one SPaT or SRM against one per
+ * intersection, and MAP is timed as well, and so is BatchDecoder, in the calling thread and with
+ * worker threads, over the encoded payloads of the conformance check. OER encoding and decoding of
+ * each sample but the BSM with Part II (which Frame_element_t does not carry) is timed against UPER,
+ * with the size of both encodings, and so is CachedDecoder on a
+ * repeated sample against decode_msgFrame_direct, and StreamDecoder over a stream of the samples.
+ *
+ * Usage: benchCodec [-n <iterations>] [-f <payload file> ...] [-r <random messages per type>] [-t <worker threads>]
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "AsnJ2735Lib.h"
+#include "captureReader.h"
+#include "dsrcConsts.h"
+#include "payloadCache.h"
+#include "streamDecoder.h"
+#include "uperBits.h"
+
+/// operator new is counted, for the heap allocations of the decoders that do not build the asn1c tree
+static std::atomic<size_t> numHeapAllocs(0);
+
+void* operator new(size_t size)
+{
+	numHeapAllocs++;
+	void* p = std::malloc((size == 0) ? 1 : size);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return(p);
+}
+
+void operator delete(void* p) noexcept
+	{std::free(p);}
+
+void operator delete(void* p, size_t) noexcept
+	{std::free(p);}
+
+struct sample_t
+{
+	std::string name;
+	std::vector<uint8_t> payload;
+};
+
+void do_usage(const char* progname)
+{
+	std::cerr << "Usage" << progname << std::endl;
+	std::cerr << "\t-n number of iterations per message, default 100000" << std::endl;
+	std::cerr << "\t-f full path to MAP payload file, can be repeated" << std::endl;
+	std::cerr << "\t-r number of random messages per type for the conformance check, default 1000" << std::endl;
+	std::cerr << "\t-t number of worker threads for batch decoding, default 2" << std::endl;
+	std::cerr << "\t-? print this message" << std::endl;
+	exit(EXIT_FAILURE);
+}
+
+/// fill dsrcFrameIn with the hard-coded data elements used by testDecoder
+void setSampleFrame(Frame_element_t& dsrcFrameIn, uint16_t dsrcMsgId)
+{
+	const uint16_t regionalId = 0;
+	const uint16_t intersectionId = 1003;
+	const uint32_t vehId = 601;
+	const uint8_t  priorityLevel = 5;
+	const uint8_t  inLaneId = 8;
+	const uint8_t  outLaneId = 30;
+	const double   heading = 60.0;
+	const double   speed = 35.0;
+	const double   latitude = 37.4230638;
+	const double   longitude = -122.1420467;
+	const double   elevation = 12.6;
+	const uint16_t msOfMinute = 50001;
+	const uint32_t minuteOfYear = 120001;
+
+	dsrcFrameIn.reset();
+	dsrcFrameIn.dsrcMsgId = dsrcMsgId;
+	switch(dsrcMsgId)
+	{
+	case MsgEnum::DSRCmsgID_bsm:
+		{
+			BSM_element_t& bsmIn = dsrcFrameIn.bsm;
+			bsmIn.msgCnt = 1;
+			bsmIn.id = vehId;
+			bsmIn.timeStampSec = msOfMinute;
+			bsmIn.latitude  = DsrcConstants::unit2damega<int32_t>(latitude);
+			bsmIn.longitude = DsrcConstants::unit2damega<int32_t>(longitude);
+			bsmIn.elevation = DsrcConstants::unit2deca<int32_t>(elevation);
+			bsmIn.yawRate   = 0;
+			bsmIn.vehLen    = 1200;
+			bsmIn.vehWidth  = 300;
+			bsmIn.speed     = DsrcConstants::kph2unit<uint16_t>(speed);
+			bsmIn.heading   = DsrcConstants::heading2unit<uint16_t>(heading);
+		}
+		break;
+	case MsgEnum::DSRCmsgID_srm:
+		{
+			SRM_element_t& srmIn = dsrcFrameIn.srm;
+			srmIn.timeStampMinute = minuteOfYear;
+			srmIn.timeStampSec = msOfMinute;
+			srmIn.msgCnt = 2;
+			srmIn.regionalId = regionalId;
+			srmIn.intId = intersectionId;
+			srmIn.reqId = priorityLevel;
+			srmIn.inLaneId = inLaneId;
+			srmIn.outLaneId = outLaneId;
+			srmIn.ETAminute = minuteOfYear;
+			srmIn.ETAsec    = 20001;
+			srmIn.duration  = 2000;
+			srmIn.vehId     = vehId;
+			srmIn.latitude  = DsrcConstants::unit2damega<int32_t>(latitude);
+			srmIn.longitude = DsrcConstants::unit2damega<int32_t>(longitude);
+			srmIn.elevation = DsrcConstants::unit2deca<int32_t>(elevation);
+			srmIn.heading   = DsrcConstants::heading2unit<uint16_t>(heading);
+			srmIn.speed     = DsrcConstants::kph2unit<uint16_t>(speed);
+			srmIn.reqType   = MsgEnum::requestType::priorityRequest;
+			srmIn.vehRole   = MsgEnum::basicRole::transit;
+			srmIn.vehType   = MsgEnum::vehicleType::bus;
+		}
+		break;
+	case MsgEnum::DSRCmsgID_spat:
+		{
+			SPAT_element_t& spatIn = dsrcFrameIn.spat;
+			spatIn.regionalId = regionalId;
+			spatIn.id = intersectionId;
+			spatIn.msgCnt = 3;
+			spatIn.timeStampMinute = minuteOfYear;
+			spatIn.timeStampSec = msOfMinute;
+			spatIn.permittedPhases.set();
+			for (size_t i = 1; i < 8; i += 2)
+				spatIn.permittedPedPhases.set(i);
+			uint16_t baseTime = 50;
+			for (size_t i = 0; i < 8; i++)
+			{
+				for (auto phaseState : {&spatIn.phaseState[i], &spatIn.pedPhaseState[i]})
+				{
+					phaseState->currState = MsgEnum::phaseState::redLight;
+					phaseState->startTime = baseTime;
+					phaseState->minEndTime = static_cast<uint16_t>(baseTime + 50);
+					phaseState->maxEndTime = static_cast<uint16_t>(baseTime + 100);
+					baseTime = static_cast<uint16_t>(baseTime + 100);
+				}
+			}
+			spatIn.phaseState[1].currState = MsgEnum::phaseState::protectedGreen;
+			spatIn.phaseState[5].currState = MsgEnum::phaseState::protectedGreen;
+		}
+		break;
+	case MsgEnum::DSRCmsgID_ssm:
+		{
+			SSM_element_t& ssmIn = dsrcFrameIn.ssm;
+			ssmIn.timeStampMinute = minuteOfYear;
+			ssmIn.timeStampSec = msOfMinute;
+			ssmIn.msgCnt = 4;
+			ssmIn.updateCnt = 1;
+			ssmIn.regionalId = regionalId;
+			ssmIn.id = intersectionId;
+			SignalRequetStatus_t requestStatus;
+			requestStatus.reset();
+			requestStatus.vehId = vehId;
+			requestStatus.reqId = priorityLevel;
+			requestStatus.sequenceNumber = 2;
+			requestStatus.vehRole   = MsgEnum::basicRole::transit;
+			requestStatus.inLaneId  = inLaneId;
+			requestStatus.outLaneId = outLaneId;
+			requestStatus.ETAminute = minuteOfYear;
+			requestStatus.ETAsec    = 20001;
+			requestStatus.duration  = 2000;
+			requestStatus.status    = MsgEnum::requestStatus::granted;
+			ssmIn.mpSignalRequetStatus.push_back(requestStatus);
+		}
+		break;
+	case MsgEnum::DSRCmsgID_rtcm:
+		{ // an RTCM v3 frame of 400 octets, preamble and length followed by filler
+			RTCM_element_t& rtcmIn = dsrcFrameIn.rtcm;
+			rtcmIn.msgCnt = 5;
+			rtcmIn.rev = 2;
+			rtcmIn.timeStampMinute = minuteOfYear;
+			rtcmIn.payload.resize(400);
+			for (size_t i = 0; i < rtcmIn.payload.size(); i++)
+				rtcmIn.payload[i] = static_cast<uint8_t>(i * 7 + 1);
+			rtcmIn.payload[0] = 0xD3;
+			rtcmIn.payload[1] = 0x01;
+			rtcmIn.payload[2] = 0x8A;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/// fill dsrcFrameIn with random data elements, not all of them are encodable
+void setRandomFrame(Frame_element_t& dsrcFrameIn, uint16_t dsrcMsgId, std::mt19937& gen)
+{
+	auto rnd = [&gen](int64_t lb, int64_t ub)->int64_t
+		{return(std::uniform_int_distribution<int64_t>(lb, ub)(gen));};
+	auto rndTimeDetail = [&rnd](void)->uint16_t
+		{return(static_cast<uint16_t>((rnd(0, 3) == 0) ? MsgEnum::unknown_timeDetail : rnd(0, 36000)));};
+	auto rndMinute = [&rnd](void)->uint32_t
+		{return(static_cast<uint32_t>((rnd(0, 3) == 0) ? MsgEnum::invalid_timeStampMinute : rnd(0, 527039)));};
+	auto rndOptional16 = [&rnd](void)->uint16_t
+		{return(static_cast<uint16_t>((rnd(0, 3) == 0) ? 0xFFFF : rnd(0, 0xFFFE)));};
+
+	dsrcFrameIn.reset();
+	dsrcFrameIn.dsrcMsgId = dsrcMsgId;
+	switch(dsrcMsgId)
+	{
+	case MsgEnum::DSRCmsgID_bsm:
+		{
+			BSM_element_t& bsmIn = dsrcFrameIn.bsm;
+			bsmIn.msgCnt = static_cast<uint8_t>(rnd(0, 127));
+			bsmIn.id = static_cast<uint32_t>(rnd(0, 0xFFFFFFFF));
+			bsmIn.timeStampSec = static_cast<uint16_t>(rnd(0, 0xFFFF));
+			bsmIn.latitude = static_cast<int32_t>(rnd(-900000000, 900000001));
+			bsmIn.longitude = static_cast<int32_t>(rnd(-1799999999, 1800000001));
+			bsmIn.elevation = static_cast<int32_t>(rnd(-4096, 61439));
+			bsmIn.semiMajor = static_cast<uint8_t>(rnd(0, 0xFF));
+			bsmIn.semiMinor = static_cast<uint8_t>(rnd(0, 0xFF));
+			bsmIn.orientation = static_cast<uint16_t>(rnd(0, 0xFFFF));
+			bsmIn.vehLen = static_cast<uint16_t>(rnd(0, 4095));
+			bsmIn.vehWidth = static_cast<uint16_t>(rnd(0, 1023));
+			bsmIn.speed = static_cast<uint16_t>(rnd(0, 8191));
+			bsmIn.heading = static_cast<uint16_t>(rnd(0, 28800));
+			bsmIn.accelLon = static_cast<int16_t>(rnd(-2000, 2001));
+			bsmIn.accelLat = static_cast<int16_t>(rnd(-2000, 2001));
+			bsmIn.accelVert = static_cast<int8_t>(rnd(-127, 127));
+			bsmIn.steeringAngle = static_cast<int8_t>(rnd(-126, 127));
+			bsmIn.yawRate = static_cast<int16_t>(rnd(-32767, 32767));
+			bsmIn.brakeAppliedStatus = std::bitset<5>(static_cast<unsigned long>(rnd(0, 31)));
+			bsmIn.transState = static_cast<MsgEnum::transGear>(rnd(0, 7));
+			bsmIn.tractionControlStatus = static_cast<MsgEnum::engageStatus>(rnd(0, 3));
+			bsmIn.absStatus = static_cast<MsgEnum::engageStatus>(rnd(0, 3));
+			bsmIn.stabilityControlStatus = static_cast<MsgEnum::engageStatus>(rnd(0, 3));
+			bsmIn.brakeBoostApplied = static_cast<MsgEnum::engageStatus>(rnd(0, 2));
+			bsmIn.auxiliaryBrakeStatus = static_cast<MsgEnum::engageStatus>(rnd(0, 3));
+		}
+		break;
+	case MsgEnum::DSRCmsgID_srm:
+		{
+			SRM_element_t& srmIn = dsrcFrameIn.srm;
+			srmIn.timeStampMinute = rndMinute();
+			srmIn.timeStampSec = static_cast<uint16_t>(rnd(0, 0xFFFF));
+			srmIn.msgCnt = static_cast<uint8_t>((rnd(0, 3) == 0) ? 0xFF : rnd(0, 127));
+			srmIn.moreRequests.resize(static_cast<size_t>((rnd(0, 3) == 0) ? rnd(1, 7) : 0));
+			for (size_t i = 0; i < srmIn.numRequests(); i++)
+			{
+				SignalRequest_element_t& requestIn = srmIn.request(i);
+				requestIn.regionalId = static_cast<uint16_t>(rnd(0, 0xFFFF));
+				requestIn.intId = static_cast<uint16_t>(rnd(0, 0xFFFF));
+				requestIn.reqId = static_cast<uint8_t>(rnd(0, 0xFF));
+				requestIn.inApprochId = static_cast<uint8_t>(rnd(0, 15));
+				requestIn.inLaneId = static_cast<uint8_t>((rnd(0, 1) == 0) ? 0 : rnd(1, 0xFF));
+				requestIn.outApproachId = static_cast<uint8_t>(rnd(0, 15));
+				requestIn.outLaneId = static_cast<uint8_t>((rnd(0, 1) == 0) ? 0 : rnd(1, 0xFF));
+				requestIn.ETAminute = rndMinute();
+				requestIn.ETAsec = rndOptional16();
+				requestIn.duration = rndOptional16();
+				requestIn.reqType = static_cast<MsgEnum::requestType>(rnd(0, 3));
+			}
+			srmIn.vehId = static_cast<uint32_t>(rnd(0, 0xFFFFFFFF));
+			srmIn.latitude = static_cast<int32_t>(rnd(-900000000, 900000001));
+			srmIn.longitude = static_cast<int32_t>(rnd(-1799999999, 1800000001));
+			srmIn.elevation = static_cast<int32_t>(rnd(-4096, 61439));
+			srmIn.heading = static_cast<uint16_t>(rnd(0, 28800));
+			srmIn.speed = static_cast<uint16_t>(rnd(0, 8191));
+			srmIn.vehRole = static_cast<MsgEnum::basicRole>(rnd(0, 22));
+			srmIn.vehType = static_cast<MsgEnum::vehicleType>(rnd(0, 15));
+			srmIn.transState = static_cast<MsgEnum::transGear>(rnd(0, 7));
+		}
+		break;
+	case MsgEnum::DSRCmsgID_spat:
+		{
+			SPAT_element_t& spatIn = dsrcFrameIn.spat;
+			size_t numIntersections = static_cast<size_t>((rnd(0, 3) == 0) ? rnd(2, 8) : 1);
+			spatIn.moreIntersections.resize(numIntersections - 1);
+			for (size_t k = 0; k < numIntersections; k++)
+			{
+				IntersectionState_element_t& stateIn = spatIn.intersection(k);
+				stateIn.regionalId = static_cast<uint16_t>(rnd(0, 0xFFFF));
+				stateIn.id = static_cast<uint16_t>(rnd(0, 0xFFFF));
+				stateIn.msgCnt = static_cast<uint8_t>(rnd(0, 127));
+				stateIn.timeStampMinute = rndMinute();
+				stateIn.timeStampSec = static_cast<uint16_t>((rnd(0, 3) == 0) ? 0xFFFF : rnd(0, 0xFFFE));
+				stateIn.status = std::bitset<16>(static_cast<unsigned long>(rnd(0, 0xFFFF)));
+				stateIn.permittedPhases = std::bitset<8>(static_cast<unsigned long>(rnd(0, 0xFF)));
+				stateIn.permittedPedPhases = std::bitset<8>(static_cast<unsigned long>(rnd(0, 0xFF)));
+				bool hasTimeline = (rnd(0, 3) == 0);
+				int maxNextEvents = (numIntersections == 1) ? 7 : 3;
+				for (size_t i = 0; i < 8; i++)
+				{
+					for (auto phaseState : {&stateIn.phaseState[i], &stateIn.pedPhaseState[i]})
+					{
+						stateIn.setNumNextEvents(*phaseState, static_cast<size_t>(hasTimeline ? rnd(0, maxNextEvents) : 0));
+						for (size_t j = 0; j < stateIn.numEvents(*phaseState); j++)
+						{
+							MovementEvent_element_t& eventIn = stateIn.event(*phaseState, j);
+							eventIn.currState = static_cast<MsgEnum::phaseState>(rnd(0, 9));
+							eventIn.startTime = rndTimeDetail();
+							eventIn.minEndTime = rndTimeDetail();
+							eventIn.maxEndTime = rndTimeDetail();
+						}
+					}
+				}
+			}
+		}
+		break;
+	case MsgEnum::DSRCmsgID_ssm:
+		{
+			SSM_element_t& ssmIn = dsrcFrameIn.ssm;
+			ssmIn.timeStampMinute = rndMinute();
+			ssmIn.timeStampSec = static_cast<uint16_t>(rnd(0, 0xFFFF));
+			ssmIn.msgCnt = static_cast<uint8_t>((rnd(0, 3) == 0) ? 0xFF : rnd(0, 127));
+			ssmIn.updateCnt = static_cast<uint8_t>(rnd(0, 127));
+			ssmIn.regionalId = static_cast<uint16_t>(rnd(0, 0xFFFF));
+			ssmIn.id = static_cast<uint16_t>(rnd(0, 0xFFFF));
+			ssmIn.mpSignalRequetStatus.resize(static_cast<size_t>(rnd(1, 32)));
+			for (auto& requestStatus : ssmIn.mpSignalRequetStatus)
+			{
+				requestStatus.reset();
+				requestStatus.vehId = static_cast<uint32_t>(rnd(0, 0xFFFFFFFF));
+				requestStatus.reqId = static_cast<uint8_t>(rnd(0, 0xFF));
+				requestStatus.sequenceNumber = static_cast<uint8_t>(rnd(0, 127));
+				requestStatus.vehRole = static_cast<MsgEnum::basicRole>(rnd(0, 22));
+				requestStatus.inApprochId = static_cast<uint8_t>(rnd(0, 15));
+				requestStatus.inLaneId = static_cast<uint8_t>((rnd(0, 1) == 0) ? 0 : rnd(1, 0xFF));
+				requestStatus.outApproachId = static_cast<uint8_t>(rnd(0, 15));
+				requestStatus.outLaneId = static_cast<uint8_t>((rnd(0, 1) == 0) ? 0 : rnd(1, 0xFF));
+				requestStatus.ETAminute = rndMinute();
+				requestStatus.ETAsec = rndOptional16();
+				requestStatus.duration = rndOptional16();
+				requestStatus.status = static_cast<MsgEnum::requestStatus>(rnd(0, 7));
+			}
+		}
+		break;
+	case MsgEnum::DSRCmsgID_rtcm:
+		{
+			RTCM_element_t& rtcmIn = dsrcFrameIn.rtcm;
+			rtcmIn.msgCnt = static_cast<uint8_t>(rnd(0, 127));
+			rtcmIn.rev = static_cast<uint8_t>(rnd(0, 4));
+			rtcmIn.timeStampMinute = rndMinute();
+			rtcmIn.payload.resize(static_cast<size_t>(rnd(1, 1100)));
+			for (auto& octet : rtcmIn.payload)
+				octet = static_cast<uint8_t>(rnd(0, 0xFF));
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/// decode the payload with decode_msgFrame and decode_msgFrame_direct,
+/// both shall fail or both shall succeed with the same consumed size and re-encode into identical bytes
+bool isDirectConformed(const std::vector<uint8_t>& payload)
+{
+	Frame_element_t frameAsn1c, frameDirect;
+	size_t sizeAsn1c = AsnJ2735Lib::decode_msgFrame(&payload[0], payload.size(), frameAsn1c);
+	size_t sizeDirect = AsnJ2735Lib::decode_msgFrame_direct(&payload[0], payload.size(), frameDirect);
+	if (sizeAsn1c != sizeDirect)
+		return(false);
+	if (sizeAsn1c == 0)
+		return(true);
+	if (frameAsn1c.dsrcMsgId != frameDirect.dsrcMsgId)
+		return(false);
+	std::vector<uint8_t> bufAsn1c(DsrcConstants::maxMsgSize, 0);
+	std::vector<uint8_t> bufDirect(DsrcConstants::maxMsgSize, 0);
+	size_t encodeAsn1c = AsnJ2735Lib::encode_msgFrame(frameAsn1c, &bufAsn1c[0], bufAsn1c.size());
+	size_t encodeDirect = AsnJ2735Lib::encode_msgFrame(frameDirect, &bufDirect[0], bufDirect.size());
+	if ((encodeAsn1c != encodeDirect) || !std::equal(bufAsn1c.begin(), bufAsn1c.begin() + encodeAsn1c, bufDirect.begin()))
+		return(false);
+	/// decode_msgFrame_lazy accepts more (open types are not checked), but agrees on what both accept
+	AsnJ2735Lib::bsmExtensions_t bsmExt;
+	if (AsnJ2735Lib::decode_msgFrame_lazy(&payload[0], payload.size(), frameDirect, bsmExt) != sizeAsn1c)
+		return(false);
+	encodeDirect = AsnJ2735Lib::encode_msgFrame(frameDirect, &bufDirect[0], bufDirect.size());
+	return((encodeAsn1c == encodeDirect) && std::equal(bufAsn1c.begin(), bufAsn1c.begin() + encodeAsn1c, bufDirect.begin()));
+}
+
+/// peek_msgFrame shall read the same leading fields as decode_msgFrame_direct, for payloads that decode
+bool isPeekConformed(const std::vector<uint8_t>& payload)
+{
+	Frame_element_t dsrcFrame;
+	AsnJ2735Lib::msgHeader_t header;
+	bool peeked = AsnJ2735Lib::peek_msgFrame(&payload[0], payload.size(), header);
+	if (AsnJ2735Lib::decode_msgFrame_direct(&payload[0], payload.size(), dsrcFrame) == 0)
+		return(true);
+	if (!peeked || (header.dsrcMsgId != dsrcFrame.dsrcMsgId))
+		return(false);
+	switch(dsrcFrame.dsrcMsgId)
+	{
+	case MsgEnum::DSRCmsgID_map:
+		return((header.regionalId == dsrcFrame.mapData.regionalId) && (header.intersectionId == dsrcFrame.mapData.id)
+			&& (header.revision == dsrcFrame.mapData.mapVersion));
+	case MsgEnum::DSRCmsgID_spat:
+		return((header.regionalId == dsrcFrame.spat.regionalId) && (header.intersectionId == dsrcFrame.spat.id)
+			&& (header.revision == dsrcFrame.spat.msgCnt));
+	case MsgEnum::DSRCmsgID_bsm:
+		return(header.vehId == dsrcFrame.bsm.id);
+	case MsgEnum::DSRCmsgID_srm:
+		return((header.regionalId == dsrcFrame.srm.regionalId) && (header.intersectionId == dsrcFrame.srm.intId));
+	case MsgEnum::DSRCmsgID_ssm:
+		return((header.regionalId == dsrcFrame.ssm.regionalId) && (header.intersectionId == dsrcFrame.ssm.id));
+	default:
+		return(true);
+	}
+}
+
+/// decode_rtcm_view shall agree with decode_msgFrame on RTCM, except that it leaves an anchorPoint to
+/// decode_msgFrame, and encode_rtcm_view of the view shall produce the same bytes as encode_msgFrame
+bool isRtcmViewConformed(const std::vector<uint8_t>& payload)
+{
+	Frame_element_t frameAsn1c;
+	RTCMview_t rtcmView;
+	size_t sizeAsn1c = AsnJ2735Lib::decode_msgFrame(&payload[0], payload.size(), frameAsn1c);
+	size_t sizeView = AsnJ2735Lib::decode_rtcm_view(&payload[0], payload.size(), rtcmView);
+	bool isRtcm = (sizeAsn1c > 0) && (frameAsn1c.dsrcMsgId == MsgEnum::DSRCmsgID_rtcm);
+	if (sizeView == 0)
+	{
+		if (!isRtcm)
+			return(true);
+		/// anchorPoint presence is the third bit of the RTCMcorrections value
+		UperBits::Reader rd(&payload[0], payload.size());
+		rd.get(16);
+		rd.enterOpenType();
+		rd.get(2);
+		return(rd.getBit());
+	}
+	const RTCM_element_t& rtcmAsn1c = frameAsn1c.rtcm;
+	if (!isRtcm || (sizeView != sizeAsn1c) || (rtcmView.msgCnt != rtcmAsn1c.msgCnt) || (rtcmView.rev != rtcmAsn1c.rev)
+		|| (rtcmView.timeStampMinute != rtcmAsn1c.timeStampMinute))
+		return(false);
+	std::vector<uint8_t> viewPayload(rtcmView.payloadSize);
+	if ((AsnJ2735Lib::get_rtcmPayload(rtcmView, &viewPayload[0], viewPayload.size()) != rtcmAsn1c.payload.size())
+		|| (viewPayload != rtcmAsn1c.payload))
+		return(false);
+	if ((rtcmView.data() != NULL) && !std::equal(rtcmAsn1c.payload.begin(), rtcmAsn1c.payload.end(), rtcmView.data()))
+		return(false);
+	/// re-encoding the view takes the octets from payload, byte-aligned there or not
+	std::vector<uint8_t> bufAsn1c(DsrcConstants::maxMsgSize, 0);
+	std::vector<uint8_t> bufView(DsrcConstants::maxMsgSize, 0xFF);
+	size_t encodeAsn1c = AsnJ2735Lib::encode_msgFrame(frameAsn1c, &bufAsn1c[0], bufAsn1c.size());
+	size_t encodeView = AsnJ2735Lib::encode_rtcm_view(rtcmView, &bufView[0], bufView.size());
+	return((encodeAsn1c == encodeView) && std::equal(bufAsn1c.begin(), bufAsn1c.begin() + encodeAsn1c, bufView.begin()));
+}
+
+/// encode dsrcFrameIn with encode_msgFrame and encode_msgFrame_direct, both shall produce the same bytes
+bool isDirectEncodeConformed(const Frame_element_t& dsrcFrameIn)
+{
+	std::vector<uint8_t> bufAsn1c(DsrcConstants::maxMsgSize, 0);
+	std::vector<uint8_t> bufDirect(DsrcConstants::maxMsgSize, 0xFF);
+	size_t encodeAsn1c = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &bufAsn1c[0], bufAsn1c.size());
+	size_t encodeDirect = AsnJ2735Lib::encode_msgFrame_direct(dsrcFrameIn, &bufDirect[0], bufDirect.size());
+	return((encodeAsn1c == encodeDirect) && std::equal(bufAsn1c.begin(), bufAsn1c.begin() + encodeAsn1c, bufDirect.begin()));
+}
+
+/// the message decoded from payload, taken through encode_msgFrame_oer and decode_msgFrame_oer,
+/// shall encode to the same UPER bytes as the message itself
+bool isOerConformed(const std::vector<uint8_t>& payload, size_t& uperBytes, size_t& oerBytes)
+{
+	Frame_element_t frameUper;
+	Frame_element_t frameOer;
+	std::vector<uint8_t> bufUper(DsrcConstants::maxMsgSize, 0);
+	std::vector<uint8_t> bufOer(DsrcConstants::maxMsgSize, 0);
+	std::vector<uint8_t> bufRoundTrip(DsrcConstants::maxMsgSize, 0xFF);
+	if (AsnJ2735Lib::decode_msgFrame(&payload[0], payload.size(), frameUper) == 0)
+		return(true);
+	size_t encodeUper = AsnJ2735Lib::encode_msgFrame(frameUper, &bufUper[0], bufUper.size());
+	if (encodeUper == 0)
+		return(true);
+	size_t encodeOer = AsnJ2735Lib::encode_msgFrame_oer(frameUper, &bufOer[0], bufOer.size());
+	if ((encodeOer == 0) || (AsnJ2735Lib::decode_msgFrame_oer(&bufOer[0], encodeOer, frameOer) != encodeOer))
+		return(false);
+	uperBytes += encodeUper;
+	oerBytes += encodeOer;
+	size_t encodeRoundTrip = AsnJ2735Lib::encode_msgFrame(frameOer, &bufRoundTrip[0], bufRoundTrip.size());
+	return((encodeRoundTrip == encodeUper) && std::equal(bufUper.begin(), bufUper.begin() + encodeUper, bufRoundTrip.begin()));
+}
+
+/// decode_msgFrame_oer shall decode an SSM with maxSignalStatusPackages SignalStatusPackages, and fail on one
+/// with more, which the OER decoder of asn1c lets through. The OER bytes of an SSM with numPackages packages
+/// are spliced from the encodings of the sample SSM with one package and with two
+bool isOerOversizeRejected(void)
+{
+	Frame_element_t dsrcFrameIn;
+	setSampleFrame(dsrcFrameIn, MsgEnum::DSRCmsgID_ssm);
+	std::vector<uint8_t> buf1(DsrcConstants::maxMsgSize, 0);
+	std::vector<uint8_t> buf2(DsrcConstants::maxMsgSize, 0);
+	size_t size1 = AsnJ2735Lib::encode_msgFrame_oer(dsrcFrameIn, &buf1[0], buf1.size());
+	dsrcFrameIn.ssm.mpSignalRequetStatus.push_back(dsrcFrameIn.ssm.mpSignalRequetStatus[0]);
+	size_t size2 = AsnJ2735Lib::encode_msgFrame_oer(dsrcFrameIn, &buf2[0], buf2.size());
+	/// MessageFrame preamble and messageId, then the length of the SSM open type, 1 byte for both
+	const size_t ssmStart = 4;
+	if ((size1 <= ssmStart) || (size2 <= size1) || (buf1[ssmStart - 1] >= 0x80) || (buf2[ssmStart - 1] >= 0x80))
+		return(false);
+	size_t countPos = ssmStart;
+	while ((countPos < size1) && (buf1[countPos] == buf2[countPos]))
+		countPos++;
+	size_t packageSize = size2 - size1;
+	if ((countPos >= size1) || (buf1[countPos] != 1) || (buf2[countPos] != 2) || (countPos + 1 + packageSize > size1))
+		return(false);
+	auto getOversized = [&buf1, size1, countPos, packageSize](size_t numPackages)->std::vector<uint8_t>
+	{
+		std::vector<uint8_t> ssm(buf1.begin() + ssmStart, buf1.begin() + countPos);
+		ssm.push_back(static_cast<uint8_t>(numPackages));
+		for (size_t i = 0; i < numPackages; i++)
+			ssm.insert(ssm.end(), buf1.begin() + countPos + 1, buf1.begin() + countPos + 1 + packageSize);
+		ssm.insert(ssm.end(), buf1.begin() + countPos + 1 + packageSize, buf1.begin() + size1);
+		std::vector<uint8_t> msg(buf1.begin(), buf1.begin() + ssmStart - 1);
+		if (ssm.size() < 0x80)
+			msg.push_back(static_cast<uint8_t>(ssm.size()));
+		else
+			msg.insert(msg.end(), {0x82, static_cast<uint8_t>(ssm.size() >> 8), static_cast<uint8_t>(ssm.size() & 0xFF)});
+		msg.insert(msg.end(), ssm.begin(), ssm.end());
+		return(msg);
+	};
+	Frame_element_t dsrcFrameOut;
+	std::vector<uint8_t> msg = getOversized(MsgEnum::maxSignalStatusPackages);
+	if ((AsnJ2735Lib::decode_msgFrame_oer(&msg[0], msg.size(), dsrcFrameOut) != msg.size())
+			|| (dsrcFrameOut.ssm.mpSignalRequetStatus.size() != MsgEnum::maxSignalStatusPackages))
+		return(false);
+	for (size_t numPackages : {MsgEnum::maxSignalStatusPackages + 1, static_cast<size_t>(200)})
+	{
+		msg = getOversized(numPackages);
+		uint64_t numInvalid = AsnJ2735Lib::get_codecErrorStats().counts[static_cast<size_t>(AsnJ2735Lib::codecError::invalidValue)];
+		if ((AsnJ2735Lib::decode_msgFrame_oer(&msg[0], msg.size(), dsrcFrameOut) != 0)
+				|| (AsnJ2735Lib::get_codecErrorStats().counts[static_cast<size_t>(AsnJ2735Lib::codecError::invalidValue)] != numInvalid + 1))
+			return(false);
+	}
+	return(true);
+}
+
+/// CachedDecoder shall decode the payload as decode_msgFrame_direct does, and find it when it comes again
+bool isCachedConformed(const std::vector<uint8_t>& payload, AsnJ2735Lib::CachedDecoder& cachedDecoder)
+{
+	Frame_element_t dsrcFrame;
+	const Frame_element_t* pFrame;
+	const Frame_element_t* pRepeat;
+	bool isRepeat;
+	size_t sizeDirect = AsnJ2735Lib::decode_msgFrame_direct(&payload[0], payload.size(), dsrcFrame);
+	size_t sizeCached = cachedDecoder.decode(&payload[0], payload.size(), pFrame, isRepeat);
+	if (sizeCached != sizeDirect)
+		return(false);
+	if (sizeDirect == 0)
+		return(pFrame == NULL);
+	if (pFrame->dsrcMsgId != dsrcFrame.dsrcMsgId)
+		return(false);
+	return((cachedDecoder.decode(&payload[0], payload.size(), pRepeat, isRepeat) == sizeDirect) && isRepeat && (pRepeat == pFrame));
+}
+
+/// append a frame of a length-prefixed stream, the length in network byte order
+void appendFrame(std::vector<uint8_t>& stream, const uint8_t* payload, size_t size)
+{
+	stream.push_back(static_cast<uint8_t>(size >> 8));
+	stream.push_back(static_cast<uint8_t>(size & 0xFF));
+	stream.insert(stream.end(), payload, payload + size);
+}
+
+/// StreamDecoder shall hand out the frames of a length-prefixed stream, read into a ring a little longer
+/// than the largest payload in pieces of random size, in order and as decode_msgFrame_direct decodes each
+/// payload; an empty frame as empty, and a frame longer than the ring as failed
+size_t countStreamMismatches(const std::vector< std::vector<uint8_t> >& payloads, std::mt19937& gen,
+	AsnJ2735Lib::streamStats_t& statsOut)
+{
+	std::vector<uint8_t> stream;
+	std::vector<AsnJ2735Lib::decodeStatus> expected;
+	for (const auto& payload : payloads)
+	{
+		appendFrame(stream, &payload[0], payload.size());
+		expected.push_back(AsnJ2735Lib::decodeStatus::decoded);
+		if (expected.size() == payloads.size() / 2)
+		{
+			std::vector<uint8_t> oversized(DsrcConstants::maxMsgSize + 1, 0);
+			appendFrame(stream, &oversized[0], 0);
+			expected.push_back(AsnJ2735Lib::decodeStatus::empty);
+			appendFrame(stream, &oversized[0], oversized.size());
+			expected.push_back(AsnJ2735Lib::decodeStatus::failed);
+		}
+	}
+	std::vector<uint8_t> ring(DsrcConstants::maxMsgSize + 2, 0);
+	AsnJ2735Lib::StreamDecoder streamDecoder(&ring[0], ring.size());
+	AsnJ2735Lib::decodeResult_t result;
+	Frame_element_t dsrcFrame;
+	std::uniform_int_distribution<size_t> readSize(1, 700);
+	size_t numMismatches = 0;
+	size_t numFrames = 0;
+	size_t numPayloads = 0;
+	size_t pos = 0;
+	while (pos < stream.size())
+	{
+		size_t size;
+		uint8_t* writeBuf = streamDecoder.getWriteBuf(size);
+		size = std::min(std::min(size, readSize(gen)), stream.size() - pos);
+		std::copy(stream.begin() + pos, stream.begin() + pos + size, writeBuf);
+		streamDecoder.commit(size);
+		pos += size;
+		while (streamDecoder.next(result))
+		{
+			if (numFrames >= expected.size())
+				return(numMismatches + 1);
+			AsnJ2735Lib::decodeStatus status = expected[numFrames++];
+			if (status != AsnJ2735Lib::decodeStatus::decoded)
+			{
+				if (result.status != status)
+					numMismatches++;
+				continue;
+			}
+			const std::vector<uint8_t>& payload = payloads[numPayloads++];
+			size_t consumed = AsnJ2735Lib::decode_msgFrame_direct(&payload[0], payload.size(), dsrcFrame);
+			if ((result.consumed != consumed) || (result.status != ((consumed > 0) ? status : AsnJ2735Lib::decodeStatus::failed))
+				|| ((consumed > 0) && (result.dsrcFrame.dsrcMsgId != dsrcFrame.dsrcMsgId)))
+				numMismatches++;
+		}
+	}
+	statsOut = streamDecoder.getStats();
+	return(numMismatches + expected.size() - numFrames + streamDecoder.getNumPending());
+}
+
+/// StreamDecoder with a deadline shall hand out a frame left unfinished, after its first byte or after
+/// half of it, as failed once the deadline has passed, and drop the rest of it to decode the next frame
+bool isStreamFlushed(const std::vector<uint8_t>& payload)
+{
+	std::vector<uint8_t> stream;
+	appendFrame(stream, &payload[0], payload.size());
+	appendFrame(stream, &payload[0], payload.size());
+	std::vector<uint8_t> ring(DsrcConstants::maxMsgSize + 2, 0);
+	AsnJ2735Lib::StreamDecoder streamDecoder(&ring[0], ring.size(), std::chrono::milliseconds(1));
+	AsnJ2735Lib::decodeResult_t result;
+	auto feed = [&streamDecoder](const uint8_t* p, size_t size)->void
+	{
+		size_t writeSize;
+		uint8_t* writeBuf = streamDecoder.getWriteBuf(writeSize);
+		std::copy(p, p + size, writeBuf);
+		streamDecoder.commit(size);
+	};
+	for (size_t split : {static_cast<size_t>(1), 2 + payload.size() / 2})
+	{
+		feed(&stream[0], split);
+		if (streamDecoder.next(result))
+			return(false);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		if (!streamDecoder.next(result) || (result.status != AsnJ2735Lib::decodeStatus::failed))
+			return(false);
+		feed(&stream[split], stream.size() - split);
+		if (!streamDecoder.next(result) || (result.status != AsnJ2735Lib::decodeStatus::decoded)
+			|| (result.consumed != payload.size()) || streamDecoder.next(result))
+			return(false);
+	}
+	return(streamDecoder.getStats().numFlushed == 2);
+}
+
+/// StreamDecoder shall reject a ring shorter than minCapacity, giving no space to read into,
+/// and take one of minCapacity bytes, which holds an empty frame
+bool isShortRingRejected(void)
+{
+	uint8_t ring[AsnJ2735Lib::StreamDecoder::minCapacity] = {0};
+	size_t size;
+	AsnJ2735Lib::StreamDecoder shortDecoder(ring, sizeof(ring) - 1);
+	if (shortDecoder.isValid() || (shortDecoder.getWriteBuf(size) == nullptr) || (size != 0))
+		return(false);
+	AsnJ2735Lib::StreamDecoder streamDecoder(ring, sizeof(ring));
+	uint8_t* writeBuf = streamDecoder.getWriteBuf(size);
+	if (!streamDecoder.isValid() || (size != sizeof(ring)))
+		return(false);
+	writeBuf[0] = 0;
+	writeBuf[1] = 0;
+	streamDecoder.commit(2);
+	AsnJ2735Lib::decodeResult_t result;
+	return(streamDecoder.next(result) && (result.status == AsnJ2735Lib::decodeStatus::empty));
+}
+
+/// synthetic captures for isCaptureConformed, built in memory with the payload offsets they shall give
+struct captureFixture_t
+{
+	std::vector<uint8_t> file;
+	std::vector<size_t> payloadOffsets;
+	AsnJ2735Lib::captureStats_t stats;
+	void put16(uint16_t value)
+		{put(&value, sizeof(value));};
+	void put32(uint32_t value)
+		{put(&value, sizeof(value));};
+	void put(const void* p, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(p);
+		file.insert(file.end(), bytes, bytes + size);
+	};
+};
+
+/// link-layer, WSMP and 1609.2 headers of the records of the synthetic captures. WSMP version 3 comes with
+/// TPID 0 (PSID), 1 (PSID and WSMP-T extension fields) or 2 (source and destination ports)
+enum class wsmKind {wsmpV2, wsmpV3, wsmpV3ext, wsmpV3ports, unsecured, signedData, encrypted};
+
+/// a WAVE Short Message over Ethernet, or an IEEE 802.11 QoS data frame behind a radiotap header,
+/// with the offset of the J2735 payload in the record
+std::vector<uint8_t> getWsmRecord(const std::vector<uint8_t>& payload, wsmKind kind, bool radiotap, size_t& payloadOffset)
+{
+	std::vector<uint8_t> record;
+	if (radiotap)
+	{
+		record = {0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x00};
+		record.resize(record.size() + 24, 0);  /// duration, addresses, sequence control and QoS control
+		record.insert(record.end(), {0xAA, 0xAA, 0x03, 0x00, 0x00, 0x00, 0x88, 0xDC});
+	}
+	else
+	{
+		record.resize(12, 0xFF);
+		record.insert(record.end(), {0x88, 0xDC});
+	}
+	auto appendLength = [](std::vector<uint8_t>& buf, size_t size, bool oer)->void
+	{
+		if (size < 128)
+			buf.push_back(static_cast<uint8_t>(size));
+		else if (oer)
+			buf.insert(buf.end(), {0x82, static_cast<uint8_t>(size >> 8), static_cast<uint8_t>(size & 0xFF)});
+		else
+			buf.insert(buf.end(), {static_cast<uint8_t>(0x80 | (size >> 8)), static_cast<uint8_t>(size & 0xFF)});
+	};
+	std::vector<uint8_t> data;
+	switch(kind)
+	{
+	case wsmKind::unsecured:
+		data = {0x03, 0x80};
+		break;
+	case wsmKind::signedData:
+		data = {0x03, 0x81, 0x00, 0x40, 0x03, 0x80};
+		break;
+	case wsmKind::encrypted:
+		data = {0x03, 0x82, 0x00, 0x01};
+		break;
+	default:
+		break;
+	}
+	if (kind != wsmKind::encrypted)
+	{
+		if ((kind == wsmKind::unsecured) || (kind == wsmKind::signedData))
+			appendLength(data, payload.size(), true);
+		payloadOffset = data.size();
+		data.insert(data.end(), payload.begin(), payload.end());
+	}
+	if (kind == wsmKind::signedData)
+		data.insert(data.end(), 8, 0x5A);  /// signer and signature, not looked at
+	if (kind == wsmKind::wsmpV2)
+	{ /// PSID, a channel number extension field, then the WSM data element with a two-byte length
+		record.insert(record.end(), {0x02, 0x20, 0x0F, 0x01, 0xAC, 0x80,
+			static_cast<uint8_t>(data.size() >> 8), static_cast<uint8_t>(data.size() & 0xFF)});
+	}
+	else
+	{ /// a channel number extension field, the TPID and its fields, then the WSM length
+		record.insert(record.end(), {0x0B, 0x01, 0x0F, 0x01, 0xAC});
+		if (kind == wsmKind::wsmpV3ext)
+			record.insert(record.end(), {0x01, 0x20, 0x01, 0x17, 0x02, 0x00, 0x00});  /// a channel load extension field
+		else if (kind == wsmKind::wsmpV3ports)
+			record.insert(record.end(), {0x02, 0x0F, 0xA0, 0x0F, 0xA1});
+		else
+			record.insert(record.end(), {0x00, 0x20});
+		appendLength(record, data.size(), false);
+	}
+	payloadOffset += record.size();
+	record.insert(record.end(), data.begin(), data.end());
+	return(record);
+}
+
+/// a pcap capture over Ethernet: WSMP version 2, WSMP version 3 with each TPID but 3 and with unsecured,
+/// signed and encrypted 1609.2 data, an IPv4 frame, and a record cut short at the end of the capture
+captureFixture_t getPcapFixture(const std::vector<uint8_t>& payload, const std::vector<uint8_t>& longPayload)
+{
+	captureFixture_t fixture;
+	fixture.stats.reset();
+	fixture.put32(0xA1B2C3D4);
+	fixture.put16(2);
+	fixture.put16(4);
+	fixture.put32(0);
+	fixture.put32(0);
+	fixture.put32(65535);
+	fixture.put32(1);
+	auto putRecord = [&fixture](const std::vector<uint8_t>& record)->void
+	{
+		fixture.put32(1500000000);
+		fixture.put32(0);
+		fixture.put32(static_cast<uint32_t>(record.size()));
+		fixture.put32(static_cast<uint32_t>(record.size()));
+		fixture.put(&record[0], record.size());
+	};
+	const std::vector< std::pair<wsmKind, const std::vector<uint8_t>*> > wsms = {{wsmKind::wsmpV2, &payload},
+		{wsmKind::wsmpV3, &payload}, {wsmKind::wsmpV3ext, &payload}, {wsmKind::wsmpV3ports, &payload},
+		{wsmKind::unsecured, &longPayload}, {wsmKind::signedData, &payload}, {wsmKind::encrypted, &payload}};
+	for (const auto& wsm : wsms)
+	{
+		size_t payloadOffset = 0;
+		std::vector<uint8_t> record = getWsmRecord(*wsm.second, wsm.first, false, payloadOffset);
+		if (wsm.first != wsmKind::encrypted)
+		{
+			fixture.payloadOffsets.push_back(fixture.file.size() + 16 + payloadOffset);
+			fixture.stats.payloadBytes += wsm.second->size();
+		}
+		putRecord(record);
+	}
+	std::vector<uint8_t> ipv4(12, 0xFF);
+	ipv4.insert(ipv4.end(), {0x08, 0x00, 0x45, 0x00, 0x00, 0x14});
+	putRecord(ipv4);
+	fixture.put32(1500000000);
+	fixture.put32(0);
+	fixture.put32(64);
+	fixture.put32(64);
+	fixture.put(&payload[0], std::min(payload.size(), static_cast<size_t>(32)));
+	fixture.stats.numRecords = 9;
+	fixture.stats.numWsm = 7;
+	fixture.stats.numSecured = 2;
+	fixture.stats.numEncrypted = 1;
+	fixture.stats.numOther = 1;
+	fixture.stats.numMalformed = 1;
+	return(fixture);
+}
+
+/// a pcapng capture with a radiotap and an Ethernet interface: a signed WSM behind radiotap, a WSMP
+/// version 2 WSM over Ethernet, an Enhanced Packet Block too short for its header, one shorter than its
+/// captured length, and a block cut short at the end of the capture
+captureFixture_t getPcapngFixture(const std::vector<uint8_t>& payload)
+{
+	captureFixture_t fixture;
+	fixture.stats.reset();
+	fixture.put32(0x0A0D0D0A);
+	fixture.put32(28);
+	fixture.put32(0x1A2B3C4D);
+	fixture.put16(1);
+	fixture.put16(0);
+	fixture.put32(0xFFFFFFFF);
+	fixture.put32(0xFFFFFFFF);
+	fixture.put32(28);
+	for (uint16_t linkType : {static_cast<uint16_t>(127), static_cast<uint16_t>(1)})
+	{
+		fixture.put32(1);
+		fixture.put32(20);
+		fixture.put16(linkType);
+		fixture.put16(0);
+		fixture.put32(65535);
+		fixture.put32(20);
+	}
+	auto putBlock = [&fixture](uint32_t ifId, const std::vector<uint8_t>& record, uint32_t capturedSize)->void
+	{
+		uint32_t blockSize = static_cast<uint32_t>(32 + ((record.size() + 3) & ~static_cast<size_t>(3)));
+		fixture.put32(6);
+		fixture.put32(blockSize);
+		fixture.put32(ifId);
+		fixture.put32(0);
+		fixture.put32(0);
+		fixture.put32(capturedSize);
+		fixture.put32(capturedSize);
+		if (!record.empty())
+			fixture.put(&record[0], record.size());
+		fixture.file.resize(fixture.file.size() + blockSize - 32 - record.size(), 0);
+		fixture.put32(blockSize);
+	};
+	for (uint32_t ifId : {static_cast<uint32_t>(0), static_cast<uint32_t>(1)})
+	{
+		size_t payloadOffset = 0;
+		std::vector<uint8_t> record = getWsmRecord(payload, (ifId == 0) ? wsmKind::signedData : wsmKind::wsmpV2, ifId == 0, payloadOffset);
+		fixture.payloadOffsets.push_back(fixture.file.size() + 28 + payloadOffset);
+		fixture.stats.payloadBytes += payload.size();
+		putBlock(ifId, record, static_cast<uint32_t>(record.size()));
+	}
+	fixture.put32(6);
+	fixture.put32(28);
+	fixture.file.resize(fixture.file.size() + 16, 0);
+	fixture.put32(28);
+	putBlock(1, std::vector<uint8_t>(8, 0), 200);
+	fixture.put32(6);
+	fixture.put32(64);
+	fixture.put(&payload[0], std::min(payload.size(), static_cast<size_t>(16)));
+	fixture.stats.numRecords = 4;
+	fixture.stats.numWsm = 2;
+	fixture.stats.numSecured = 1;
+	fixture.stats.numMalformed = 3;
+	return(fixture);
+}
+
+/// CaptureReader shall hand out the payloads of the synthetic captures, at the offsets they were written
+/// to, and count their records as the captures were built
+bool isCaptureConformed(const captureFixture_t& fixture)
+{
+	char fname[] = "/tmp/benchCodec.XXXXXX";
+	int fd = mkstemp(fname);
+	if (fd < 0)
+		return(false);
+	bool written = (write(fd, &fixture.file[0], fixture.file.size()) == static_cast<ssize_t>(fixture.file.size()));
+	::close(fd);
+	AsnJ2735Lib::CaptureReader captureReader;
+	bool opened = written && captureReader.open(fname);
+	unlink(fname);
+	if (!opened)
+		return(false);
+	AsnJ2735Lib::msgBuf_t msg;
+	size_t numPayloads = 0;
+	while (captureReader.next(msg))
+	{
+		if ((numPayloads >= fixture.payloadOffsets.size())
+				|| (static_cast<size_t>(msg.buf - captureReader.getFileData()) != fixture.payloadOffsets[numPayloads]))
+			return(false);
+		numPayloads++;
+	}
+	const AsnJ2735Lib::captureStats_t& stats = captureReader.getStats();
+	const AsnJ2735Lib::captureStats_t& expected = fixture.stats;
+	return((numPayloads == fixture.payloadOffsets.size()) && (stats.numRecords == expected.numRecords)
+		&& (stats.numWsm == expected.numWsm) && (stats.numSecured == expected.numSecured)
+		&& (stats.numEncrypted == expected.numEncrypted) && (stats.numOther == expected.numOther)
+		&& (stats.numMalformed == expected.numMalformed) && (stats.payloadBytes == expected.payloadBytes));
+}
+
+/// MsgDecoder visitor that encodes the decoded element again with encode<T>
+struct reencodeVisitor_t
+{
+	uint16_t dsrcMsgId;
+	size_t numBytes;
+	std::vector<uint8_t> buf;
+	template<typename T>
+	void operator()(const T& msgIn)
+	{
+		dsrcMsgId = AsnJ2735Lib::msgId<T>::value;
+		numBytes = AsnJ2735Lib::encode(msgIn, &buf[0], buf.size());
+	};
+};
+
+/// MsgDecoder visitor that keeps a copy of the decoded element, as a consumer that queues them would do
+struct copyVisitor_t
+{
+	size_t numKept;
+	template<typename T>
+	void operator()(const T& msgIn)
+	{
+		T keptMsg(msgIn);
+		if (AsnJ2735Lib::msgId<T>::value != MsgEnum::DSRCmsgID_unknown)
+			numKept++;
+	};
+};
+
+/// MsgDecoder shall decode what decode_msgFrame_direct decodes, into the element of the same type,
+/// encode<T> of that element shall produce the same bytes as encode_msgFrame of the frame,
+/// and decode<T> of another message type shall fail
+bool isTypedConformed(const std::vector<uint8_t>& payload, AsnJ2735Lib::MsgDecoder& msgDecoder)
+{
+	Frame_element_t dsrcFrame;
+	reencodeVisitor_t visitor;
+	visitor.dsrcMsgId = MsgEnum::DSRCmsgID_unknown;
+	visitor.numBytes = 0;
+	visitor.buf.assign(DsrcConstants::maxMsgSize, 0xFF);
+	size_t sizeFrame = AsnJ2735Lib::decode_msgFrame_direct(&payload[0], payload.size(), dsrcFrame);
+	size_t sizeTyped = msgDecoder.decode(&payload[0], payload.size(), visitor);
+	if (sizeTyped != sizeFrame)
+		return(false);
+	if (sizeFrame == 0)
+		return(visitor.dsrcMsgId == MsgEnum::DSRCmsgID_unknown);
+	if (visitor.dsrcMsgId != dsrcFrame.dsrcMsgId)
+		return(false);
+	std::vector<uint8_t> bufFrame(DsrcConstants::maxMsgSize, 0);
+	size_t encodeFrame = AsnJ2735Lib::encode_msgFrame(dsrcFrame, &bufFrame[0], bufFrame.size());
+	if ((encodeFrame != visitor.numBytes) || !std::equal(bufFrame.begin(), bufFrame.begin() + encodeFrame, visitor.buf.begin()))
+		return(false);
+	if (dsrcFrame.dsrcMsgId == MsgEnum::DSRCmsgID_bsm)
+	{
+		SPAT_element_t spatOut;
+		return(AsnJ2735Lib::decode(&payload[0], payload.size(), spatOut) == 0);
+	}
+	BSM_element_t bsmOut;
+	return(AsnJ2735Lib::decode(&payload[0], payload.size(), bsmOut) == 0);
+}
+
+/// advance spatIn by one 100 ms tick: timing fields change, and with changeLayout a signal group
+/// or a TimeChangeDetails member comes or goes as well
+void nextSpatTick(SPAT_element_t& spatIn, bool changeLayout, std::mt19937& gen)
+{
+	auto rnd = [&gen](int64_t lb, int64_t ub)->int64_t
+		{return(std::uniform_int_distribution<int64_t>(lb, ub)(gen));};
+	spatIn.msgCnt = static_cast<uint8_t>((spatIn.msgCnt + 1) % 128);
+	if (spatIn.timeStampSec < 0xFFFF)
+		spatIn.timeStampSec = static_cast<uint16_t>((spatIn.timeStampSec + 100) % 60000);
+	if (rnd(0, 9) == 0)
+		spatIn.status.flip(static_cast<size_t>(rnd(0, 15)));
+	for (size_t i = 0; i < 8; i++)
+	{
+		for (auto phaseState : {&spatIn.phaseState[i], &spatIn.pedPhaseState[i]})
+		{
+			if (rnd(0, 4) == 0)
+				phaseState->currState = static_cast<MsgEnum::phaseState>(rnd(0, 9));
+			for (auto timeMark : {&phaseState->startTime, &phaseState->minEndTime, &phaseState->maxEndTime})
+			{
+				if (*timeMark < MsgEnum::unknown_timeDetail)
+					*timeMark = static_cast<uint16_t>(rnd(0, 36000));
+			}
+		}
+	}
+	if (!changeLayout)
+		return;
+	size_t i = static_cast<size_t>(rnd(0, 7));
+	switch(rnd(0, 3))
+	{
+	case 0:
+		spatIn.permittedPhases.flip(i);
+		break;
+	case 1:
+		spatIn.permittedPedPhases.flip(i);
+		break;
+	case 2:
+		spatIn.phaseState[i].maxEndTime = static_cast<uint16_t>((spatIn.phaseState[i].maxEndTime < MsgEnum::unknown_timeDetail) ?
+			MsgEnum::unknown_timeDetail : rnd(0, 36000));
+		break;
+	default:
+		spatIn.timeStampSec = static_cast<uint16_t>((spatIn.timeStampSec < 0xFFFF) ? 0xFFFF : rnd(0, 59999));
+		break;
+	}
+}
+
+/// VehicleSafetyExtensions with a PathHistory of numPoints points and a PathPrediction
+std::vector<uint8_t> getVehicleSafetyExt(size_t numPoints)
+{
+	std::vector<uint8_t> buf(DsrcConstants::maxMsgSize, 0);
+	UperBits::Writer wr(&buf[0], buf.size());
+	wr.putBit(false);
+	wr.put(0x06, 4);          // pathHistory, pathPrediction
+	// PathHistory
+	wr.putBit(false);
+	wr.put(0, 2);
+	wr.put(static_cast<uint32_t>(numPoints - 1), 5);
+	for (size_t i = 0; i < numPoints; i++)
+	{ // PathHistoryPoint
+		int64_t k = static_cast<int64_t>(i + 1);
+		wr.putBit(false);
+		wr.put(0, 3);
+		wr.putRange(-150 * k, -131072, 131071, 18);
+		wr.putRange(90 * k, -131072, 131071, 18);
+		wr.putRange(-k, -2048, 2047, 12);
+		wr.putRange(10 * k, 1, 65535, 16);
+	}
+	// PathPrediction
+	wr.putBit(false);
+	wr.putRange(-850, -32767, 32767, 16);
+	wr.putRange(180, 0, 200, 8);
+	buf.resize(wr.ok() ? wr.bytes() : 0);
+	return(buf);
+}
+
+/// BSM with Part II content vehicleSafetyExt (as above) and, when not empty, a regional extension,
+/// the BSMcoreData copied from bsmPayload encoded without
+bool getPartIIbsm(const std::vector<uint8_t>& bsmPayload, const std::vector<uint8_t>& vehicleSafetyExt,
+	const std::vector<uint8_t>& regionalExt, std::vector<uint8_t>& payload)
+{
+	const unsigned int coreBits = 290;
+	std::vector<uint8_t> value(DsrcConstants::maxMsgSize, 0);
+	UperBits::Reader rd(&bsmPayload[0], bsmPayload.size());
+	UperBits::Writer wv(&value[0], value.size());
+	rd.skip(16);
+	rd.getLength();
+	rd.skip(3);
+	wv.putBit(false);
+	wv.put(regionalExt.empty() ? 0x02 : 0x03, 2);   // partII, regional
+	for (unsigned int i = 0; i < coreBits; i += 32)
+	{
+		unsigned int nbits = std::min(coreBits - i, 32U);
+		wv.put(rd.get(nbits), nbits);
+	}
+	wv.put(0, 3);             // one PartIIcontent
+	wv.put(0, 6);             // vehicleSafetyExt
+	wv.putLength(vehicleSafetyExt.size());
+	for (auto byte : vehicleSafetyExt)
+		wv.put(byte, 8);
+	if (!regionalExt.empty())
+	{
+		wv.put(0, 2);         // one RegionalExtension
+		wv.put(128, 8);       // regionId
+		wv.putLength(regionalExt.size());
+		for (auto byte : regionalExt)
+			wv.put(byte, 8);
+	}
+	payload.assign(DsrcConstants::maxMsgSize, 0);
+	UperBits::Writer wf(&payload[0], payload.size());
+	wf.putBit(false);
+	wf.put(MsgEnum::DSRCmsgID_bsm, 15);
+	wf.putLength(wv.bytes());
+	for (size_t i = 0; i < wv.bytes(); i++)
+		wf.put(value[i], 8);
+	payload.resize(wf.bytes());
+	return(rd.ok() && wv.ok() && wf.ok());
+}
+
+/// decode_msgFrame_lazy shall note where Part II content and regional extension of getPartIIbsm are
+bool isPartIIconformed(const std::vector<uint8_t>& payload, const std::vector<uint8_t>& vehicleSafetyExt,
+	const std::vector<uint8_t>& regionalExt)
+{
+	Frame_element_t dsrcFrame;
+	AsnJ2735Lib::bsmExtensions_t bsmExt;
+	std::vector<uint8_t> value(DsrcConstants::maxMsgSize, 0);
+	if ((AsnJ2735Lib::decode_msgFrame_lazy(&payload[0], payload.size(), dsrcFrame, bsmExt) != payload.size())
+			|| (bsmExt.partII.size() != 1) || (bsmExt.partII[0].id != 0)
+			|| (bsmExt.regional.size() != (regionalExt.empty() ? 0 : 1)))
+		return(false);
+	size_t valueSize = AsnJ2735Lib::get_openTypeValue(&payload[0], payload.size(), bsmExt.partII[0], &value[0], value.size());
+	if ((valueSize != vehicleSafetyExt.size()) || !std::equal(vehicleSafetyExt.begin(), vehicleSafetyExt.end(), value.begin()))
+		return(false);
+	if (regionalExt.empty())
+		return(true);
+	if (bsmExt.regional[0].id != 128)
+		return(false);
+	valueSize = AsnJ2735Lib::get_openTypeValue(&payload[0], payload.size(), bsmExt.regional[0], &value[0], value.size());
+	return((valueSize == regionalExt.size()) && std::equal(regionalExt.begin(), regionalExt.end(), value.begin()));
+}
+
+/// decode_msgFrame_direct shall decode a BSM with vehicleSafetyExt by itself, as decode_msgFrame does,
+/// without passing it on to the asn1c path (which would allocate from the decoding arena)
+bool isPartIIdirect(const std::vector<uint8_t>& payload)
+{
+	Frame_element_t dsrcFrame;
+	Frame_element_t asn1cFrame;
+	AsnJ2735Lib::arenaStats_t stats0 = AsnJ2735Lib::get_decodeArenaStats();
+	size_t consumed = AsnJ2735Lib::decode_msgFrame_direct(&payload[0], payload.size(), dsrcFrame);
+	AsnJ2735Lib::arenaStats_t stats1 = AsnJ2735Lib::get_decodeArenaStats();
+	return((consumed == payload.size()) && (stats1.numAllocs == stats0.numAllocs)
+		&& (AsnJ2735Lib::decode_msgFrame(&payload[0], payload.size(), asn1cFrame) == consumed)
+		&& (dsrcFrame.bsm.id == asn1cFrame.bsm.id) && (dsrcFrame.bsm.latitude == asn1cFrame.bsm.latitude));
+}
+
+/// read MAP payload in hex from a .payload file
+bool readPayloadFile(const std::string& fname, std::vector<sample_t>& samples)
+{
+	std::ifstream IS_F(fname);
+	if (!IS_F.is_open())
+		return(false);
+	std::string line;
+	while (std::getline(IS_F, line))
+	{
+		std::istringstream iss(line);
+		std::string key, name, hex;
+		iss >> key >> name >> hex;
+		if ((key.compare("payload") != 0) || hex.empty() || (hex.length() % 2 != 0))
+			continue;
+		sample_t sample;
+		sample.name = std::string("MAP ") + name;
+		for (size_t i = 0; i < hex.length(); i += 2)
+			sample.payload.push_back(static_cast<uint8_t>(std::strtoul(hex.substr(i, 2).c_str(), NULL, 16)));
+		samples.push_back(sample);
+	}
+	IS_F.close();
+	return(true);
+}
+
+/// log sink that drops the lines, for timing the rate-limited log path
+void discardCodecLog(AsnJ2735Lib::codecError, const char*, const char*, const AsnJ2735Lib::codecErrorDetail_t&)
+{}
+
+/// time the decoding function over numIters repetitions of the payload, in nanoseconds per message
+template<typename T, typename F>
+double timeDecoder(const sample_t& sample, size_t numIters, T& decodeOut, F decoder)
+{
+	auto tp = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < numIters; i++)
+	{
+		if (!decoder(&sample.payload[0], sample.payload.size(), decodeOut))
+			return(-1.0);
+	}
+	auto dt = std::chrono::steady_clock::now() - tp;
+	return(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+		/ static_cast<double>(numIters));
+}
+
+/// time the encoding function over numIters repetitions of dsrcFrameIn, in nanoseconds per message
+template<typename F>
+double timeEncoder(const Frame_element_t& dsrcFrameIn, size_t numIters, std::vector<uint8_t>& buf, F encoder)
+{
+	auto tp = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < numIters; i++)
+	{
+		if (encoder(dsrcFrameIn, &buf[0], buf.size()) == 0)
+			return(-1.0);
+	}
+	auto dt = std::chrono::steady_clock::now() - tp;
+	return(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+		/ static_cast<double>(numIters));
+}
+
+/// time encode<T> and decode<T> of msgIn over numIters repetitions, in nanoseconds per message.
+/// Returns the number of bytes of the encoding, 0 when the encoding or the decoding fails
+template<typename T>
+size_t timeTypedCodec(const T& msgIn, size_t numIters, std::vector<uint8_t>& buf, double& t_encode, double& t_decode)
+{
+	size_t numBytes = 0;
+	auto tp = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < numIters; i++)
+	{
+		if ((numBytes = AsnJ2735Lib::encode(msgIn, &buf[0], buf.size())) == 0)
+			return(0);
+	}
+	auto dt = std::chrono::steady_clock::now() - tp;
+	t_encode = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+		/ static_cast<double>(numIters);
+	T msgOut;
+	tp = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < numIters; i++)
+	{
+		if (AsnJ2735Lib::decode(&buf[0], numBytes, msgOut) == 0)
+			return(0);
+	}
+	dt = std::chrono::steady_clock::now() - tp;
+	t_decode = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+		/ static_cast<double>(numIters);
+	return(numBytes);
+}
+
+/// compare one message that covers a corridor with one message per intersection, by bytes and by
+/// encoding and decoding time
+template<typename T>
+void timeCorridor(const std::string& name, const T& corridorIn, const std::vector<T>& singles, size_t numIters, std::vector<uint8_t>& buf)
+{
+	double t_encodeCorridor, t_decodeCorridor;
+	size_t corridorBytes = timeTypedCodec(corridorIn, numIters, buf, t_encodeCorridor, t_decodeCorridor);
+	double t_encodeSingles = 0;
+	double t_decodeSingles = 0;
+	size_t singleBytes = 0;
+	for (const auto& msgIn : singles)
+	{
+		double t_encode, t_decode;
+		size_t numBytes = timeTypedCodec(msgIn, numIters, buf, t_encode, t_decode);
+		if (numBytes == 0)
+		{
+			singleBytes = 0;
+			break;
+		}
+		singleBytes += numBytes;
+		t_encodeSingles += t_encode;
+		t_decodeSingles += t_decode;
+	}
+	if ((corridorBytes == 0) || (singleBytes == 0))
+	{
+		std::cerr << "Failed encoding corridor " << name << std::endl;
+		return;
+	}
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << name << " of " << singles.size() << " intersections" << std::endl;
+	std::string corridorLabel = "one " + name + ":";
+	std::string singlesLabel = std::to_string(singles.size()) + " " + name + "s:";
+	std::cout << "\t" << std::left << std::setw(16) << corridorLabel << std::right << corridorBytes << " bytes, encode "
+		<< t_encodeCorridor << " ns, decode " << t_decodeCorridor << " ns" << std::endl;
+	std::cout << "\t" << std::left << std::setw(16) << singlesLabel << std::right << singleBytes << " bytes, encode "
+		<< t_encodeSingles << " ns, decode " << t_decodeSingles << " ns" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	int option;
+	size_t numIters = 100000;
+	size_t numRandom = 1000;
+	unsigned int numWorkers = 2;
+	std::vector<std::string> fpayloads;
+
+	while ((option = getopt(argc, argv, "n:f:r:t:?")) != EOF)
+	{
+		switch(option)
+		{
+		case 'n':
+			numIters = static_cast<size_t>(std::strtoul(optarg, NULL, 10));
+			break;
+		case 'f':
+			fpayloads.push_back(std::string(optarg));
+			break;
+		case 'r':
+			numRandom = static_cast<size_t>(std::strtoul(optarg, NULL, 10));
+			break;
+		case 't':
+			numWorkers = static_cast<unsigned int>(std::strtoul(optarg, NULL, 10));
+			break;
+		case '?':
+		default:
+			do_usage(argv[0]);
+			break;
+		}
+	}
+	if (numIters == 0)
+		do_usage(argv[0]);
+
+	/// encode sample messages
+	std::vector<sample_t> samples;
+	std::vector<uint8_t> buf(DsrcConstants::maxMsgSize, 0);
+	Frame_element_t dsrcFrameIn;
+	const std::vector< std::pair<std::string, uint16_t> > msgTypes = {{"BSM", MsgEnum::DSRCmsgID_bsm},
+		{"SRM", MsgEnum::DSRCmsgID_srm}, {"SPaT", MsgEnum::DSRCmsgID_spat}, {"SSM", MsgEnum::DSRCmsgID_ssm},
+		{"RTCM", MsgEnum::DSRCmsgID_rtcm}};
+	for (const auto& msgType : msgTypes)
+	{
+		setSampleFrame(dsrcFrameIn, msgType.second);
+		size_t payload_size = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &buf[0], buf.size());
+		if (payload_size == 0)
+		{
+			std::cerr << "Failed encode_msgFrame for " << msgType.first << std::endl;
+			return(-1);
+		}
+		sample_t sample;
+		sample.name = msgType.first;
+		sample.payload.assign(buf.begin(), buf.begin() + payload_size);
+		samples.push_back(sample);
+	}
+	/// BSM with Part II, as sent by most OBUs, and with a regional extension as well,
+	/// which the asn1c path rejects as none is compiled in
+	const std::vector<uint8_t> vehicleSafetyExt = getVehicleSafetyExt(15);
+	const std::vector<uint8_t> regionalExt = {0x5A, 0xA5};
+	sample_t partIIsample;
+	partIIsample.name = "BSM with Part II";
+	std::vector<uint8_t> regionalPayload;
+	if (!getPartIIbsm(samples[0].payload, vehicleSafetyExt, std::vector<uint8_t>(), partIIsample.payload)
+		|| !getPartIIbsm(samples[0].payload, vehicleSafetyExt, regionalExt, regionalPayload))
+	{
+		std::cerr << "Failed encoding " << partIIsample.name << std::endl;
+		return(-1);
+	}
+	samples.push_back(partIIsample);
+	bool partIIconformed = isPartIIconformed(partIIsample.payload, vehicleSafetyExt, std::vector<uint8_t>())
+		&& isPartIIconformed(regionalPayload, vehicleSafetyExt, regionalExt);
+	bool partIIdirect = isPartIIdirect(partIIsample.payload);
+	for (const auto& fpayload : fpayloads)
+	{
+		if (!readPayloadFile(fpayload, samples))
+		{
+			std::cerr << "Failed open " << fpayload << std::endl;
+			return(-1);
+		}
+	}
+
+	/// conformance of decode_msgFrame_direct: samples, random messages, and bit-flipped copies of both.
+	/// conformance of encode_msgFrame_direct: sample and random BSM and SPaT, and a copy of each with
+	/// msgCnt out of range, which both encoders shall reject.
+	/// Random data elements and bit flips often fail encoding or decoding, which the codec counts without logging
+	AsnJ2735Lib::reset_codecErrorStats();
+	std::mt19937 gen(20190101);
+	std::vector< std::vector<uint8_t> > corpus;
+	for (const auto& sample : samples)
+		corpus.push_back(sample.payload);
+	size_t numEncodeChecks = 0;
+	size_t numEncodeMismatches = 0;
+	auto checkEncoder = [&numEncodeChecks, &numEncodeMismatches](Frame_element_t& dsrcFrame)->void
+	{
+		uint8_t* pMsgCnt;
+		switch(dsrcFrame.dsrcMsgId)
+		{
+		case MsgEnum::DSRCmsgID_bsm:
+			pMsgCnt = &dsrcFrame.bsm.msgCnt;
+			break;
+		case MsgEnum::DSRCmsgID_spat:
+			pMsgCnt = &dsrcFrame.spat.msgCnt;
+			break;
+		case MsgEnum::DSRCmsgID_rtcm:
+			pMsgCnt = &dsrcFrame.rtcm.msgCnt;
+			break;
+		default:
+			return;
+		}
+		uint8_t& msgCnt = *pMsgCnt;
+		uint8_t validCnt = msgCnt;
+		for (uint8_t cnt : {validCnt, static_cast<uint8_t>(validCnt | 0x80)})
+		{
+			msgCnt = cnt;
+			numEncodeChecks++;
+			if (!isDirectEncodeConformed(dsrcFrame))
+				numEncodeMismatches++;
+		}
+		msgCnt = validCnt;
+	};
+	for (const auto& msgType : msgTypes)
+	{
+		setSampleFrame(dsrcFrameIn, msgType.second);
+		checkEncoder(dsrcFrameIn);
+		for (size_t i = 0; i < numRandom; i++)
+		{
+			setRandomFrame(dsrcFrameIn, msgType.second, gen);
+			checkEncoder(dsrcFrameIn);
+			size_t payload_size = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &buf[0], buf.size());
+			if (payload_size > 0)
+				corpus.push_back(std::vector<uint8_t>(buf.begin(), buf.begin() + payload_size));
+		}
+	}
+	/// SpatEncoder of a corridor of intersections, ticking with a layout change now and then and an
+	/// out-of-range msgCnt once in a while, shall produce the same bytes as encode_msgFrame
+	const size_t numIntersections = 8;
+	std::vector<AsnJ2735Lib::SpatEncoder> spatEncoders(numIntersections);
+	std::vector<SPAT_element_t> corridor(numIntersections);
+	for (auto& spatIn : corridor)
+	{
+		setRandomFrame(dsrcFrameIn, MsgEnum::DSRCmsgID_spat, gen);
+		spatIn = dsrcFrameIn.spat;
+	}
+	size_t numSpatChecks = 0;
+	size_t numSpatMismatches = 0;
+	std::vector<uint8_t> spatBuf(DsrcConstants::maxMsgSize, 0);
+	for (size_t tick = 0; tick < numRandom; tick++)
+	{
+		for (size_t i = 0; i < numIntersections; i++)
+		{
+			SPAT_element_t& spatIn = corridor[i];
+			nextSpatTick(spatIn, (tick % 20 == i), gen);
+			uint8_t validCnt = spatIn.msgCnt;
+			if (tick % 50 == i)
+				spatIn.msgCnt = static_cast<uint8_t>(validCnt | 0x80);
+			dsrcFrameIn.reset();
+			dsrcFrameIn.dsrcMsgId = MsgEnum::DSRCmsgID_spat;
+			dsrcFrameIn.spat = spatIn;
+			size_t sizeAsn1c = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &buf[0], buf.size());
+			size_t sizePatch = spatEncoders[i].encode(spatIn, &spatBuf[0], spatBuf.size());
+			numSpatChecks++;
+			if ((sizeAsn1c != sizePatch) || !std::equal(buf.begin(), buf.begin() + sizeAsn1c, spatBuf.begin()))
+				numSpatMismatches++;
+			spatIn.msgCnt = validCnt;
+		}
+	}
+	size_t numSpatPatches = 0;
+	for (const auto& spatEncoder : spatEncoders)
+		numSpatPatches += spatEncoder.getNumPatches();
+	size_t numEncoded = corpus.size();
+	for (size_t i = 0; i < numEncoded; i++)
+	{
+		std::vector<uint8_t> payload = corpus[i];
+		size_t bitpos = std::uniform_int_distribution<size_t>(0, payload.size() * 8 - 1)(gen);
+		payload[bitpos >> 3] = static_cast<uint8_t>(payload[bitpos >> 3] ^ (0x80 >> (bitpos & 7)));
+		corpus.push_back(payload);
+	}
+	size_t numMismatches = 0;
+	size_t numPeekMismatches = 0;
+	size_t numRtcmViewMismatches = 0;
+	size_t numTypedMismatches = 0;
+	size_t numOerMismatches = 0;
+	size_t numCacheMismatches = 0;
+	AsnJ2735Lib::CachedDecoder cachedDecoder;
+	size_t numUperBytes = 0;
+	size_t numOerBytes = 0;
+	AsnJ2735Lib::MsgDecoder msgDecoder;
+	for (const auto& payload : corpus)
+	{
+		if (!isOerConformed(payload, numUperBytes, numOerBytes))
+			numOerMismatches++;
+		if (!isCachedConformed(payload, cachedDecoder))
+			numCacheMismatches++;
+		if (!isTypedConformed(payload, msgDecoder))
+			numTypedMismatches++;
+		if (!isDirectConformed(payload))
+			numMismatches++;
+		if (!isPeekConformed(payload))
+			numPeekMismatches++;
+		if (!isRtcmViewConformed(payload))
+			numRtcmViewMismatches++;
+	}
+	/// BatchDecoder shall give each message the same result as decode_msgFrame_direct
+	std::vector<AsnJ2735Lib::msgBuf_t> batch;
+	for (const auto& payload : corpus)
+		batch.push_back({&payload[0], payload.size()});
+	batch.push_back({NULL, 0});
+	std::vector<AsnJ2735Lib::decodeResult_t> results;
+	size_t numBatchMismatches = 0;
+	for (unsigned int threads : {0U, numWorkers})
+	{
+		AsnJ2735Lib::BatchDecoder batchDecoder(threads);
+		size_t numDecoded = batchDecoder.decode(batch, results);
+		size_t numExpected = 0;
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			size_t size = (batch[i].size == 0) ? 0 : AsnJ2735Lib::decode_msgFrame_direct(batch[i].buf, batch[i].size, dsrcFrameIn);
+			AsnJ2735Lib::decodeStatus status = (batch[i].size == 0) ? AsnJ2735Lib::decodeStatus::empty
+				: ((size > 0) ? AsnJ2735Lib::decodeStatus::decoded : AsnJ2735Lib::decodeStatus::failed);
+			if (size > 0)
+				numExpected++;
+			if ((results[i].status != status) || (results[i].consumed != size)
+				|| ((size > 0) && (results[i].dsrcFrame.dsrcMsgId != dsrcFrameIn.dsrcMsgId)))
+				numBatchMismatches++;
+		}
+		if (numDecoded != numExpected)
+			numBatchMismatches++;
+	}
+	AsnJ2735Lib::streamStats_t streamStats;
+	size_t numStreamMismatches = countStreamMismatches(corpus, gen, streamStats);
+	bool streamFlushed = isStreamFlushed(samples[0].payload);
+	bool shortRingRejected = isShortRingRejected();
+	bool oerOversizeRejected = isOerOversizeRejected();
+	std::vector<uint8_t> longPayload(samples[0].payload);
+	longPayload.resize(300, 0x5A);
+	bool pcapConformed = isCaptureConformed(getPcapFixture(samples[0].payload, longPayload));
+	bool pcapngConformed = isCaptureConformed(getPcapngFixture(samples[0].payload));
+	AsnJ2735Lib::codecErrorStats_t errorStats = AsnJ2735Lib::get_codecErrorStats();
+	std::cout << "decode_msgFrame_direct conformance: " << corpus.size() << " payloads ("
+		<< numEncoded << " encoded, " << corpus.size() - numEncoded << " bit-flipped), "
+		<< numMismatches << " mismatches" << std::endl;
+	std::cout << "encode_msgFrame_direct conformance: " << numEncodeChecks << " messages, "
+		<< numEncodeMismatches << " mismatches" << std::endl;
+	std::cout << "RTCMview_t conformance: " << corpus.size() << " payloads, "
+		<< numRtcmViewMismatches << " mismatches" << std::endl;
+	std::cout << "SpatEncoder conformance: " << numSpatChecks << " messages (" << numSpatPatches << " patched), "
+		<< numSpatMismatches << " mismatches" << std::endl;
+	std::cout << "BSM Part II and regional extension noted: " << (partIIconformed ? "yes" : "no") << std::endl;
+	std::cout << "BSM Part II decoded without the asn1c path: " << (partIIdirect ? "yes" : "no") << std::endl;
+	std::cout << "MsgDecoder and encode<T> conformance: " << corpus.size() << " payloads, "
+		<< numTypedMismatches << " mismatches" << std::endl;
+	std::cout << "peek_msgFrame conformance: " << corpus.size() << " payloads, "
+		<< numPeekMismatches << " mismatches" << std::endl;
+	std::cout << "BatchDecoder conformance: " << batch.size() << " messages, 0 and " << numWorkers
+		<< " worker threads, " << numBatchMismatches << " mismatches" << std::endl;
+	std::cout << "OER round trip conformance: " << corpus.size() << " payloads (" << numUperBytes << " bytes UPER, "
+		<< numOerBytes << " bytes OER), " << numOerMismatches << " mismatches, oversized SSM rejected: "
+		<< (oerOversizeRejected ? "yes" : "no") << std::endl;
+	std::cout << "CachedDecoder conformance: " << corpus.size() << " payloads, " << cachedDecoder.getStats().numHits
+		<< " hits, " << cachedDecoder.getStats().numMisses << " misses, " << numCacheMismatches << " mismatches" << std::endl;
+	std::cout << "StreamDecoder conformance: " << streamStats.numFrames << " frames, " << streamStats.numCompactions
+		<< " compactions, " << numStreamMismatches << " mismatches, unfinished frame flushed: "
+		<< (streamFlushed ? "yes" : "no") << ", short ring rejected: " << (shortRingRejected ? "yes" : "no") << std::endl;
+	std::cout << "CaptureReader conformance: pcap " << (pcapConformed ? "yes" : "no") << ", pcapng "
+		<< (pcapngConformed ? "yes" : "no") << std::endl;
+	std::cout << "Codec failures during conformance:";
+	for (size_t i = 1; i < AsnJ2735Lib::numCodecErrors; i++)
+		std::cout << " " << AsnJ2735Lib::codecErrorName(static_cast<AsnJ2735Lib::codecError>(i)) << " " << errorStats.counts[i];
+	std::cout << std::endl;
+
+	/// encoding of BSM, SPaT and RTCM, direct and asn1c, and of RTCM from a view on its payload
+	std::cout << "Encode " << numIters << " iterations per message" << std::endl;
+	for (const auto& msgType : msgTypes)
+	{
+		if ((msgType.second != MsgEnum::DSRCmsgID_bsm) && (msgType.second != MsgEnum::DSRCmsgID_spat)
+				&& (msgType.second != MsgEnum::DSRCmsgID_rtcm))
+			continue;
+		setSampleFrame(dsrcFrameIn, msgType.second);
+		double t_asn1c = timeEncoder(dsrcFrameIn, numIters, buf, AsnJ2735Lib::encode_msgFrame);
+		double t_direct = timeEncoder(dsrcFrameIn, numIters, buf, AsnJ2735Lib::encode_msgFrame_direct);
+		if ((t_asn1c < 0) || (t_direct < 0))
+		{
+			std::cerr << "Failed encode_msgFrame for " << msgType.first << std::endl;
+			continue;
+		}
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << msgType.first << std::endl;
+		std::cout << "\t" << "encode_msgFrame:        " << t_asn1c << " ns/msg" << std::endl;
+		std::cout << "\t" << "encode_msgFrame_direct: " << t_direct << " ns/msg, speedup "
+			<< t_asn1c / t_direct << "x" << std::endl;
+		if (msgType.second != MsgEnum::DSRCmsgID_rtcm)
+			continue;
+		const RTCM_element_t& rtcmIn = dsrcFrameIn.rtcm;
+		const RTCMview_t rtcmView = {rtcmIn.msgCnt, rtcmIn.rev, rtcmIn.timeStampMinute, &rtcmIn.payload[0], 0, rtcmIn.payload.size()};
+		double t_view = timeEncoder(dsrcFrameIn, numIters, buf,
+			[&rtcmView](const Frame_element_t&, uint8_t* msgBuf, size_t size)->size_t
+			{return(AsnJ2735Lib::encode_rtcm_view(rtcmView, msgBuf, size));});
+		std::cout << "\t" << "encode_rtcm_view:       " << t_view << " ns/msg, speedup "
+			<< t_asn1c / t_view << "x" << std::endl;
+	}
+	/// encoding of SPaT ticks, SpatEncoder and encode_msgFrame_direct
+	{
+		setSampleFrame(dsrcFrameIn, MsgEnum::DSRCmsgID_spat);
+		SPAT_element_t& spatIn = dsrcFrameIn.spat;
+		AsnJ2735Lib::SpatEncoder spatEncoder;
+		auto timeSpatTicks = [&spatIn, numIters](const std::function<size_t(void)>& encoder)->double
+		{
+			auto tp = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < numIters; i++)
+			{
+				spatIn.msgCnt = static_cast<uint8_t>((spatIn.msgCnt + 1) % 128);
+				spatIn.timeStampSec = static_cast<uint16_t>((spatIn.timeStampSec + 100) % 60000);
+				spatIn.phaseState[1].minEndTime = static_cast<uint16_t>(i % 36000);
+				if (encoder() == 0)
+					return(-1.0);
+			}
+			auto dt = std::chrono::steady_clock::now() - tp;
+			return(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+				/ static_cast<double>(numIters));
+		};
+		double t_direct = timeSpatTicks([&dsrcFrameIn, &buf]()->size_t
+			{return(AsnJ2735Lib::encode_msgFrame_direct(dsrcFrameIn, &buf[0], buf.size()));});
+		double t_patch = timeSpatTicks([&spatIn, &spatEncoder, &buf]()->size_t
+			{return(spatEncoder.encode(spatIn, &buf[0], buf.size()));});
+		if ((t_direct < 0) || (t_patch < 0))
+			std::cerr << "Failed encoding SPaT ticks" << std::endl;
+		else
+		{
+			std::cout << "SPaT ticks" << std::endl;
+			std::cout << "\t" << "encode_msgFrame_direct: " << t_direct << " ns/msg" << std::endl;
+			std::cout << "\t" << "SpatEncoder:            " << t_patch << " ns/msg, speedup "
+				<< t_direct / t_patch << "x (" << spatEncoder.getNumFullEncodes() << " full encodings)" << std::endl;
+		}
+	}
+	/// a corridor of 8 intersections, as one SPaT with 8 IntersectionStates and as 8 single intersection SPaTs,
+	/// and the priority requests of a bus to the same 8 intersections, as one SRM and as 8 SRMs
+	{
+		const size_t corridorSize = 8;
+		setSampleFrame(dsrcFrameIn, MsgEnum::DSRCmsgID_spat);
+		std::vector<SPAT_element_t> singleSpats(corridorSize, dsrcFrameIn.spat);
+		SPAT_element_t corridorSpat = dsrcFrameIn.spat;
+		corridorSpat.moreIntersections.resize(corridorSize - 1);
+		setSampleFrame(dsrcFrameIn, MsgEnum::DSRCmsgID_srm);
+		std::vector<SRM_element_t> singleSrms(corridorSize, dsrcFrameIn.srm);
+		SRM_element_t corridorSrm = dsrcFrameIn.srm;
+		corridorSrm.moreRequests.resize(corridorSize - 1);
+		for (size_t i = 0; i < corridorSize; i++)
+		{
+			singleSpats[i].id = static_cast<uint16_t>(singleSpats[i].id + i);
+			corridorSpat.intersection(i) = singleSpats[i];
+			singleSrms[i].intId = static_cast<uint16_t>(singleSrms[i].intId + i);
+			singleSrms[i].ETAsec = static_cast<uint16_t>((singleSrms[i].ETAsec + 15000 * i) % 60000);
+			corridorSrm.request(i) = singleSrms[i];
+		}
+		timeCorridor("SPaT", corridorSpat, singleSpats, numIters, buf);
+		timeCorridor("SRM", corridorSrm, singleSrms, numIters, buf);
+	}
+	/// encoding of MAP, with the data elements decoded from the payload
+	Frame_element_t dsrcFrameOut;
+	for (const auto& sample : samples)
+	{
+		if ((AsnJ2735Lib::decode_msgFrame(&sample.payload[0], sample.payload.size(), dsrcFrameOut) == 0)
+			|| (dsrcFrameOut.dsrcMsgId != MsgEnum::DSRCmsgID_map))
+			continue;
+		double t_asn1c = timeEncoder(dsrcFrameOut, numIters, buf, AsnJ2735Lib::encode_msgFrame);
+		if (t_asn1c < 0)
+		{
+			std::cerr << "Failed encode_msgFrame for " << sample.name << std::endl;
+			continue;
+		}
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << sample.name << std::endl;
+		std::cout << "\t" << "encode_msgFrame:        " << t_asn1c << " ns/msg" << std::endl;
+	}
+
+	std::cout << "Decode " << numIters << " iterations per message" << std::endl;
+	AsnJ2735Lib::bsmExtensions_t bsmExt;
+	for (const auto& sample : samples)
+	{
+		std::cout << sample.name << " (" << sample.payload.size() << " bytes)" << std::endl;
+		/// heap-backed asn1c tree
+		double t_heap = timeDecoder(sample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame);
+		/// arena-backed asn1c tree, warm up first so that the arena reaches its steady-state size
+		AsnJ2735Lib::decode_msgFrame_arena(&sample.payload[0], sample.payload.size(), dsrcFrameOut);
+		AsnJ2735Lib::arenaStats_t stats0 = AsnJ2735Lib::get_decodeArenaStats();
+		double t_arena = timeDecoder(sample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame_arena);
+		AsnJ2735Lib::arenaStats_t stats1 = AsnJ2735Lib::get_decodeArenaStats();
+		/// direct bits-to-struct decoding (MAP goes through the arena-backed path), into the same dsrcFrameOut
+		size_t numHeapAllocs0 = numHeapAllocs;
+		double t_direct = timeDecoder(sample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame_direct);
+		double heapAllocsPerMsg = static_cast<double>(numHeapAllocs - numHeapAllocs0) / static_cast<double>(numIters);
+		/// the same into the element of the message type only
+		copyVisitor_t visitor;
+		visitor.numKept = 0;
+		double t_typed = timeDecoder(sample, numIters, visitor,
+			[&msgDecoder](const uint8_t* payload, size_t size, copyVisitor_t& v)->size_t
+			{return(msgDecoder.decode(payload, size, v));});
+		/// direct decoding that skips open types
+		double t_lazy = timeDecoder(sample, numIters, dsrcFrameOut,
+			[&bsmExt](const uint8_t* payload, size_t size, Frame_element_t& dsrcFrame)->size_t
+			{return(AsnJ2735Lib::decode_msgFrame_lazy(payload, size, dsrcFrame, bsmExt));});
+		/// leading fields only
+		AsnJ2735Lib::msgHeader_t header;
+		double t_peek = timeDecoder(sample, numIters, header, AsnJ2735Lib::peek_msgFrame);
+		if ((t_heap < 0) || (t_arena < 0) || (t_direct < 0) || (t_typed < 0) || (t_lazy < 0) || (t_peek < 0))
+		{
+			std::cerr << "Failed decode_msgFrame for " << sample.name << std::endl;
+			continue;
+		}
+		double allocsPerMsg = static_cast<double>(stats1.numAllocs - stats0.numAllocs) / static_cast<double>(numIters);
+		double sysAllocsPerMsg = static_cast<double>(stats1.numSysAllocs - stats0.numSysAllocs) / static_cast<double>(numIters);
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << "\t" << "decode_msgFrame:        " << t_heap << " ns/msg, "
+			<< allocsPerMsg << " heap allocations/msg" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_arena:  " << t_arena << " ns/msg, "
+			<< sysAllocsPerMsg << " heap allocations/msg (arena " << stats1.capacity
+			<< " bytes, high water " << stats1.highWater << " bytes)" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_direct: " << t_direct << " ns/msg, speedup "
+			<< t_heap / t_direct << "x, " << heapAllocsPerMsg << " heap allocations/msg" << std::endl;
+		std::cout << "\t" << "MsgDecoder:             " << t_typed << " ns/msg (element copied)" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_lazy:   " << t_lazy << " ns/msg" << std::endl;
+		std::cout << "\t" << "peek_msgFrame:          " << t_peek << " ns/msg" << std::endl;
+		if (dsrcFrameOut.dsrcMsgId != MsgEnum::DSRCmsgID_rtcm)
+			continue;
+		/// RTCMmessage octets left in the payload
+		RTCMview_t rtcmView;
+		double t_view = timeDecoder(sample, numIters, rtcmView, AsnJ2735Lib::decode_rtcm_view);
+		std::cout << "\t" << "decode_rtcm_view:       " << t_view << " ns/msg, "
+			<< ((rtcmView.data() != NULL) ? "byte-aligned" : "not byte-aligned") << std::endl;
+	}
+
+	/// OER against UPER, encoding each sample from its decoded data elements and decoding the result
+	std::cout << "UPER and OER " << numIters << " iterations per message" << std::endl;
+	for (const auto& sample : samples)
+	{
+		if (AsnJ2735Lib::decode_msgFrame(&sample.payload[0], sample.payload.size(), dsrcFrameIn) == 0)
+			continue;
+		size_t uperSize = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &buf[0], buf.size());
+		sample_t uperSample;
+		uperSample.name = sample.name;
+		uperSample.payload.assign(buf.begin(), buf.begin() + uperSize);
+		size_t oerSize = AsnJ2735Lib::encode_msgFrame_oer(dsrcFrameIn, &buf[0], buf.size());
+		sample_t oerSample;
+		oerSample.name = sample.name;
+		oerSample.payload.assign(buf.begin(), buf.begin() + oerSize);
+		if ((uperSize == 0) || (oerSize == 0))
+		{
+			std::cerr << "Failed encode_msgFrame_oer for " << sample.name << std::endl;
+			continue;
+		}
+		if (uperSize != sample.payload.size())
+			continue;  /// content that Frame_element_t does not carry, such as BSM Part II, would not be compared
+		double t_encodeUper = timeEncoder(dsrcFrameIn, numIters, buf, AsnJ2735Lib::encode_msgFrame);
+		double t_encodeOer = timeEncoder(dsrcFrameIn, numIters, buf, AsnJ2735Lib::encode_msgFrame_oer);
+		double t_decodeUper = timeDecoder(uperSample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame_arena);
+		double t_decodeOer = timeDecoder(oerSample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame_oer);
+		if ((t_encodeUper < 0) || (t_encodeOer < 0) || (t_decodeUper < 0) || (t_decodeOer < 0))
+		{
+			std::cerr << "Failed OER timing for " << sample.name << std::endl;
+			continue;
+		}
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << sample.name << " (" << uperSize << " bytes UPER, " << oerSize << " bytes OER)" << std::endl;
+		std::cout << "\t" << "encode_msgFrame:        " << t_encodeUper << " ns/msg" << std::endl;
+		std::cout << "\t" << "encode_msgFrame_oer:    " << t_encodeOer << " ns/msg, speedup "
+			<< t_encodeUper / t_encodeOer << "x" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_arena:  " << t_decodeUper << " ns/msg" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_oer:    " << t_decodeOer << " ns/msg, speedup "
+			<< t_decodeUper / t_decodeOer << "x" << std::endl;
+	}
+
+	/// a payload repeated, as a MAP re-broadcast every second, decoded each time and found in CachedDecoder
+	std::cout << "Repeated payload " << numIters << " iterations per message" << std::endl;
+	for (const auto& sample : samples)
+	{
+		AsnJ2735Lib::CachedDecoder repeatDecoder;
+		const Frame_element_t* pFrame;
+		bool isRepeat;
+		double t_direct = timeDecoder(sample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame_direct);
+		double t_cached = timeDecoder(sample, numIters, pFrame,
+			[&repeatDecoder, &isRepeat](const uint8_t* payload, size_t size, const Frame_element_t*& pFrameOut)->size_t
+			{return(repeatDecoder.decode(payload, size, pFrameOut, isRepeat));});
+		if ((t_direct < 0) || (t_cached < 0))
+			continue;
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << sample.name << " (" << sample.payload.size() << " bytes)" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_direct: " << t_direct << " ns/msg" << std::endl;
+		std::cout << "\t" << "CachedDecoder:          " << t_cached << " ns/msg, speedup " << t_direct / t_cached
+			<< "x (" << repeatDecoder.getStats().numHits << " hits, " << repeatDecoder.getStats().numMisses << " misses)" << std::endl;
+	}
+
+	/// a stream of BSM, SPaT and SSM decoded into one reused frame, each message kept by a copy of the frame
+	/// as a consumer that queues them would do
+	{
+		std::vector<const sample_t*> stream;
+		for (const auto& sample : samples)
+		{
+			if ((sample.name == "BSM") || (sample.name == "SPaT") || (sample.name == "SSM"))
+				stream.push_back(&sample);
+		}
+		size_t numKept = 0;
+		size_t numHeapAllocs0 = numHeapAllocs;
+		auto tp = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numIters; i++)
+		{
+			const sample_t& sample = *stream[i % stream.size()];
+			if (AsnJ2735Lib::decode_msgFrame_direct(&sample.payload[0], sample.payload.size(), dsrcFrameOut) > 0)
+			{
+				Frame_element_t keptFrame(dsrcFrameOut);
+				if (keptFrame.dsrcMsgId != MsgEnum::DSRCmsgID_unknown)
+					numKept++;
+			}
+		}
+		auto dt = std::chrono::steady_clock::now() - tp;
+		double t_stream = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+			/ static_cast<double>(numIters);
+		double heapAllocsPerMsg = static_cast<double>(numHeapAllocs - numHeapAllocs0) / static_cast<double>(numIters);
+		/// resetting a frame that holds a BSM
+		tp = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numIters; i++)
+		{
+			dsrcFrameOut.dsrcMsgId = MsgEnum::DSRCmsgID_bsm;
+			dsrcFrameOut.reset();
+		}
+		dt = std::chrono::steady_clock::now() - tp;
+		double t_reset = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+			/ static_cast<double>(numIters);
+		/// the same stream through MsgDecoder, which copies the decoded element only
+		copyVisitor_t visitor;
+		visitor.numKept = 0;
+		numHeapAllocs0 = numHeapAllocs;
+		tp = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numIters; i++)
+		{
+			const sample_t& sample = *stream[i % stream.size()];
+			msgDecoder.decode(&sample.payload[0], sample.payload.size(), visitor);
+		}
+		dt = std::chrono::steady_clock::now() - tp;
+		double t_typed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+			/ static_cast<double>(numIters);
+		double typedAllocsPerMsg = static_cast<double>(numHeapAllocs - numHeapAllocs0) / static_cast<double>(numIters);
+		/// BSM alone, into a reused BSM_element_t
+		const sample_t& bsmSample = **std::find_if(stream.begin(), stream.end(),
+			[](const sample_t* pSample)->bool {return(pSample->name == "BSM");});
+		BSM_element_t bsmOut;
+		double t_bsm = timeDecoder(bsmSample, numIters, bsmOut, AsnJ2735Lib::decode<BSM_element_t>);
+		double t_bsmFrame = timeDecoder(bsmSample, numIters, dsrcFrameOut, AsnJ2735Lib::decode_msgFrame_direct);
+		std::cout << "BSM, SPaT and SSM stream, " << numKept << " messages decoded and copied" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_direct: " << t_stream << " ns/msg, "
+			<< heapAllocsPerMsg << " heap allocations/msg" << std::endl;
+		std::cout << "\t" << "MsgDecoder:             " << t_typed << " ns/msg, "
+			<< typedAllocsPerMsg << " heap allocations/msg (" << visitor.numKept << " copied)" << std::endl;
+		std::cout << "\t" << "BSM decode_msgFrame_direct: " << t_bsmFrame << " ns/msg" << std::endl;
+		std::cout << "\t" << "BSM decode<BSM_element_t>:  " << t_bsm << " ns/msg" << std::endl;
+		std::cout << "\t" << "Frame_element_t::reset: " << t_reset << " ns" << std::endl;
+	}
+
+	/// a flood of malformed frames, BSM cut in half, which fail in the direct decoder and again in the
+	/// asn1c path. Failures are counted, and then also passed to a rate-limited log sink
+	{
+		const sample_t& bsmSample = *std::find_if(samples.begin(), samples.end(),
+			[](const sample_t& sample)->bool {return(sample.name == "BSM");});
+		std::vector<uint8_t> truncated(bsmSample.payload.begin(), bsmSample.payload.begin() + bsmSample.payload.size() / 2);
+		auto timeFailures = [&truncated, &dsrcFrameOut, numIters](void)->double
+		{
+			auto tp = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < numIters; i++)
+			{
+				if (AsnJ2735Lib::decode_msgFrame_direct(&truncated[0], truncated.size(), dsrcFrameOut) > 0)
+					return(-1.0);
+			}
+			auto dt = std::chrono::steady_clock::now() - tp;
+			return(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+				/ static_cast<double>(numIters));
+		};
+		AsnJ2735Lib::reset_codecErrorStats();
+		double t_counted = timeFailures();
+		AsnJ2735Lib::set_codecLogSink(discardCodecLog);
+		double t_logged = timeFailures();
+		AsnJ2735Lib::set_codecLogSink(NULL);
+		AsnJ2735Lib::codecErrorStats_t failureStats = AsnJ2735Lib::get_codecErrorStats();
+		std::cout << "Truncated BSM (" << truncated.size() << " bytes), "
+			<< failureStats.counts[static_cast<size_t>(AsnJ2735Lib::codecError::decodeFailed)] << " decodeFailed counted" << std::endl;
+		std::cout << "\t" << "decode_msgFrame_direct: " << t_counted << " ns/msg" << std::endl;
+		std::cout << "\t" << "with rate-limited sink: " << t_logged << " ns/msg, "
+			<< failureStats.numLogged << " logged, " << failureStats.numSuppressed << " suppressed" << std::endl;
+	}
+
+	/// batch decoding of the encoded payloads, one message at a time and with BatchDecoder
+	batch.resize(numEncoded);
+	size_t numRounds = std::max(static_cast<size_t>(1), numIters / numEncoded);
+	auto timeBatch = [&batch, numRounds](const std::function<size_t(void)>& decoder)->double
+	{
+		auto tp = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numRounds; i++)
+		{
+			if (decoder() != batch.size())
+				return(-1.0);
+		}
+		auto dt = std::chrono::steady_clock::now() - tp;
+		return(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count())
+			/ static_cast<double>(numRounds * batch.size()));
+	};
+	AsnJ2735Lib::BatchDecoder serialDecoder(0);
+	AsnJ2735Lib::BatchDecoder pooledDecoder(numWorkers);
+	double t_single = timeBatch([&batch, &dsrcFrameOut]()->size_t
+	{
+		size_t numDecoded = 0;
+		for (const auto& msg : batch)
+		{
+			if (AsnJ2735Lib::decode_msgFrame_direct(msg.buf, msg.size, dsrcFrameOut) > 0)
+				numDecoded++;
+		}
+		return(numDecoded);
+	});
+	double t_serial = timeBatch([&batch, &results, &serialDecoder]()->size_t
+		{return(serialDecoder.decode(batch, results));});
+	double t_pooled = timeBatch([&batch, &results, &pooledDecoder]()->size_t
+		{return(pooledDecoder.decode(batch, results));});
+	std::cout << "Batch decode " << numRounds << " rounds of " << batch.size() << " messages" << std::endl;
+	if ((t_single < 0) || (t_serial < 0) || (t_pooled < 0))
+		std::cerr << "Failed batch decoding" << std::endl;
+	else
+	{
+		std::string pooled = std::string("BatchDecoder(") + std::to_string(numWorkers) + "):";
+		std::cout << "\t" << "decode_msgFrame_direct: " << t_single << " ns/msg" << std::endl;
+		std::cout << "\t" << "BatchDecoder(0):        " << t_serial << " ns/msg" << std::endl;
+		std::cout << "\t" << std::left << std::setw(24) << pooled << t_pooled << " ns/msg, speedup "
+			<< t_single / t_pooled << "x (" << std::thread::hardware_concurrency() << " CPUs)" << std::endl;
+	}
+
+	/// the samples as a length-prefixed stream, read 1400 bytes at a time as from a UDP forwarder
+	std::vector<uint8_t> stream;
+	std::vector<AsnJ2735Lib::msgBuf_t> streamMsgs;
+	while (streamMsgs.size() < numIters)
+	{
+		for (const auto& sample : samples)
+		{
+			appendFrame(stream, &sample.payload[0], sample.payload.size());
+			streamMsgs.push_back({&sample.payload[0], sample.payload.size()});
+		}
+	}
+	std::vector<uint8_t> ring(65536, 0);
+	AsnJ2735Lib::StreamDecoder streamDecoder(&ring[0], ring.size());
+	AsnJ2735Lib::decodeResult_t streamResult;
+	const size_t readSize = 1400;
+	auto tp = std::chrono::steady_clock::now();
+	size_t numStreamed = 0;
+	for (size_t pos = 0; pos < stream.size();)
+	{
+		size_t size;
+		uint8_t* writeBuf = streamDecoder.getWriteBuf(size);
+		size = std::min(std::min(size, readSize), stream.size() - pos);
+		std::copy(stream.begin() + pos, stream.begin() + pos + size, writeBuf);
+		streamDecoder.commit(size);
+		pos += size;
+		while (streamDecoder.next(streamResult))
+			numStreamed++;
+	}
+	double t_stream = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - tp).count());
+	tp = std::chrono::steady_clock::now();
+	for (const auto& msg : streamMsgs)
+		AsnJ2735Lib::decode_msgFrame_direct(msg.buf, msg.size, dsrcFrameOut);
+	double t_framed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - tp).count());
+	std::cout << "Stream decode " << streamMsgs.size() << " messages, " << stream.size() << " bytes read "
+		<< readSize << " bytes at a time" << std::endl;
+	if (numStreamed != streamMsgs.size())
+		std::cerr << "Failed stream decoding" << std::endl;
+	else
+	{
+		double numMsgs = static_cast<double>(streamMsgs.size());
+		std::cout << "\t" << "decode_msgFrame_direct: " << t_framed / numMsgs << " ns/msg (frames given)" << std::endl;
+		std::cout << "\t" << "StreamDecoder:          " << t_stream / numMsgs << " ns/msg, "
+			<< static_cast<double>(stream.size()) * 1000.0 / t_stream << " MB/s, "
+			<< streamDecoder.getStats().numCompactions << " compactions" << std::endl;
+	}
+	return(((numMismatches == 0) && (numEncodeMismatches == 0) && (numSpatMismatches == 0) && partIIconformed && (numPeekMismatches == 0)
+		&& partIIdirect && (numBatchMismatches == 0) && (numRtcmViewMismatches == 0) && (numTypedMismatches == 0)
+		&& (numOerMismatches == 0) && oerOversizeRejected && (numCacheMismatches == 0) && (numStreamMismatches == 0) && streamFlushed
+		&& shortRingRejected && pcapConformed && pcapngConformed) ? 0 : -1);
+}
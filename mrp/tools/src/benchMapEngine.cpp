@@ -0,0 +1,386 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* benchMapEngine.cpp
+ * benchMapEngine measures how the MAP engine scales with the number of intersections in memory.
+ * It takes the first MAP of a .payload file as a template and copies it onto a grid of intersections
+ * 0.01 degree apart, each copy with its own regionalId and intersectionId, and writes sets of 1, 100, 1000
+ * and the given number of copies (10000 by default) into .mapstore files, in a temporary directory that is
+ * removed once each file has been loaded. For each set, it reports the time
+ * to load the file into LocAware, and the time of getIndexByIntersectionId and of locateVehicleInMap, without
+ * and with a reserved workspace, for a vehicle on an inbound lane of a random intersection. Each lookup shall
+ * give the index of the copy and each vehicle shall be located on the inbound approach of the copy it was
+ * placed at, the same with the workspace as without; it exits with -1 otherwise.
+ * Beforehand, it checks the local projection that the locate path uses against GeoUtils::lla2enu through ECEF,
+ * at the template reference point and at other latitudes, for points within 2 km: it reports the time of both
+ * and the largest difference, which shall be below 1 mm, and exits with -1 otherwise.
+ *
+ * Usage: benchMapEngine -f <template .payload> [-s <number of intersections>] [-n <iterations>]
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "AsnJ2735Lib.h"
+#include "dsrcConsts.h"
+#include "geoUtils.h"
+#include "locAware.h"
+#include "mapStore.h"
+
+/// spacing of the intersection grid, in 1/10th micro degrees
+static const int32_t gridSpacing = 100000;
+/// intersections per row of the grid
+static const size_t gridColumns = 100;
+/// distance from the reference point of the points to check the local projection at, in meters
+static const double projCheckDist = 2000.0;
+/// largest difference allowed between the local projection and the ECEF path, in meters
+static const double projErrorBound = 0.001;
+
+void do_usage(const char* progname)
+{
+	std::cerr << "Usage" << progname << std::endl;
+	std::cerr << "\t-f .payload file of the template MAP" << std::endl;
+	std::cerr << "\t-s number of intersections of the largest set, default 10000" << std::endl;
+	std::cerr << "\t-n lookups and vehicles per set, default 10000" << std::endl;
+	std::cerr << "\t-? print this message" << std::endl;
+	exit(EXIT_FAILURE);
+}
+
+/// IDs of copy i, regionalId above 255 so that it takes the upper bits of the lane index key
+uint16_t getRegionalId(size_t i)
+	{return(static_cast<uint16_t>(300 + i / 1000));}
+
+uint16_t getIntersectionId(size_t i)
+	{return(static_cast<uint16_t>(1 + i % 1000));}
+
+/// copy i of the template MAP, moved to its place on the grid. Connections to the template itself follow the copy
+bool encodeSyntheticMap(const MapData_element_t& mapTemplate, size_t i, MapStore::mapEntry_t& entryOut)
+{
+	int32_t dLat = static_cast<int32_t>(i / gridColumns) * gridSpacing;
+	int32_t dLon = static_cast<int32_t>(i % gridColumns) * gridSpacing;
+	Frame_element_t dsrcFrameIn;
+	dsrcFrameIn.reset();
+	dsrcFrameIn.dsrcMsgId = MsgEnum::DSRCmsgID_map;
+	MapData_element_t& mapData = dsrcFrameIn.mapData;
+	mapData = mapTemplate;
+	mapData.regionalId = getRegionalId(i);
+	mapData.id = getIntersectionId(i);
+	mapData.geoRef.latitude += dLat;
+	mapData.geoRef.longitude += dLon;
+	for (auto& appData : mapData.mpApproaches)
+	{
+		for (auto& laneData : appData.mpLanes)
+		{
+			for (auto& nodeData : laneData.mpNodes)
+			{
+				if (nodeData.useXY)
+					continue;
+				nodeData.latitude += dLat;
+				nodeData.longitude += dLon;
+			}
+			for (auto& connData : laneData.mpConnectTo)
+			{
+				if ((connData.regionalId == mapTemplate.regionalId) && (connData.intersectionId == mapTemplate.id))
+				{
+					connData.regionalId = mapData.regionalId;
+					connData.intersectionId = mapData.id;
+				}
+			}
+		}
+	}
+	std::vector<uint8_t> buf(DsrcConstants::maxMsgSize, 0);
+	size_t payload_size = AsnJ2735Lib::encode_msgFrame(dsrcFrameIn, &buf[0], buf.size());
+	if (payload_size == 0)
+		return(false);
+	entryOut.regionalId = mapData.regionalId;
+	entryOut.intersectionId = mapData.id;
+	entryOut.name = std::string("synthetic-") + std::to_string(i);
+	entryOut.payload.assign(buf.begin(), buf.begin() + payload_size);
+	return(true);
+}
+
+/// the vehicle at ptENU of copy i, heading as given
+GeoUtils::connectedVehicle_t getVehicle(const MapData_element_t& mapTemplate, size_t i,
+	const GeoUtils::point2D_t& ptENU, double heading)
+{
+	GeoUtils::geoRefPoint_t geoRef{mapTemplate.geoRef.latitude + static_cast<int32_t>(i / gridColumns) * gridSpacing,
+		mapTemplate.geoRef.longitude + static_cast<int32_t>(i % gridColumns) * gridSpacing, mapTemplate.geoRef.elevation};
+	GeoUtils::enuCoord_t enuCoord;
+	GeoUtils::setEnuCoord(geoRef, enuCoord);
+	GeoUtils::connectedVehicle_t cv;
+	cv.reset();
+	cv.msec = 0;
+	cv.id = static_cast<uint32_t>(i);
+	GeoUtils::enu2lla(enuCoord, ptENU, cv.geoPoint);
+	cv.motionState.speed = 10.0;
+	cv.motionState.heading = heading;
+	return(cv);
+}
+
+/// a location and heading on an inbound lane of copy 0, found by probing around its reference point
+bool findInboundProbe(const LocAware& locAware, const MapData_element_t& mapTemplate,
+	GeoUtils::point2D_t& ptOut, double& headingOut)
+{
+	GeoUtils::vehicleTracking_t cvTrackingState;
+	for (int32_t d = 1000; d <= 10000; d += 100)
+	{ // in centimeters
+		for (const auto& pt : {GeoUtils::point2D_t{d, 0}, GeoUtils::point2D_t{-d, 0}, GeoUtils::point2D_t{0, d}, GeoUtils::point2D_t{0, -d}})
+		{
+			for (double heading : {0.0, 90.0, 180.0, 270.0})
+			{
+				GeoUtils::connectedVehicle_t cv = getVehicle(mapTemplate, 0, pt, heading);
+				if (locAware.locateVehicleInMap(cv, cvTrackingState)
+					&& (cvTrackingState.intsectionTrackingState.vehicleIntersectionStatus == MsgEnum::mapLocType::onInbound))
+				{
+					ptOut = pt;
+					headingOut = heading;
+					return(true);
+				}
+			}
+		}
+	}
+	return(false);
+}
+
+/// largest horizontal difference between GeoUtils::lla2enu through ECEF and through the local projection, for
+/// numPoints random points within projCheckDist of geoPoint, at its elevation. Times of both are in ns per point
+double checkLocalProj(const GeoUtils::geoPoint_t& geoPoint, size_t numPoints, std::mt19937& gen,
+	double& t_exact, double& t_local)
+{
+	GeoUtils::enuCoord_t enuCoord;
+	GeoUtils::localProj_t localProj;
+	GeoUtils::setEnuCoord(geoPoint, enuCoord);
+	GeoUtils::setLocalProj(geoPoint, localProj);
+	std::uniform_real_distribution<double> dist(-projCheckDist, projCheckDist);
+	std::vector<GeoUtils::geoPoint_t> points;
+	while (points.size() < numPoints)
+	{
+		GeoUtils::point3D_t ptENU{dist(gen), dist(gen), 0.0};
+		if (ptENU.x * ptENU.x + ptENU.y * ptENU.y > projCheckDist * projCheckDist)
+			continue;
+		GeoUtils::geoPoint_t pt;
+		GeoUtils::enu2lla(enuCoord, ptENU, pt);
+		pt.elevation = geoPoint.elevation;
+		points.push_back(pt);
+	}
+	std::vector<GeoUtils::point3D_t> exact(numPoints);
+	std::vector<GeoUtils::point3D_t> local(numPoints);
+	auto tp = std::chrono::steady_clock::now();
+	for (size_t j = 0; j < numPoints; j++)
+		GeoUtils::lla2enu(enuCoord, points[j], exact[j]);
+	t_exact = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - tp).count()) / static_cast<double>(numPoints);
+	tp = std::chrono::steady_clock::now();
+	for (size_t j = 0; j < numPoints; j++)
+		GeoUtils::lla2enu(localProj, points[j], local[j]);
+	t_local = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - tp).count()) / static_cast<double>(numPoints);
+	double maxError = 0;
+	for (size_t j = 0; j < numPoints; j++)
+	{
+		double error = std::sqrt((exact[j].x - local[j].x) * (exact[j].x - local[j].x)
+			+ (exact[j].y - local[j].y) * (exact[j].y - local[j].y));
+		maxError = std::max(maxError, error);
+	}
+	return(maxError);
+}
+
+int main(int argc, char** argv)
+{
+	int option;
+	std::string fpayload;
+	size_t numIntersections = 10000;
+	size_t numIters = 10000;
+
+	while ((option = getopt(argc, argv, "f:s:n:?")) != EOF)
+	{
+		switch(option)
+		{
+		case 'f':
+			fpayload = std::string(optarg);
+			break;
+		case 's':
+			numIntersections = static_cast<size_t>(std::strtoul(optarg, NULL, 10));
+			break;
+		case 'n':
+			numIters = static_cast<size_t>(std::strtoul(optarg, NULL, 10));
+			break;
+		case '?':
+		default:
+			do_usage(argv[0]);
+			break;
+		}
+	}
+	if (fpayload.empty() || (numIntersections == 0) || (numIters == 0))
+		do_usage(argv[0]);
+
+	/// template MAP
+	std::vector<MapStore::mapEntry_t> templates;
+	if (!MapStore::readPayloadFile(fpayload, templates) || templates.empty())
+	{
+		std::cerr << "Failed reading " << fpayload << std::endl;
+		return(-1);
+	}
+	Frame_element_t dsrcFrameOut;
+	if ((AsnJ2735Lib::decode_msgFrame(&templates[0].payload[0], templates[0].payload.size(), dsrcFrameOut) == 0)
+		|| (dsrcFrameOut.dsrcMsgId != MsgEnum::DSRCmsgID_map))
+	{
+		std::cerr << "Failed decode_msgFrame for MAP " << templates[0].name << std::endl;
+		return(-1);
+	}
+	const MapData_element_t mapTemplate = dsrcFrameOut.mapData;
+	std::mt19937 gen(20190101);
+
+	/// local projection against the ECEF path
+	GeoUtils::geoPoint_t templateRef;
+	GeoUtils::geoRefPoint2geoPoint(GeoUtils::geoRefPoint_t{mapTemplate.geoRef.latitude, mapTemplate.geoRef.longitude,
+		mapTemplate.geoRef.elevation}, templateRef);
+	bool isProjWithinBound = true;
+	std::cout << "Local projection against lla2enu through ECEF, points within " << projCheckDist << " m" << std::endl;
+	for (const auto& geoPoint : {templateRef, GeoUtils::geoPoint_t{0.0, -90.0, 0.0}, GeoUtils::geoPoint_t{-33.9, 151.2, 50.0},
+		GeoUtils::geoPoint_t{60.2, 24.9, 20.0}, GeoUtils::geoPoint_t{78.2, 15.6, 10.0}})
+	{
+		double t_exact, t_local;
+		double maxError = checkLocalProj(geoPoint, numIters, gen, t_exact, t_local);
+		if (maxError >= projErrorBound)
+			isProjWithinBound = false;
+		std::cout << std::fixed << std::setprecision(1) << "\t" << "latitude " << std::setw(5) << geoPoint.latitude
+			<< ": ECEF " << t_exact << " ns, local " << t_local << " ns, max difference "
+			<< std::setprecision(4) << maxError * 1000.0 << " mm" << std::endl;
+	}
+	if (!isProjWithinBound)
+	{
+		std::cerr << "Local projection off the ECEF path by " << projErrorBound * 1000.0 << " mm or more" << std::endl;
+		return(-1);
+	}
+
+	std::vector<MapStore::mapEntry_t> entries(numIntersections);
+	for (size_t i = 0; i < numIntersections; i++)
+	{
+		if (!encodeSyntheticMap(mapTemplate, i, entries[i]))
+		{
+			std::cerr << "Failed encode_msgFrame for intersection " << i << std::endl;
+			return(-1);
+		}
+	}
+
+	std::vector<size_t> setSizes;
+	for (size_t setSize : {static_cast<size_t>(1), static_cast<size_t>(100), static_cast<size_t>(1000)})
+	{
+		if (setSize < numIntersections)
+			setSizes.push_back(setSize);
+	}
+	setSizes.push_back(numIntersections);
+	GeoUtils::point2D_t probe{0, 0};
+	double heading = 0;
+	size_t numMismatches = 0;
+	char storeDir[] = "/tmp/benchMapEngine.XXXXXX";
+	if (mkdtemp(storeDir) == NULL)
+	{
+		std::cerr << "Failed creating a directory for the .mapstore files" << std::endl;
+		return(-1);
+	}
+	std::cout << "Template MAP " << templates[0].name << " (" << templates[0].payload.size() << " bytes), "
+		<< numIters << " lookups and vehicles per set" << std::endl;
+	for (size_t setSize : setSizes)
+	{
+		std::string fstore = std::string(storeDir) + std::string("/benchMapEngine_") + std::to_string(setSize) + std::string(".mapstore");
+		std::vector<MapStore::mapEntry_t> set(entries.begin(), entries.begin() + setSize);
+		if (!MapStore::writeMapStore(fstore, set))
+		{
+			std::cerr << "Failed writing " << fstore << std::endl;
+			unlink(fstore.c_str());
+			rmdir(storeDir);
+			return(-1);
+		}
+		auto tp = std::chrono::steady_clock::now();
+		LocAware* plocAwareLib = new LocAware(fstore);
+		double t_load = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - tp).count()) / 1000.0;
+		unlink(fstore.c_str());
+		if (!plocAwareLib->isInitiated() || (plocAwareLib->getIntersectionIds().size() != setSize))
+		{
+			std::cerr << "Failed loading " << fstore << std::endl;
+			delete plocAwareLib;
+			rmdir(storeDir);
+			return(-1);
+		}
+		if ((setSize == setSizes[0]) && !findInboundProbe(*plocAwareLib, mapTemplate, probe, heading))
+		{
+			std::cerr << "Failed finding an inbound lane of " << templates[0].name << std::endl;
+			delete plocAwareLib;
+			rmdir(storeDir);
+			return(-1);
+		}
+		std::uniform_int_distribution<size_t> pick(0, setSize - 1);
+		std::vector<size_t> targets(numIters);
+		std::vector<GeoUtils::connectedVehicle_t> vehicles(numIters);
+		for (size_t j = 0; j < numIters; j++)
+		{
+			targets[j] = pick(gen);
+			vehicles[j] = getVehicle(mapTemplate, targets[j], probe, heading);
+		}
+		/// lookup by IDs
+		std::vector<uint32_t> indexes(numIters);
+		tp = std::chrono::steady_clock::now();
+		for (size_t j = 0; j < numIters; j++)
+			indexes[j] = plocAwareLib->getIndexByIntersectionId(getRegionalId(targets[j]), getIntersectionId(targets[j]));
+		double t_lookup = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - tp).count()) / static_cast<double>(numIters);
+		/// locate vehicles not yet in the map
+		std::vector<GeoUtils::vehicleTracking_t> trackingStates(numIters);
+		size_t numLocated = 0;
+		tp = std::chrono::steady_clock::now();
+		for (size_t j = 0; j < numIters; j++)
+		{
+			if (plocAwareLib->locateVehicleInMap(vehicles[j], trackingStates[j]))
+				numLocated++;
+		}
+		double t_locate = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - tp).count()) / static_cast<double>(numIters);
+		/// the same with a workspace
+		locateWorkspace_t workspace;
+		plocAwareLib->reserveWorkspace(workspace);
+		std::vector<GeoUtils::vehicleTracking_t> wsTrackingStates(numIters);
+		tp = std::chrono::steady_clock::now();
+		for (size_t j = 0; j < numIters; j++)
+			plocAwareLib->locateVehicleInMap(vehicles[j], wsTrackingStates[j], workspace);
+		double t_locate_ws = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - tp).count()) / static_cast<double>(numIters);
+		size_t numSetMismatches = 0;
+		for (size_t j = 0; j < numIters; j++)
+		{
+			const auto& intTrackingState = trackingStates[j].intsectionTrackingState;
+			if ((indexes[j] != targets[j]) || (intTrackingState.intersectionIndex != targets[j])
+				|| (intTrackingState.vehicleIntersectionStatus != MsgEnum::mapLocType::onInbound)
+				|| !(wsTrackingStates[j].intsectionTrackingState == intTrackingState)
+				|| (wsTrackingStates[j].laneProj.nodeIndex != trackingStates[j].laneProj.nodeIndex)
+				|| (wsTrackingStates[j].laneProj.proj2segment.d != trackingStates[j].laneProj.proj2segment.d))
+				numSetMismatches++;
+		}
+		numMismatches += numSetMismatches;
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << setSize << " intersections" << std::endl;
+		std::cout << "\t" << "load:                     " << t_load << " ms" << std::endl;
+		std::cout << "\t" << "getIndexByIntersectionId: " << t_lookup << " ns" << std::endl;
+		std::cout << "\t" << "locateVehicleInMap:       " << t_locate << " ns/vehicle, " << numLocated << " located, "
+			<< numSetMismatches << " mismatches" << std::endl;
+		std::cout << "\t" << "  with a workspace:       " << t_locate_ws << " ns/vehicle" << std::endl;
+		delete plocAwareLib;
+	}
+	rmdir(storeDir);
+	return((numMismatches == 0) ? 0 : -1);
+}
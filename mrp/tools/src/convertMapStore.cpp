@@ -0,0 +1,97 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* convertMapStore.cpp
+ * convertMapStore converts encoded MAP payloads between hex .payload files and binary .mapstore files.
+ * The MAPs of all input files, of either format, are merged into the output file, whose format follows
+ * its extension. Two MAPs of the same intersection ID are rejected when writing a .mapstore file.
+ *
+ * Usage: convertMapStore -o <output .payload|.mapstore> <input .payload|.mapstore> ...
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "mapStore.h"
+
+void do_usage(const char* progname)
+{
+	std::cerr << "Usage" << progname << " <input .payload|.mapstore> ..." << std::endl;
+	std::cerr << "\t-o output file, .payload or .mapstore" << std::endl;
+	std::cerr << "\t-? print this message" << std::endl;
+	exit(EXIT_FAILURE);
+}
+
+bool hasExtension(const std::string& fname, const std::string& extension)
+{
+	return((fname.length() > extension.length())
+		&& (fname.compare(fname.length() - extension.length(), extension.length(), extension) == 0));
+}
+
+int main(int argc, char** argv)
+{
+	int option;
+	std::string fout;
+
+	while ((option = getopt(argc, argv, "o:?")) != EOF)
+	{
+		switch(option)
+		{
+		case 'o':
+			fout = std::string(optarg);
+			break;
+		case '?':
+		default:
+			do_usage(argv[0]);
+			break;
+		}
+	}
+	if (fout.empty() || (optind >= argc) || (!hasExtension(fout, ".payload") && !hasExtension(fout, ".mapstore")))
+		do_usage(argv[0]);
+
+	std::vector<MapStore::mapEntry_t> entries;
+	for (int i = optind; i < argc; i++)
+	{
+		std::string fname(argv[i]);
+		if (hasExtension(fname, ".mapstore"))
+		{
+			MapStore::MapStoreReader reader;
+			if (!reader.open(fname))
+			{
+				std::cerr << "Failed open " << fname << ", not a mapstore file" << std::endl;
+				return(-1);
+			}
+			for (size_t j = 0; j < reader.size(); j++)
+			{
+				MapStore::mapView_t view = reader.at(j);
+				MapStore::mapEntry_t entry;
+				entry.regionalId = view.regionalId;
+				entry.intersectionId = view.intersectionId;
+				entry.name.assign(view.name, view.nameLength);
+				entry.payload.assign(view.payload, view.payload + view.payloadSize);
+				entries.push_back(entry);
+			}
+		}
+		else if (!MapStore::readPayloadFile(fname, entries))
+		{
+			std::cerr << "Failed reading " << fname << std::endl;
+			return(-1);
+		}
+	}
+	bool written = hasExtension(fout, ".mapstore") ? MapStore::writeMapStore(fout, entries)
+		: MapStore::writePayloadFile(fout, entries);
+	if (!written)
+	{
+		std::cerr << "Failed writing " << fout << std::endl;
+		return(-1);
+	}
+	std::cout << "Wrote " << entries.size() << " intersection MAPs to " << fout << std::endl;
+	return(0);
+}
@@ -0,0 +1,173 @@
+//*************************************************************************************************************
+//
+// © 2016-2019 Regents of the University of California on behalf of the University of California at Berkeley
+//       with rights granted for USDOT OSADP distribution with the ECL-2.0 open source license.
+//
+//*************************************************************************************************************
+/* replayCapture.cpp
+ * replayCapture decodes the J2735 messages of pcap or pcapng captures of WSMP frames.
+ * Each capture is walked with CaptureReader, which hands out the payloads in place after the link-layer,
+ * WSMP and IEEE 1609.2 headers. The payloads are sorted by message type with peek_msgFrame and decoded
+ * with BatchDecoder one batch of a type at a time, so that the decoding time of each type is measured.
+ * For each capture, it reports the record counts, the walking time and, per message type, the number of
+ * messages decoded and the decoding throughput.
+ *
+ * Usage: replayCapture [-b <batch size>] [-t <worker threads>] <capture> ...
+ *
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "AsnJ2735Lib.h"
+#include "captureReader.h"
+
+void do_usage(const char* progname)
+{
+	std::cerr << "Usage" << progname << " <capture> ..." << std::endl;
+	std::cerr << "\t-b number of messages of a type decoded together, default 1024" << std::endl;
+	std::cerr << "\t-t number of worker threads for batch decoding, default 2" << std::endl;
+	std::cerr << "\t-? print this message" << std::endl;
+	exit(EXIT_FAILURE);
+}
+
+/// payloads of one message type waiting for decoding, and what was decoded so far
+struct typeBin_t
+{
+	std::string name;
+	uint16_t dsrcMsgId;
+	std::vector<AsnJ2735Lib::msgBuf_t> msgs;
+	size_t numMsgs;
+	size_t numDecoded;
+	uint64_t numBytes;
+	double decodeNs;
+};
+
+double elapsedNs(std::chrono::steady_clock::time_point tp)
+{
+	auto dt = std::chrono::steady_clock::now() - tp;
+	return(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count()));
+}
+
+/// decode the payloads waiting in bin
+void decodeBin(typeBin_t& bin, AsnJ2735Lib::BatchDecoder& batchDecoder, std::vector<AsnJ2735Lib::decodeResult_t>& results)
+{
+	if (bin.msgs.empty())
+		return;
+	auto tp = std::chrono::steady_clock::now();
+	bin.numDecoded += batchDecoder.decode(bin.msgs, results);
+	bin.decodeNs += elapsedNs(tp);
+	bin.numMsgs += bin.msgs.size();
+	for (const auto& msg : bin.msgs)
+		bin.numBytes += msg.size;
+	bin.msgs.clear();
+}
+
+int main(int argc, char** argv)
+{
+	int option;
+	size_t batchSize = 1024;
+	unsigned int numWorkers = 2;
+
+	while ((option = getopt(argc, argv, "b:t:?")) != EOF)
+	{
+		switch(option)
+		{
+		case 'b':
+			batchSize = static_cast<size_t>(std::strtoul(optarg, NULL, 10));
+			break;
+		case 't':
+			numWorkers = static_cast<unsigned int>(std::strtoul(optarg, NULL, 10));
+			break;
+		case '?':
+		default:
+			do_usage(argv[0]);
+			break;
+		}
+	}
+	if ((batchSize == 0) || (optind >= argc))
+		do_usage(argv[0]);
+
+	AsnJ2735Lib::BatchDecoder batchDecoder(numWorkers);
+	std::vector<AsnJ2735Lib::decodeResult_t> results;
+	AsnJ2735Lib::CaptureReader reader;
+	int ret = 0;
+	for (int i = optind; i < argc; i++)
+	{
+		std::vector<typeBin_t> bins = {{"BSM", MsgEnum::DSRCmsgID_bsm, {}, 0, 0, 0, 0.0},
+			{"SPaT", MsgEnum::DSRCmsgID_spat, {}, 0, 0, 0, 0.0}, {"MAP", MsgEnum::DSRCmsgID_map, {}, 0, 0, 0, 0.0},
+			{"SRM", MsgEnum::DSRCmsgID_srm, {}, 0, 0, 0, 0.0}, {"SSM", MsgEnum::DSRCmsgID_ssm, {}, 0, 0, 0, 0.0},
+			{"RTCM", MsgEnum::DSRCmsgID_rtcm, {}, 0, 0, 0, 0.0}, {"other", MsgEnum::DSRCmsgID_unknown, {}, 0, 0, 0, 0.0}};
+		for (auto& bin : bins)
+			bin.msgs.reserve(batchSize);
+		if (!reader.open(argv[i]))
+		{
+			std::cerr << "Failed open " << argv[i] << ", not a pcap or pcapng file" << std::endl;
+			ret = -1;
+			continue;
+		}
+		/// walk the capture, decoding a type whenever a batch of it is ready
+		auto tp = std::chrono::steady_clock::now();
+		AsnJ2735Lib::msgBuf_t msg;
+		AsnJ2735Lib::msgHeader_t header;
+		while (reader.next(msg))
+		{
+			size_t binIndex = bins.size() - 1;
+			if (AsnJ2735Lib::peek_msgFrame(msg.buf, msg.size, header))
+			{
+				for (size_t j = 0; j < bins.size() - 1; j++)
+				{
+					if (bins[j].dsrcMsgId == header.dsrcMsgId)
+					{
+						binIndex = j;
+						break;
+					}
+				}
+			}
+			typeBin_t& bin = bins[binIndex];
+			bin.msgs.push_back(msg);
+			if (bin.msgs.size() == batchSize)
+				decodeBin(bin, batchDecoder, results);
+		}
+		for (auto& bin : bins)
+			decodeBin(bin, batchDecoder, results);
+		double totalNs = elapsedNs(tp);
+		double decodeNs = 0.0;
+		size_t numMsgs = 0;
+		size_t numDecoded = 0;
+		for (const auto& bin : bins)
+		{
+			decodeNs += bin.decodeNs;
+			numMsgs += bin.numMsgs;
+			numDecoded += bin.numDecoded;
+		}
+		const AsnJ2735Lib::captureStats_t& stats = reader.getStats();
+		double fileMB = static_cast<double>(reader.getFileSize()) / 1.0e6;
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << argv[i] << " (" << ((reader.isPcapng()) ? "pcapng" : "pcap") << ", " << fileMB << " MB)" << std::endl;
+		std::cout << "\t" << stats.numRecords << " records, " << stats.numWsm << " WSMs (" << stats.numSecured
+			<< " in 1609.2 data), " << stats.numEncrypted << " encrypted, " << stats.numOther << " other, "
+			<< stats.numMalformed << " malformed" << std::endl;
+		std::cout << "\t" << numMsgs << " messages, " << numDecoded << " decoded, " << stats.payloadBytes << " payload bytes in "
+			<< totalNs / 1.0e6 << " ms (" << fileMB / (totalNs / 1.0e9) << " MB/s of capture, walking "
+			<< (totalNs - decodeNs) / 1.0e6 << " ms)" << std::endl;
+		for (const auto& bin : bins)
+		{
+			if (bin.numMsgs == 0)
+				continue;
+			double nsPerMsg = bin.decodeNs / static_cast<double>(bin.numMsgs);
+			std::cout << "\t" << std::left << std::setw(6) << bin.name << std::right << bin.numMsgs << " messages, "
+				<< bin.numDecoded << " decoded, " << nsPerMsg << " ns/msg, "
+				<< 1.0e6 / nsPerMsg << " k msgs/s, " << static_cast<double>(bin.numBytes) / (bin.decodeNs / 1.0e3)
+				<< " MB/s" << std::endl;
+		}
+		reader.close();
+	}
+	return(ret);
+}
@@ -213,6 +213,7 @@ int main(int argc, char** argv)
 	if (scenario.empty() || ((scenario.compare("BSM") != 0) && (scenario.compare("SRM") != 0)
 			&& (scenario.compare("SPaT") != 0) && (scenario.compare("SSM") != 0)))
 		do_usage(argv[0]);
+	AsnJ2735Lib::set_codecLogSink(AsnJ2735Lib::codecLogSink_stderr);
 
 	/// parameters
 	const uint16_t regionalId = 0;
@@ -13,7 +13,7 @@
  * Input: .nmap file
  * Output: encoded MAP payload in hex
  *
- * Input: .payload file
+ * Input: .payload or .mapstore file
  * Output: decoded MAP payload in nmap format
  * 
  */
@@ -73,6 +73,7 @@ int main(int argc, char** argv)
 	}
 	if (fmap.empty() || intersectionName.empty())
 		do_usage(argv[0]);
+	AsnJ2735Lib::set_codecLogSink(AsnJ2735Lib::codecLogSink_stderr);
 
 	/// instance class LocAware (Map Engine)
 	LocAware* plocAwareLib = new LocAware(fmap, singleFrame);
@@ -99,7 +100,7 @@ int main(int argc, char** argv)
 	{
 		MapData_element_t& mapData = dsrcFrameOut.mapData;
 		std::cout << "IntersectionId = " << mapData.id << ", version = " << static_cast<unsigned int>(mapData.mapVersion) << std::endl;
-		if (fmap.find(std::string(".payload")) != std::string::npos)
+		if ((fmap.find(std::string(".payload")) != std::string::npos) || (fmap.find(std::string(".mapstore")) != std::string::npos))
 		{ /// log decoded MAP into nmap file
 			std::cout << "Log namp file." << std::endl;
 			plocAwareLib->saveNmap(regionalId, intersectionId);